@@ -1,13 +1,19 @@
 #pragma once
+#include "core/async_execution.hpp"
 #include "core/connection.hpp"
 #include "core/result_set.hpp"
 #include "struct/error_info.h"
+#include "struct/pool_settings.h"
 #include "api/api.h"
+#include "api/statement.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+    /// \brief Called with the SQL text of a statement freed from the statement cache to stay within its size.
+    typedef void (*StatementEvictionCallback)(const ApiChar* sql, void* context);
+
     /// \brief Creates a connection using connection string with specified timeout.
     /// \param connection_string The connection string for establishing a connection.
     /// \param timeout Seconds before connection timeout.
@@ -24,6 +30,21 @@ extern "C" {
     /// \return Pointer to Connection object on success, nullptr on failure.
     ODBC_API Connection* connection_with_user_pass_timeout(const ApiChar* dsn, const ApiChar* user, const ApiChar* pass, long timeout, NativeError* error) noexcept;
 
+    /// \brief Takes a connection from the pool for the connection string, connecting only if none is idle.
+    /// Connection strings differing only in attribute order, keyword case or blanks share a pool.
+    /// \param connection_string The connection string for establishing a connection.
+    /// \param timeout Seconds before connection timeout.
+    /// \param settings Settings of the pool, replacing earlier ones; nullptr for the defaults.
+    /// \param error Error information structure to populate on failure, also when no connection became available in time.
+    /// \return Pointer to Connection object on success, to be given back with pool_return; nullptr on failure.
+    ODBC_API Connection* pool_borrow(const ApiChar* connection_string, long timeout, const PoolSettings* settings, NativeError* error) noexcept;
+
+    /// \brief Gives a borrowed connection back to its pool. Its open transaction is rolled back.
+    /// Statements of the connection must be closed before. A connection not from a pool is disconnected.
+    /// \param conn Pointer to the Connection object, not to be used afterwards.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void pool_return(Connection* conn, NativeError* error) noexcept;
+
     /// \brief Checks if the connection is currently active and valid.
     /// \param conn Pointer to the Connection object.
     /// \param error Error information structure to populate on failure.
@@ -76,6 +97,19 @@ extern "C" {
     /// \return true if auto-commit is enabled, false otherwise.
     ODBC_API bool get_auto_commit_transaction(Connection* conn, NativeError* error) noexcept;
 
+    /// \brief Selects whether character columns are read as SQL_C_WCHAR (UTF-16) instead of SQL_C_CHAR.
+    /// Applies to statements created afterwards. Useful with drivers whose narrow encoding is not UTF-8.
+    /// \param conn Pointer to the Connection object.
+    /// \param enabled true to read character data as SQL_C_WCHAR.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void set_wide_char_fetch(Connection* conn, bool enabled, NativeError* error) noexcept;
+
+    /// \brief Returns whether character columns are read as SQL_C_WCHAR.
+    /// \param conn Pointer to the Connection object.
+    /// \param error Error information structure to populate on failure.
+    /// \return true if wide character fetch is enabled, false otherwise.
+    ODBC_API bool get_wide_char_fetch(Connection* conn, NativeError* error) noexcept;
+
     /// \brief Executes a SQL query with specified timeout.
     /// \param conn Pointer to the Connection object.
     /// \param sql The SQL statement to execute.
@@ -84,11 +118,67 @@ extern "C" {
     /// \return Pointer to result object on success, nullptr on failure.
     ODBC_API ResultSet* execute_request(Connection* conn, const ApiChar* sql, int timeout, NativeError* error) noexcept;
 
+    /// \brief Executes a SQL query with specified timeout and fetches rows in blocks.
+    /// \param conn Pointer to the Connection object.
+    /// \param sql The SQL statement to execute.
+    /// \param timeout Seconds before query timeout.
+    /// \param fetch_size Number of rows fetched per round trip, values below 1 mean one row.
+    /// \param error Error information structure to populate on failure.
+    /// \return Pointer to result object on success, nullptr on failure.
+    ODBC_API ResultSet* execute_request_with_fetch_size(Connection* conn, const ApiChar* sql, int timeout, int fetch_size, NativeError* error) noexcept;
+
+    /// \brief Executes a SQL query on the shared event loop and reports the result to the callback.
+    /// \param conn Pointer to the Connection object, kept open until the callback was called.
+    /// \param sql The SQL statement to execute.
+    /// \param timeout Seconds before query timeout.
+    /// \param fetch_size Number of rows fetched per round trip, values below 1 mean one row.
+    /// \param callback Function called once with the result or the error, see ExecutionCallback in statement.h.
+    /// \param context Value passed to the callback.
+    /// \param error Error information structure to populate on invalid arguments; the callback is not called then.
+    ODBC_API void execute_request_with_callback(Connection* conn, const ApiChar* sql, int timeout, int fetch_size, ExecutionCallback callback, void* context, NativeError* error) noexcept;
+
+    /// \brief Starts executing a SQL query on a new statement without waiting for it to finish.
+    /// The statement belongs to the execution, see execute_async in statement.h.
+    /// \param conn Pointer to the Connection object.
+    /// \param sql The SQL statement to execute.
+    /// \param timeout Seconds before query timeout.
+    /// \param error Error information structure to populate on failure.
+    /// \return Execution handle to poll, nullptr if the execution could not be started.
+    ODBC_API AsyncExecution* execute_request_async(Connection* conn, const ApiChar* sql, int timeout, NativeError* error) noexcept;
+
     /// \brief Creates a prepared statement for parameterized queries.
     /// \param conn Pointer to the Connection object.
     /// \param error Error information structure to populate on failure.
     /// \return Pointer to Statement object on success, nullptr on failure.
-    ODBC_API nanodbc::statement* create_statement(Connection* conn, NativeError* error) noexcept;
+    ODBC_API Statement* create_statement(Connection* conn, NativeError* error) noexcept;
+
+    /// \brief Creates a statement prepared for the SQL, reusing an idle one from the statement cache.
+    /// Closing it with close_statement gives it back to the cache. Its result sets must be closed first.
+    /// \param conn Pointer to the Connection object.
+    /// \param sql The SQL statement to prepare.
+    /// \param error Error information structure to populate on failure.
+    /// \return Pointer to Statement object on success, nullptr on failure.
+    ODBC_API Statement* create_prepared_statement(Connection* conn, const ApiChar* sql, NativeError* error) noexcept;
+
+    /// \brief Keeps up to size idle prepared statements of the connection for reuse.
+    /// Used by create_prepared_statement and execute_request. 0, the default, disables the cache.
+    /// \param conn Pointer to the Connection object.
+    /// \param size Number of idle statements kept.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void set_statement_cache_size(Connection* conn, int size, NativeError* error) noexcept;
+
+    /// \brief Returns the number of idle prepared statements kept, 0 if the cache is disabled.
+    /// \param conn Pointer to the Connection object.
+    /// \param error Error information structure to populate on failure.
+    /// \return Size of the statement cache.
+    ODBC_API int get_statement_cache_size(Connection* conn, NativeError* error) noexcept;
+
+    /// \brief Sets the function called when a statement is evicted from the statement cache.
+    /// \param conn Pointer to the Connection object.
+    /// \param callback Function called with the SQL text, nullptr to remove it.
+    /// \param context Value passed to the callback.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void set_statement_eviction_callback(Connection* conn, StatementEvictionCallback callback, void* context, NativeError* error) noexcept;
 
     /// \brief Closes the connection and releases associated resources.
     /// \param conn Pointer to the Connection object.
@@ -4,18 +4,35 @@
 #include "api/api.h"
 #include "struct/nanodbc_c.h"
 #include "struct/binary_array.h"
+#include "struct/column_batch.h"
+#include "struct/row_layout.h"
+#include "struct/arrow_c_data.h"
 #include "core/chunked_binary_stream.hpp"
+#include "core/chunked_character_stream.hpp"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+    /// \brief Called on an event loop thread once a row fetched with next_with_callback arrived.
+    /// \param has_row 1 if the cursor is on the next row, 0 at the end, -1 on failure.
+    /// \param error_message Description of the failure, nullptr otherwise; valid during the call only.
+    typedef void (*FetchCallback)(void* context, int has_row, const char* error_message);
+
     /// \brief Moves to the next result set in a multiple-result operation.
     /// \param results Pointer to the result set object.
     /// \param error Error information structure to populate on failure.
     /// \return true if another result set exists, false otherwise.
     ODBC_API bool next_result(ResultSet* results, NativeError* error) noexcept;
 
+    /// \brief Moves to the next row on a worker thread and reports it to the callback.
+    /// The result set must not be used until the callback was called.
+    /// \param results Pointer to the result set object.
+    /// \param callback Function called once with the outcome.
+    /// \param context Value passed to the callback.
+    /// \param error Error information structure to populate on invalid arguments; the callback is not called then.
+    ODBC_API void next_with_callback(ResultSet* results, FetchCallback callback, void* context, NativeError* error) noexcept;
+
     /// \brief Moves to the previous result set in a multiple-result operation.
     /// \param results Pointer to the result set object.
     /// \param error Error information structure to populate on failure.
@@ -41,6 +58,52 @@ extern "C" {
     /// \return true if operation succeeded, false otherwise.
     ODBC_API bool absolute_result(ResultSet* results, int row, NativeError* error) noexcept;
 
+    /// \brief Moves the given number of rows forward, or backward if negative, from the current row.
+    /// \param results Pointer to the result set object.
+    /// \param rows Number of rows to move.
+    /// \param error Error information structure to populate on failure.
+    /// \return true if the cursor is on a row afterwards, false otherwise.
+    ODBC_API bool relative_result(ResultSet* results, int rows, NativeError* error) noexcept;
+
+    /// \brief Creates an empty column batch to be filled by fetch_batch.
+    /// \param error Error information structure to populate on failure.
+    /// \return Pointer to ColumnBatch object on success, nullptr on failure.
+    ODBC_API ColumnBatch* create_column_batch(NativeError* error) noexcept;
+
+    /// \brief Fetches up to max_rows rows into contiguous per-column buffers.
+    /// Buffers of the batch are reused and only grow between calls.
+    /// \param results Pointer to the result set object.
+    /// \param max_rows Maximum number of rows to fetch.
+    /// \param batch Batch receiving the rows, its previous contents are discarded.
+    /// \param error Error information structure to populate on failure.
+    /// \return Number of rows fetched, 0 at the end of the result set, -1 on error.
+    ODBC_API int fetch_batch(ResultSet* results, int max_rows, ColumnBatch* batch, NativeError* error) noexcept;
+
+    /// \brief Creates a row layout describing the columns of the result set, used by read_row.
+    /// \param results Pointer to the result set object.
+    /// \param error Error information structure to populate on failure.
+    /// \return Pointer to RowLayout object on success, nullptr on failure.
+    ODBC_API RowLayout* create_row_layout(ResultSet* results, NativeError* error) noexcept;
+
+    /// \brief Packs every column of the current row into buffer, see RowLayout for the format.
+    /// If the row does not fit, nothing is copied and the required size is returned; the next
+    /// call copies the same row, so it can be retried with a larger buffer before moving the cursor.
+    /// \param results Pointer to the result set object.
+    /// \param buffer Destination buffer.
+    /// \param capacity Size of buffer in bytes.
+    /// \param layout Row layout created for this result set.
+    /// \param error Error information structure to populate on failure.
+    /// \return Size of the packed row in bytes, -1 on error.
+    ODBC_API int read_row(ResultSet* results, uint8_t* buffer, int capacity, RowLayout* layout, NativeError* error) noexcept;
+
+    /// \brief Exports the remaining rows as an Arrow C stream of record batches.
+    /// The stream reads from the result set, which must stay open until the stream is released.
+    /// \param results Pointer to the result set object.
+    /// \param batch_size Maximum number of rows per record batch.
+    /// \param stream Stream structure to initialize, released by the consumer.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void export_arrow_stream(ResultSet* results, int batch_size, ArrowArrayStream* stream, NativeError* error) noexcept;
+
     /// \brief Returns the current row position in the result set.
     /// \param results Pointer to the result set object.
     /// \param error Error information structure to populate on failure.
@@ -53,6 +116,31 @@ extern "C" {
     /// \return Number of affected rows, -1 on error.
     ODBC_API int affected_rows_result(ResultSet* results, NativeError* error) noexcept;
 
+    /// \brief Starts fetching rows ahead on a background thread.
+    /// While the current block of rows is read, the next one is fetched into memory.
+    /// Afterwards the cursor is forward-only, fetch_batch and export_arrow_stream are unavailable,
+    /// and a fetch error is reported by next_result.
+    /// \param results Pointer to the result set object.
+    /// \param batch_rows Number of rows fetched ahead per block.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void enable_prefetch(ResultSet* results, int batch_rows, NativeError* error) noexcept;
+
+    /// \brief Caches rows on the client so that previous_result, first_result, last_result,
+    /// absolute_result and relative_result work over forward-only driver cursors.
+    /// Rows beyond the memory budget are kept in a memory-mapped temporary file.
+    /// \param results Pointer to the result set object.
+    /// \param memory_budget Bytes of rows kept in memory before spilling to disk.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void enable_row_cache(ResultSet* results, int64_t memory_budget, NativeError* error) noexcept;
+
+    /// \brief Allocates strings, dates, times, timestamps and byte arrays returned for the
+    /// current row from an arena owned by the result set.
+    /// They stay valid until the cursor moves and must then not be passed to std_free,
+    /// delete_date, delete_time, delete_timestamp or delete_binary_array.
+    /// \param results Pointer to the result set object.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void enable_value_arena(ResultSet* results, NativeError* error) noexcept;
+
     /// \brief Retrieves integer value from result set by column index.
     /// \param results Pointer to the result set object.
     /// \param index Zero-based column index.
@@ -95,6 +183,54 @@ extern "C" {
     /// \return Short value from specified column.
     ODBC_API short get_short_value_by_index(ResultSet* results, int index, NativeError* error) noexcept;
 
+    /// \brief Retrieves integer value and its null indicator from result set by column index in one call.
+    /// \param results Pointer to the result set object.
+    /// \param index Zero-based column index.
+    /// \param is_null Set to true if the value is NULL, may be nullptr.
+    /// \param error Error information structure to populate on failure.
+    /// \return Integer value from specified column, 0 if the value is NULL.
+    ODBC_API int get_int_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept;
+
+    /// \brief Retrieves long value and its null indicator from result set by column index in one call.
+    /// \param results Pointer to the result set object.
+    /// \param index Zero-based column index.
+    /// \param is_null Set to true if the value is NULL, may be nullptr.
+    /// \param error Error information structure to populate on failure.
+    /// \return Long value from specified column, 0 if the value is NULL.
+    ODBC_API long get_long_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept;
+
+    /// \brief Retrieves double value and its null indicator from result set by column index in one call.
+    /// \param results Pointer to the result set object.
+    /// \param index Zero-based column index.
+    /// \param is_null Set to true if the value is NULL, may be nullptr.
+    /// \param error Error information structure to populate on failure.
+    /// \return Double value from specified column, 0 if the value is NULL.
+    ODBC_API double get_double_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept;
+
+    /// \brief Retrieves boolean value and its null indicator from result set by column index in one call.
+    /// \param results Pointer to the result set object.
+    /// \param index Zero-based column index.
+    /// \param is_null Set to true if the value is NULL, may be nullptr.
+    /// \param error Error information structure to populate on failure.
+    /// \return Boolean value from specified column, false if the value is NULL.
+    ODBC_API bool get_bool_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept;
+
+    /// \brief Retrieves float value and its null indicator from result set by column index in one call.
+    /// \param results Pointer to the result set object.
+    /// \param index Zero-based column index.
+    /// \param is_null Set to true if the value is NULL, may be nullptr.
+    /// \param error Error information structure to populate on failure.
+    /// \return Float value from specified column, 0 if the value is NULL.
+    ODBC_API float get_float_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept;
+
+    /// \brief Retrieves short value and its null indicator from result set by column index in one call.
+    /// \param results Pointer to the result set object.
+    /// \param index Zero-based column index.
+    /// \param is_null Set to true if the value is NULL, may be nullptr.
+    /// \param error Error information structure to populate on failure.
+    /// \return Short value from specified column, 0 if the value is NULL.
+    ODBC_API short get_short_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept;
+
     /// \brief Retrieves string value from result set by column index.
     /// \param results Pointer to the result set object.
     /// \param index Zero-based column index.
@@ -102,6 +238,27 @@ extern "C" {
     /// \return String value from specified column.
     ODBC_API const ApiChar* get_string_value_by_index(const ResultSet* results, int index, NativeError* error) noexcept;
 
+    /// \brief Copies string value from result set by column index into a caller buffer.
+    /// If the value does not fit, nothing is copied and the required length is returned;
+    /// the value is kept until the cursor moves, so the call can be retried with a larger buffer.
+    /// The copy is NUL-terminated when capacity leaves room for the terminator.
+    /// \param results Pointer to the result set object.
+    /// \param index Zero-based column index.
+    /// \param buffer Destination buffer.
+    /// \param capacity Size of buffer in characters.
+    /// \param error Error information structure to populate on failure.
+    /// \return Length of the value in characters, -1 if the value is NULL, -2 on error.
+    ODBC_API int get_string_into_by_index(ResultSet* results, int index, ApiChar* buffer, int capacity, NativeError* error) noexcept;
+
+    /// \brief Reads a decimal value from result set by column index as an unscaled 128-bit integer and scale.
+    /// DECIMAL and NUMERIC columns are fetched as SQL_C_NUMERIC where the driver supports it, so no text is formatted or parsed.
+    /// \param results Pointer to the result set object.
+    /// \param index Zero-based column index.
+    /// \param value Structure receiving the value.
+    /// \param error Error information structure to populate on failure.
+    /// \return true if value was filled, false if the value is NULL or an empty string, or on error.
+    ODBC_API bool get_decimal_by_index(ResultSet* results, int index, CDecimal* value, NativeError* error) noexcept;
+
     /// \brief Retrieves date value from result set by column index.
     /// \param results Pointer to the result set object.
     /// \param index Zero-based column index.
@@ -146,6 +303,22 @@ extern "C" {
     /// \return Number of bytes actually read, -1 on error.
     ODBC_API int read_binary_stream(ChunkedBinaryStream* stream, uint8_t* buffer, int offset, int length, NativeError* error) noexcept;
 
+    /// \brief Retrieves character stream from result set by column index.
+    /// \param results Pointer to the result set object.
+    /// \param index Zero-based column index.
+    /// \param error Error information structure to populate on failure.
+    /// \return Character stream from specified column, nullptr if the value is NULL.
+    ODBC_API ChunkedCharacterStream* get_character_stream_by_index(ResultSet* results, int index, NativeError* error) noexcept;
+
+    /// \brief Reads UTF-16 code units from character stream into buffer.
+    /// \param stream Pointer to the character stream object.
+    /// \param buffer Destination buffer for read data.
+    /// \param offset Offset in buffer, in code units, to start writing.
+    /// \param length Maximum number of code units to read.
+    /// \param error Error information structure to populate on failure.
+    /// \return Number of code units actually read, -1 at the end of the value or on error.
+    ODBC_API int read_character_stream(ChunkedCharacterStream* stream, ApiChar* buffer, int offset, int length, NativeError* error) noexcept;
+
     /// \brief Checks if the value at specified column index was NULL.
     /// \param results Pointer to the result set object.
     /// \param index Zero-based column index.
@@ -237,6 +410,13 @@ extern "C" {
     /// \return Binary stream from specified column.
     ODBC_API ChunkedBinaryStream* get_binary_stream_by_name(ResultSet* results, const ApiChar* name, NativeError* error) noexcept;
 
+    /// \brief Retrieves character stream from result set by column name.
+    /// \param results Pointer to the result set object.
+    /// \param name Column name.
+    /// \param error Error information structure to populate on failure.
+    /// \return Character stream from specified column, nullptr if the value is NULL.
+    ODBC_API ChunkedCharacterStream* get_character_stream_by_name(ResultSet* results, const ApiChar* name, NativeError* error) noexcept;
+
     /// \brief Finds column index by column name.
     /// \param results Pointer to the result set object.
     /// \param name Column name to find.
@@ -289,10 +469,22 @@ extern "C" {
     /// \param timestamp Pointer to CTimestamp object to delete.
     ODBC_API void delete_timestamp(CTimestamp* timestamp) noexcept;
 
+    /// \brief Releases column batch resources.
+    /// \param batch Pointer to ColumnBatch object to delete.
+    ODBC_API void delete_column_batch(ColumnBatch* batch) noexcept;
+
+    /// \brief Releases row layout resources.
+    /// \param layout Pointer to RowLayout object to delete.
+    ODBC_API void delete_row_layout(RowLayout* layout) noexcept;
+
     /// \brief Closes and releases binary stream resources.
     /// \param stream Pointer to ChunkedBinaryStream object to close.
     ODBC_API void close_binary_stream(ChunkedBinaryStream* stream) noexcept;
 
+    /// \brief Closes and releases character stream resources.
+    /// \param stream Pointer to ChunkedCharacterStream object to close.
+    ODBC_API void close_character_stream(ChunkedCharacterStream* stream) noexcept;
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
\ No newline at end of file
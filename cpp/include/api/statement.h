@@ -1,5 +1,8 @@
 #pragma once
+#include <cstdint>
+#include "core/async_execution.hpp"
 #include "core/result_set.hpp"
+#include "core/statement.hpp"
 #include "struct/error_info.h"
 #include "struct/nanodbc_c.h"
 #include "struct/binary_array.h"
@@ -9,105 +12,242 @@
 extern "C" {
 #endif
 
+    /// \brief Reads the next chunk of a binary stream parameter.
+    /// \return Number of bytes written to buffer, at most length; 0 at the end of the stream, -1 on failure.
+    typedef int (*BinaryStreamReader)(void* context, uint8_t* buffer, int length);
+
+    /// \brief Reads the next chunk of a character stream parameter.
+    /// \return Number of UTF-16 code units written to buffer, at most length; 0 at the end of the stream, -1 on failure.
+    typedef int (*CharacterStreamReader)(void* context, ApiChar* buffer, int length);
+
+    /// \brief Called once an execution started with a callback finished, failed to start included.
+    /// Runs on an event loop thread, or on the calling one if the execution ends at once.
+    /// \param result Result set now owned by the callee, closed with close_result; nullptr on failure.
+    /// \param error_message Description of the failure, nullptr on success; valid during the call only.
+    typedef void (*ExecutionCallback)(void* context, ResultSet* result, const char* error_message);
+
     /// \brief Prepares a SQL statement for execution with parameters.
     /// \param stmt Pointer to the statement object.
     /// \param sql The SQL statement to prepare.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void prepare_statement(nanodbc::statement* stmt, const ApiChar* sql, NativeError* error) noexcept;
+    ODBC_API void prepare_statement(Statement* stmt, const ApiChar* sql, NativeError* error) noexcept;
 
     /// \brief Binds an integer value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Integer value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_int_value(nanodbc::statement* stmt, int index, int value, NativeError* error) noexcept;
+    ODBC_API void set_int_value(Statement* stmt, int index, int value, NativeError* error) noexcept;
 
     /// \brief Binds a long value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Long value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_long_value(nanodbc::statement* stmt, int index, long value, NativeError* error) noexcept;
+    ODBC_API void set_long_value(Statement* stmt, int index, long long value, NativeError* error) noexcept;
 
     /// \brief Binds a double value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Double value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_double_value(nanodbc::statement* stmt, int index, double value, NativeError* error) noexcept;
+    ODBC_API void set_double_value(Statement* stmt, int index, double value, NativeError* error) noexcept;
 
     /// \brief Binds a boolean value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Boolean value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_bool_value(nanodbc::statement* stmt, int index, bool value, NativeError* error) noexcept;
+    ODBC_API void set_bool_value(Statement* stmt, int index, bool value, NativeError* error) noexcept;
 
     /// \brief Binds a float value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Float value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_float_value(nanodbc::statement* stmt, int index, float value, NativeError* error) noexcept;
+    ODBC_API void set_float_value(Statement* stmt, int index, float value, NativeError* error) noexcept;
 
     /// \brief Binds a short value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Short value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_short_value(nanodbc::statement* stmt, int index, short value, NativeError* error) noexcept;
+    ODBC_API void set_short_value(Statement* stmt, int index, short value, NativeError* error) noexcept;
 
     /// \brief Binds a string value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value String value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_string_value(nanodbc::statement* stmt, int index, const ApiChar* value, NativeError* error) noexcept;
+    ODBC_API void set_string_value(Statement* stmt, int index, const ApiChar* value, NativeError* error) noexcept;
 
     /// \brief Binds a date value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Date value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_date_value(nanodbc::statement* stmt, int index, CDate* value, NativeError* error) noexcept;
+    ODBC_API void set_date_value(Statement* stmt, int index, CDate* value, NativeError* error) noexcept;
 
     /// \brief Binds a time value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Time value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_time_value(nanodbc::statement* stmt, int index, CTime* value, NativeError* error) noexcept;
+    ODBC_API void set_time_value(Statement* stmt, int index, CTime* value, NativeError* error) noexcept;
 
     /// \brief Binds a timestamp value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Timestamp value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_timestamp_value(nanodbc::statement* stmt, int index, CTimestamp* value, NativeError* error) noexcept;
+    ODBC_API void set_timestamp_value(Statement* stmt, int index, CTimestamp* value, NativeError* error) noexcept;
 
     /// \brief Binds a binary array value to a parameter in the prepared statement.
     /// \param stmt Pointer to the statement object.
     /// \param index Zero-based parameter index.
     /// \param value Binary array value to bind.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void set_binary_array_value(nanodbc::statement* stmt, int index, BinaryArray* value, NativeError* error) noexcept;
+    ODBC_API void set_binary_array_value(Statement* stmt, int index, BinaryArray* value, NativeError* error) noexcept;
+
+    /// \brief Binds a binary stream to a parameter, read in chunks while the statement executes.
+    /// Only one chunk is held in native memory at a time. The stream is read by the next
+    /// execution only; later executions send NULL until a new stream is set.
+    /// \param stmt Pointer to the statement object.
+    /// \param index Zero-based parameter index.
+    /// \param reader Function called for each chunk, nullptr binds NULL.
+    /// \param context Value passed to the reader.
+    /// \param length Length of the stream in bytes, -1 if unknown.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void set_binary_stream_value(Statement* stmt, int index, BinaryStreamReader reader, void* context, long long length, NativeError* error) noexcept;
+
+    /// \brief Binds a character stream of UTF-16 code units to a parameter.
+    /// \param length Length of the stream in code units, -1 if unknown.
+    /// \see set_binary_stream_value
+    ODBC_API void set_character_stream_value(Statement* stmt, int index, CharacterStreamReader reader, void* context, long long length, NativeError* error) noexcept;
+
+    /// \brief Binds a column of 32-bit integers to a parameter for execute_batch.
+    /// The array is bound in place and must stay valid until execute_batch or clear_batch.
+    /// \param stmt Pointer to the statement object.
+    /// \param index Zero-based parameter index.
+    /// \param values rows values.
+    /// \param nulls Null bitmap, bit (row % 8) of byte (row / 8) is set for NULL. May be nullptr.
+    /// \param rows Number of rows, the same for every column.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void set_int_column(Statement* stmt, int index, const int32_t* values, const uint8_t* nulls, int rows, NativeError* error) noexcept;
+
+    /// \brief Binds a column of 64-bit integers to a parameter for execute_batch.
+    /// \see set_int_column
+    ODBC_API void set_long_column(Statement* stmt, int index, const int64_t* values, const uint8_t* nulls, int rows, NativeError* error) noexcept;
+
+    /// \brief Binds a column of doubles to a parameter for execute_batch.
+    /// \see set_int_column
+    ODBC_API void set_double_column(Statement* stmt, int index, const double* values, const uint8_t* nulls, int rows, NativeError* error) noexcept;
+
+    /// \brief Binds a column of strings to a parameter for execute_batch.
+    /// The strings are copied into a parameter array, the buffers may be released after the call.
+    /// \param stmt Pointer to the statement object.
+    /// \param index Zero-based parameter index.
+    /// \param data UTF-16 code units of all strings, one after another.
+    /// \param length Number of code units at data; the offsets must not go past it.
+    /// \param offsets rows + 1 non-decreasing offsets into data in code units; string i ends where string i + 1 starts.
+    /// \param nulls Null bitmap, bit (row % 8) of byte (row / 8) is set for NULL. May be nullptr.
+    /// \param rows Number of rows, the same for every column.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void set_string_column(Statement* stmt, int index, const ApiChar* data, int length, const int32_t* offsets, const uint8_t* nulls, int rows, NativeError* error) noexcept;
 
     /// \brief Executes the prepared statement with bound parameters.
     /// \param stmt Pointer to the statement object.
     /// \param timeout Seconds before execution timeout.
     /// \param error Error information structure to populate on failure.
     /// \return Pointer to result set object on success, nullptr on failure.
-    ODBC_API ResultSet* execute(nanodbc::statement* stmt, int timeout, NativeError* error) noexcept;
+    ODBC_API ResultSet* execute(Statement* stmt, int timeout, NativeError* error) noexcept;
+
+    /// \brief Executes the prepared statement and fetches rows in blocks.
+    /// \param stmt Pointer to the statement object.
+    /// \param timeout Seconds before execution timeout.
+    /// \param fetch_size Number of rows fetched per round trip, values below 1 mean one row.
+    /// \param error Error information structure to populate on failure.
+    /// \return Pointer to result set object on success, nullptr on failure.
+    ODBC_API ResultSet* execute_with_fetch_size(Statement* stmt, int timeout, int fetch_size, NativeError* error) noexcept;
+
+    /// \brief Starts executing the prepared statement without waiting for it to finish.
+    /// The statement must not be used or closed until the execution is closed.
+    /// \param stmt Pointer to the statement object.
+    /// \param timeout Seconds before execution timeout.
+    /// \param error Error information structure to populate on failure.
+    /// \return Execution handle to poll, nullptr if the execution could not be started.
+    ODBC_API AsyncExecution* execute_async(Statement* stmt, int timeout, NativeError* error) noexcept;
+
+    /// \brief Advances the execution without blocking.
+    /// \param execution Execution handle.
+    /// \param error Error information structure to populate on failure.
+    /// \return 1 once the execution finished, 0 while it is running, -1 on failure.
+    ODBC_API int poll_execution(AsyncExecution* execution, NativeError* error) noexcept;
+
+    /// \brief Waits for the execution to finish.
+    /// \param execution Execution handle.
+    /// \param timeout_millis Milliseconds to wait at most.
+    /// \param error Error information structure to populate on failure.
+    /// \return 1 once the execution finished, 0 if it is still running, -1 on failure.
+    ODBC_API int wait_for_execution(AsyncExecution* execution, int timeout_millis, NativeError* error) noexcept;
+
+    /// \brief Asks the driver to stop the execution. May be called from any thread.
+    /// \param execution Execution handle.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void cancel_execution(AsyncExecution* execution, NativeError* error) noexcept;
+
+    /// \brief Opens the results of a finished execution. Call once.
+    /// \param execution Execution handle.
+    /// \param fetch_size Number of rows fetched per round trip, values below 1 mean one row.
+    /// \param error Error information structure populated with the error of a failed or cancelled execution.
+    /// \return Pointer to result set object on success, nullptr on failure.
+    ODBC_API ResultSet* execution_result(AsyncExecution* execution, int fetch_size, NativeError* error) noexcept;
+
+    /// \brief Releases the execution handle, cancelling the execution if it is still running.
+    /// \param execution Execution handle.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void close_execution(AsyncExecution* execution, NativeError* error) noexcept;
+
+    /// \brief Executes the prepared statement on the shared event loop and reports the result to the callback.
+    /// The statement must not be used until the callback was called.
+    /// \param stmt Pointer to the statement object.
+    /// \param timeout Seconds before execution timeout.
+    /// \param fetch_size Number of rows fetched per round trip, values below 1 mean one row.
+    /// \param callback Function called once with the result or the error.
+    /// \param context Value passed to the callback.
+    /// \param error Error information structure to populate on invalid arguments; the callback is not called then.
+    ODBC_API void execute_with_callback(Statement* stmt, int timeout, int fetch_size, ExecutionCallback callback, void* context, NativeError* error) noexcept;
+
+    /// \brief Adds the parameter values set so far as a row of the batch.
+    /// Values stay set for the next row; parameters never set are NULL.
+    /// \param stmt Pointer to the statement object.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void add_batch(Statement* stmt, NativeError* error) noexcept;
+
+    /// \brief Executes all rows of the batch, or of the columns set, in one round trip using a parameter array.
+    /// The batch and the parameter values are cleared afterwards, also on failure.
+    /// \param stmt Pointer to the statement object.
+    /// \param timeout Seconds before execution timeout.
+    /// \param row_counts Receives the row count of each row: -2 if unknown, -3 if the row failed. May be nullptr.
+    /// \param capacity Number of entries row_counts can hold.
+    /// \param error Error information structure to populate on failure.
+    /// \return Number of rows in the batch, -1 if it could not be executed at all.
+    ODBC_API int execute_batch(Statement* stmt, int timeout, int* row_counts, int capacity, NativeError* error) noexcept;
+
+    /// \brief Removes all rows added to the batch and the columns set.
+    /// \param stmt Pointer to the statement object.
+    /// \param error Error information structure to populate on failure.
+    ODBC_API void clear_batch(Statement* stmt, NativeError* error) noexcept;
 
     /// \brief Cancels the current statement execution.
     /// \param stmt Pointer to the statement object.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void cancel_statement(nanodbc::statement* stmt, NativeError* error) noexcept;
+    ODBC_API void cancel_statement(Statement* stmt, NativeError* error) noexcept;
 
     /// \brief Closes and releases statement resources.
     /// \param stmt Pointer to the statement object.
     /// \param error Error information structure to populate on failure.
-    ODBC_API void close_statement(nanodbc::statement* stmt, NativeError* error) noexcept;
+    ODBC_API void close_statement(Statement* stmt, NativeError* error) noexcept;
 
 #ifdef __cplusplus
 } // extern "C"
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "core/result_set.hpp"
+#include "struct/arrow_c_data.h"
+
+/// \brief Producer side of an ArrowArrayStream reading record batches from a ResultSet.
+///
+/// Every record batch is a struct array with one child per column. Fixed-width and
+/// binary buffers are handed over from the fetched ColumnBatch without copying, text
+/// is transcoded from UTF-16 to UTF-8. The result set must outlive the stream.
+class ArrowStream {
+    ResultSet* rs_;
+    int batch_size_;
+    std::vector<int32_t> types_;
+    std::vector<std::string> names_;
+    std::string last_error_;
+
+public:
+    ArrowStream(ResultSet* rs, int batch_size);
+
+    /// \brief Initializes out as a stream of record batches of up to batch_size rows.
+    /// \param rs Result set positioned before the first row to export.
+    /// \param batch_size Maximum number of rows per record batch.
+    /// \param out Released stream structure to initialize.
+    static void export_stream(ResultSet* rs, int batch_size, ArrowArrayStream* out);
+
+private:
+    void get_schema(ArrowSchema* out) const;
+
+    void get_next(ArrowArray* out) const;
+
+    static int get_schema_callback(ArrowArrayStream* stream, ArrowSchema* out);
+
+    static int get_next_callback(ArrowArrayStream* stream, ArrowArray* out);
+
+    static const char* get_last_error_callback(ArrowArrayStream* stream);
+
+    static void release_callback(ArrowArrayStream* stream);
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <nanodbc/nanodbc.h>
+#include "core/connection.hpp"
+#include "core/statement.hpp"
+
+/// \brief Execution of a statement that goes on while the caller does something else.
+///
+/// Drivers executing statements asynchronously (SQL_AM_STATEMENT) are driven by polling:
+/// the statement runs with SQL_ATTR_ASYNC_ENABLE and every poll calls SQLExecute again
+/// until it stops returning SQL_STILL_EXECUTING, so no thread waits for the query.
+/// Other drivers, and statements with stream parameters, run on a small shared pool of
+/// worker threads instead. Either way the statement must not be used until the
+/// execution finished; polling is switched off again then, so results are read as usual.
+class AsyncExecution {
+public:
+    enum class Status : uint8_t {
+        Running,
+        Succeeded,
+        Failed,
+        Cancelled
+    };
+
+    /// \brief Starts executing the prepared statement with its current parameter values.
+    /// \param timeout Query timeout in seconds.
+    /// \throws database_error if the execution cannot be started.
+    static std::unique_ptr<AsyncExecution> start(Statement& statement, long timeout);
+
+    /// \brief Prepares the SQL on a new statement of the connection and starts executing it.
+    ///
+    /// The statement belongs to the execution. Preparing is not asynchronous; most drivers
+    /// defer the work to the execution.
+    /// \throws database_error if the SQL cannot be prepared.
+    static std::unique_ptr<AsyncExecution> start(Connection& connection, const nanodbc::string& sql, long timeout);
+
+    AsyncExecution(const AsyncExecution&) = delete;
+    AsyncExecution& operator=(const AsyncExecution&) = delete;
+
+    /// \brief Cancels an execution still running and waits for it to stop.
+    ~AsyncExecution();
+
+    /// \brief Advances the execution without blocking.
+    ///
+    /// poll and wait_for are called by one thread at a time.
+    /// \return true once the execution finished.
+    bool poll();
+
+    /// \brief Waits up to timeout for the execution to finish.
+    /// \return true once the execution finished.
+    bool wait_for(std::chrono::milliseconds timeout);
+
+    /// \brief Asks the driver to stop the execution, from any thread.
+    ///
+    /// An execution that completes anyway still succeeds; poll or wait for the outcome.
+    void cancel();
+
+    /// \brief Calls the callback once the execution finished, at once if it already has.
+    ///
+    /// The callback runs on the thread finishing the execution, a worker or the one polling
+    /// it, and must not destroy the execution. It replaces a callback set before.
+    void when_finished(std::function<void()> callback);
+
+    Status status() const;
+
+    /// \brief Returns true if the driver executes the statement asynchronously itself.
+    bool polling() const {
+        return polling_;
+    }
+
+    /// \brief Returns the statement holding the results of a successful execution.
+    /// \throws logic_error if the execution is still running.
+    /// \throws runtime_error if it was cancelled; its own error if it failed.
+    Statement& statement();
+
+private:
+    struct Shared;
+
+    AsyncExecution(Statement& statement, std::unique_ptr<Statement> owned, long timeout);
+
+    void begin();
+
+    /// Calls SQLExecute again, returns true once it no longer returns SQL_STILL_EXECUTING.
+    bool advance();
+
+    std::unique_ptr<Statement> owned_;
+    Statement& statement_;
+    long timeout_;
+    bool polling_ = false;
+    std::shared_ptr<Shared> shared_;
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <nanodbc/nanodbc.h>
+#include "core/async_execution.hpp"
+#include "core/event_loop.hpp"
+#include "core/result_set.hpp"
+
+/// \brief Awaitable execution of a statement; co_await yields its ResultSet.
+///
+/// The execution starts when awaited, as an AsyncExecution. The coroutine is resumed on a
+/// thread of the event loop: executions the driver runs asynchronously are polled by the
+/// loop, the others wake it from their worker thread when done.
+/// \code
+/// ResultSet rs = co_await conn.execute_async(NANODBC_TEXT("SELECT id FROM t"));
+/// while (co_await rs.fetch_async()) { ... }
+/// \endcode
+class ExecuteAwaitable {
+public:
+    /// \brief Executes the SQL on a statement of its own.
+    ExecuteAwaitable(Connection& connection, nanodbc::string sql, long timeout, long fetch_size, EventLoop& loop);
+
+    /// \brief Executes the prepared statement with its current parameter values.
+    ExecuteAwaitable(Statement& statement, long timeout, long fetch_size, EventLoop& loop);
+
+    ExecuteAwaitable(ExecuteAwaitable&&) noexcept = default;
+
+    /// \brief Starts the execution.
+    /// \return true if it finished at once.
+    /// \throws database_error if it cannot be started.
+    bool await_ready();
+
+    void await_suspend(std::coroutine_handle<> handle);
+
+    /// \brief Opens the results.
+    /// \throws the execution's error if it failed, runtime_error if it was cancelled.
+    ResultSet await_resume();
+
+private:
+    Connection* connection_;
+    Statement* statement_;
+    nanodbc::string sql_;
+    long timeout_;
+    long fetch_size_;
+    EventLoop* loop_;
+    std::unique_ptr<AsyncExecution> execution_;
+};
+
+/// \brief Awaitable move to the next row of a ResultSet; co_await yields false at the end.
+///
+/// ODBC drivers do not fetch asynchronously through the cursor nanodbc uses, so the fetch
+/// runs on a worker thread and the coroutine is resumed on a thread of the event loop.
+class FetchAwaitable {
+public:
+    FetchAwaitable(ResultSet& result, EventLoop& loop);
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle);
+
+    /// \throws database_error if the fetch failed.
+    bool await_resume();
+
+private:
+    ResultSet* result_;
+    EventLoop* loop_;
+    bool row_ = false;
+    std::exception_ptr error_;
+};
+
+/// \brief Coroutine type of work started and left to finish on its own, such as C callbacks.
+///
+/// The coroutine runs at once up to its first suspension and frees itself when it returns.
+/// It must not let exceptions escape.
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() noexcept {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() noexcept {
+        }
+
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+    };
+};
+
+/// \brief Awaits the execution in a detached coroutine and hands its outcome to the callback.
+///
+/// The callback receives the opened results, which it then owns, or nullptr and the error
+/// message, valid during the call only. It runs on a thread of the event loop, or on the
+/// calling one if the execution ends before it would suspend.
+DetachedTask complete_execution(ExecuteAwaitable awaitable, std::function<void(ResultSet* result, const char* error_message)> callback);
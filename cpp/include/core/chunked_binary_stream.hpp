@@ -1,20 +1,37 @@
 #pragma once
-#include <nanodbc/nanodbc.h>
+#include "core/result_set.hpp"
 
+/// \brief Reads a binary column of the current row piece by piece.
+///
+/// Unbound columns are read with SQLGetData. Requests of at least MIN_CHUNK_SIZE bytes
+/// are fetched straight into the caller's buffer; smaller ones go through an internal
+/// chunk that doubles up to MAX_CHUNK_SIZE while the value keeps going, or is sized to
+/// the remaining length when the driver reports it. Bound and buffered values are
+/// already in memory and are copied out of a single read.
 class ChunkedBinaryStream {
-    static constexpr size_t DEFAULT_CHUNK_SIZE = 8192; // 8KB
+    static constexpr size_t MIN_CHUNK_SIZE = 8192;             // 8KB
+    static constexpr size_t MAX_CHUNK_SIZE = 4 * 1024 * 1024;  // 4MB
 
-    nanodbc::result* rs_;
+    ResultSet* rs_;
     int column_index_;
-    size_t position_;
-    bool eof_;
     std::vector<uint8_t> buffer_;
+    size_t buffer_length_;
+    size_t position_;
+    size_t chunk_size_;
+    bool exhausted_;
 
 public:
-    explicit ChunkedBinaryStream(nanodbc::result* rs, int column_index);
+    explicit ChunkedBinaryStream(ResultSet* rs, int column_index);
 
+    /// \brief Copies up to length bytes to output_buffer + offset.
+    /// \return Number of bytes read, -1 at the end of the value.
+    /// \throws database_error
     int read(uint8_t* output_buffer, size_t offset, size_t length);
 
 private:
-    bool read_next_chunk();
-};
\ No newline at end of file
+    bool reads_in_place() const;
+
+    void refill();
+
+    size_t fetch(uint8_t* target, size_t capacity);
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include "core/result_set.hpp"
+
+/// \brief Reads a character column of the current row as UTF-16, piece by piece.
+///
+/// Unbound columns are read with SQLGetData in chunks that grow like those of
+/// ChunkedBinaryStream. With wide character fetch the driver returns UTF-16, and large
+/// requests are fetched straight into the caller's buffer. Otherwise the chunks are
+/// UTF-8 and transcoded one at a time; a multibyte sequence cut at the end of a chunk
+/// is carried over to the next. Binary columns are decoded as UTF-8 as well. On Windows
+/// the narrow encoding is the ANSI code page, so SQL_C_WCHAR is always used there.
+/// Bound and buffered values are already in memory and are copied out of a single read.
+class ChunkedCharacterStream {
+    static constexpr size_t MIN_CHUNK_SIZE = 8192;             // 8KB
+    static constexpr size_t MAX_CHUNK_SIZE = 4 * 1024 * 1024;  // 4MB
+
+    ResultSet* rs_;
+    int column_index_;
+    short narrow_type_;
+    bool wide_;
+    std::vector<char> raw_;
+    size_t carried_;
+    std::vector<ApiChar> decoded_;
+    size_t decoded_length_;
+    size_t position_;
+    size_t chunk_size_;
+    bool exhausted_;
+    bool null_;
+
+public:
+    /// \brief Opens the stream and reads the first chunk, which tells whether the value is NULL.
+    /// \throws database_error
+    ChunkedCharacterStream(ResultSet* rs, int column_index);
+
+    /// \brief Returns true if the value is NULL.
+    bool is_null() const {
+        return null_;
+    }
+
+    /// \brief Copies up to length UTF-16 code units to output_buffer + offset.
+    /// \return Number of code units read, -1 at the end of the value.
+    /// \throws database_error
+    int read(ApiChar* output_buffer, size_t offset, size_t length);
+
+private:
+    bool reads_in_place() const;
+
+    void refill();
+
+    size_t fetch(void* target, size_t capacity, short c_type, size_t terminator);
+};
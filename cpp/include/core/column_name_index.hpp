@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include <nanodbc/nanodbc.h>
+
+/// \brief Open-addressing hash index from column name to column position.
+///
+/// Names are matched case-insensitively, as JDBC requires for column labels.
+/// When several columns share a name the leftmost one is found, an alias
+/// always replaces the entry it collides with.
+class ColumnNameIndex {
+    struct Entry {
+        unsigned long hash = 0;
+        short column = -1;
+        nanodbc::string name;
+    };
+
+    std::vector<Entry> entries_;
+    size_t size_ = 0;
+
+public:
+    /// \brief Builds the index over the columns of the result.
+    void build(const nanodbc::result& result);
+
+    /// \brief Adds a name, keeping an existing entry for the same name unless replace is set.
+    void insert(nanodbc::string const& name, short column, bool replace);
+
+    /// \brief Returns the column position of name, -1 if there is none.
+    short find(nanodbc::string const& name) const;
+
+private:
+    static nanodbc::string fold_case(nanodbc::string const& name);
+
+    void grow();
+};
@@ -1,10 +1,34 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <nanodbc/nanodbc.h>
 #include "core/isolation_level.hpp"
+#include "core/statement_cache.hpp"
+
+class ConnectionPool;
+class EventLoop;
+class ExecuteAwaitable;
+class Statement;
 
 class Connection : public nanodbc::connection {
     std::unique_ptr<nanodbc::transaction> transaction_;
+    bool wide_char_fetch_ = false;
+    std::shared_ptr<StatementCache> statement_cache_;
+    StatementCache::EvictionCallback statement_eviction_callback_;
+    std::chrono::steady_clock::time_point created_at_ = std::chrono::steady_clock::now();
+    std::weak_ptr<ConnectionPool> pool_;
+    std::shared_ptr<void> pool_place_; // frees the connection's place in the pool when it goes
+
+    /// Session settings found when the connection joined its pool, empty if the driver did not report them.
+    struct SessionDefaults {
+        std::optional<uint32_t> isolation;
+        std::optional<uint32_t> access_mode;
+        std::optional<nanodbc::string> catalog;
+    };
+    SessionDefaults session_defaults_;
 
 public:
     using connection::connection; // Inherit base constructors
@@ -43,5 +67,73 @@ public:
     /// \return true if auto-commit is enabled, false if inside a transaction
     bool get_auto_commit() const;
 
+    /// \brief Selects how character columns are read by result sets of this connection.
+    /// With wide fetch enabled, unbound character columns are read as SQL_C_WCHAR straight
+    /// into UTF-16 strings; otherwise they are read as SQL_C_CHAR and converted from the
+    /// driver's narrow encoding. Affects statements created afterwards.
+    /// \param enabled true to read character data as SQL_C_WCHAR.
+    void set_wide_char_fetch(bool enabled);
+
+    /// \brief Returns true if character columns are read as SQL_C_WCHAR.
+    bool get_wide_char_fetch() const;
+
+    /// \brief Keeps up to capacity idle prepared statements for reuse.
+    /// A capacity of 0 disables the cache and frees the idle statements; statements
+    /// in use are then freed when closed.
+    /// \param capacity Number of idle statements kept.
+    void set_statement_cache_size(size_t capacity);
+
+    /// \brief Returns the number of idle statements kept, 0 if the cache is disabled.
+    size_t get_statement_cache_size() const;
+
+    /// \brief Sets the function called for statements evicted from the cache, also if enabled later.
+    void set_statement_eviction_callback(StatementCache::EvictionCallback callback);
+
+    /// \brief Returns the statement cache, nullptr while it is disabled.
+    std::shared_ptr<StatementCache> statement_cache() const {
+        return statement_cache_;
+    }
+
+    /// \brief Returns a statement prepared for the SQL, reusing an idle one from the cache.
+    /// Free it with StatementCache::release, which gives it back to the cache.
+    /// \throws database_error
+    Statement* prepare_statement(const nanodbc::string& sql);
+
+    /// \brief Returns an awaitable executing the SQL on a statement of its own.
+    ///
+    /// co_await yields the ResultSet on a thread of the shared event loop; include
+    /// core/async_operations.hpp to await it.
+    /// \param timeout Query timeout in seconds.
+    /// \param fetch_size Number of rows fetched per round trip.
+    ExecuteAwaitable execute_async(const nanodbc::string& sql, long timeout = 0, long fetch_size = 1);
+
+    /// \brief Returns an awaitable executing the SQL, resumed on a thread of the given loop.
+    ExecuteAwaitable execute_async(const nanodbc::string& sql, long timeout, long fetch_size, EventLoop& loop);
+
+    /// \brief Returns when the connection was opened.
+    std::chrono::steady_clock::time_point created_at() const {
+        return created_at_;
+    }
+
+    /// \brief Returns the pool the connection is given back to, nullptr if none.
+    std::shared_ptr<ConnectionPool> pool() const {
+        return pool_.lock();
+    }
+
+    /// \brief Makes the connection go back to the pool when released.
+    ///
+    /// Records the isolation level, access mode and catalog, which reset_session restores.
+    /// \param place Released together with the connection, so the pool may open another one.
+    void attach_pool(std::weak_ptr<ConnectionPool> pool, std::shared_ptr<void> place);
+
+    /// \brief Rolls back the open transaction and restores the default fetch mode, as on a new connection.
+    ///
+    /// The session settings recorded by attach_pool are set back where they changed.
+    /// \throws runtime_error if a setting cannot be restored; the connection should then be closed.
+    void reset_session();
+
+    /// \brief Frees the cached statements and disconnects.
+    void disconnect();
+
     ~Connection() noexcept = default;
 };
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <nanodbc/nanodbc.h>
+#include "core/connection.hpp"
+
+/// \brief Open connections to one data source kept for reuse, so borrowing skips SQLDriverConnect.
+///
+/// Pools are shared per normalized connection string, see get. Borrowing takes the most
+/// recently returned idle connection, or opens a new one while fewer than max_size are
+/// open, or else waits up to borrow_timeout for one to come back. Idle connections are
+/// checked with SQL_ATTR_CONNECTION_DEAD before they are handed out, which the driver
+/// answers without a round trip. A housekeeping thread closes connections idle longer than
+/// idle_timeout, down to min_size, and any past max_lifetime, and opens connections up to
+/// min_size.
+///
+/// Giving a connection back rolls back its open transaction, restores the default fetch
+/// mode and sets the isolation level, access mode and catalog back to those it was opened
+/// with; a connection where that fails is closed. Its statement cache is kept. Settings
+/// changed through SQL, such as SET statements, stay as the last borrower left them.
+/// Statements must be closed before giving it back.
+class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
+public:
+    struct Settings {
+        /// Connections kept open even when idle.
+        size_t min_size = 0;
+        /// Connections open at most, idle or borrowed.
+        size_t max_size = 10;
+        /// Time borrow waits for a connection when max_size are borrowed.
+        std::chrono::milliseconds borrow_timeout{30000};
+        /// Time after which an idle connection is closed, 0 for never.
+        std::chrono::milliseconds idle_timeout{600000};
+        /// Age after which a connection is closed once idle, 0 for never.
+        std::chrono::milliseconds max_lifetime{1800000};
+        /// Seconds before connecting times out.
+        long login_timeout = 0;
+    };
+
+    /// \brief Returns the pool for the connection string, creating it on first use.
+    ///
+    /// Connection strings differing only in the order of their attributes, the case of
+    /// their keywords or blanks around them share a pool. The settings replace those of
+    /// an existing pool.
+    /// \throws invalid_argument if the settings are inconsistent.
+    static std::shared_ptr<ConnectionPool> get(const nanodbc::string& connection_string, const Settings& settings);
+
+    /// \brief Returns the attributes of the connection string sorted by keyword, keywords in lower case.
+    static nanodbc::string normalize(const nanodbc::string& connection_string);
+
+    /// \brief Gives the connection back to its pool, or disconnects it if it has none.
+    static void release(Connection* connection);
+
+    /// \throws invalid_argument if the settings are inconsistent.
+    ConnectionPool(nanodbc::string connection_string, const Settings& settings);
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    /// \brief Closes the idle connections. Borrowed ones are closed when released.
+    ~ConnectionPool();
+
+    /// \brief Takes an idle connection or opens a new one.
+    /// \throws runtime_error if none became available within the borrow timeout.
+    /// \throws database_error if connecting fails.
+    std::unique_ptr<Connection> borrow();
+
+    /// \brief Gives a connection borrowed from this pool back for reuse.
+    ///
+    /// Connections that are broken or past their lifetime are closed instead.
+    void give_back(std::unique_ptr<Connection> connection);
+
+    /// \brief Closes expired idle connections and opens connections up to the minimum size.
+    ///
+    /// Called by the housekeeping thread; connecting failures are left to the next call.
+    void maintain();
+
+    /// \throws invalid_argument if the settings are inconsistent.
+    void configure(const Settings& settings);
+
+    Settings settings() const;
+
+    /// \brief Number of open connections, idle or borrowed.
+    size_t size() const;
+
+    /// \brief Number of idle connections.
+    size_t idle() const;
+
+    /// \brief Closes all idle connections.
+    void clear();
+
+private:
+    struct Idle {
+        std::unique_ptr<Connection> connection;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    /// Opens a connection for a place already counted in size_, which it frees on failure.
+    std::unique_ptr<Connection> connect();
+
+    /// Frees a place counted in size_.
+    void vacate();
+
+    static bool expired(const Connection& connection, std::chrono::steady_clock::time_point now,
+                        std::chrono::milliseconds max_lifetime);
+
+    static void validate(const Settings& settings);
+
+    /// Disconnects without throwing, the connection frees its place when deleted.
+    static void discard(std::unique_ptr<Connection> connection) noexcept;
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    const nanodbc::string connection_string_;
+    Settings settings_;
+    std::deque<Idle> idle_; // most recently returned last
+    size_t size_ = 0;       // open connections and ones being opened
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief A few threads that drive many asynchronous operations at once.
+///
+/// Each watched operation is polled by one loop thread until it reports completion, then
+/// its completion runs on that thread. Operations are spread over the threads in turn.
+/// A thread with nothing to poll sleeps until work arrives; one whose operations made no
+/// progress backs off from 1 ms up to 50 ms, and starts over as soon as work is posted.
+/// Completions must not block, they hold up every operation of their thread.
+class EventLoop {
+public:
+    /// \brief Returns true once the operation finished. Must not block.
+    using PollFunction = std::function<bool()>;
+    using Task = std::function<void()>;
+
+    /// \param threads Number of loop threads, at least one.
+    explicit EventLoop(unsigned threads = 1);
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /// \brief Stops the threads. Operations still watched are dropped without completion.
+    ~EventLoop();
+
+    /// \brief Polls the operation on a loop thread until it finished, then runs the completion there.
+    void watch(PollFunction poll, Task completion);
+
+    /// \brief Runs the task on a loop thread as soon as possible. Safe from any thread.
+    void post(Task task);
+
+    /// \brief Number of operations watched or posted and not yet completed.
+    size_t pending() const;
+
+    /// \brief Returns the loop shared by the library.
+    static EventLoop& shared();
+
+private:
+    struct Operation {
+        PollFunction poll;
+        Task completion;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::condition_variable woken;
+        std::vector<Operation> incoming;
+        bool stop = false;
+        std::thread thread;
+    };
+
+    void run(Worker& worker);
+
+    void add(Operation operation);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex mutex_;
+    size_t next_worker_ = 0;
+    std::atomic<size_t> pending_{0};
+};
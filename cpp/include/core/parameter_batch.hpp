@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <variant>
+#include <vector>
+#include <nanodbc/nanodbc.h>
+
+/// \brief Value of one statement parameter, std::monostate for NULL.
+///
+/// BIGINT values are int64_t, since long has only 32 bits on Windows.
+using ParameterValue = std::variant<
+    std::monostate,
+    short,
+    int,
+    int64_t,
+    float,
+    double,
+    nanodbc::date,
+    nanodbc::time,
+    nanodbc::timestamp,
+    nanodbc::string,
+    std::vector<uint8_t>>;
+
+/// \brief Parameter rows collected for one execution with a parameter array.
+///
+/// Every parameter keeps its values for all rows in one contiguous array of its type,
+/// the layout bound through SQL_ATTR_PARAMSET_SIZE. The type of a parameter is set by
+/// its first non-NULL value and must not change within the batch.
+class ParameterBatch {
+public:
+    /// \brief Appends a row holding the given value for each parameter; missing ones are NULL.
+    /// \throws invalid_argument if a parameter changes its type.
+    void add(const std::vector<ParameterValue>& row);
+
+    /// \brief Binds the arrays to the statement. They stay valid until clear or the next add.
+    /// \throws database_error
+    void bind(nanodbc::statement& statement);
+
+    /// \brief Number of rows added.
+    size_t rows() const {
+        return rows_;
+    }
+
+    /// \brief Removes all rows.
+    void clear();
+
+private:
+    /// Values of one parameter in an array of its type.
+    using Values = std::variant<
+        std::monostate,
+        std::vector<short>,
+        std::vector<int>,
+        std::vector<int64_t>,
+        std::vector<float>,
+        std::vector<double>,
+        std::vector<nanodbc::date>,
+        std::vector<nanodbc::time>,
+        std::vector<nanodbc::timestamp>,
+        std::vector<nanodbc::string>,
+        std::vector<std::vector<uint8_t>>>;
+
+    struct Column {
+        Values values;
+        std::vector<uint8_t> nulls;
+        std::unique_ptr<bool[]> null_flags;
+    };
+
+    static void check_type(const Column& column, const ParameterValue& value, size_t index);
+
+    static void append(Column& column, const ParameterValue& value, size_t rows);
+
+    std::vector<Column> columns_;
+    size_t rows_ = 0;
+};
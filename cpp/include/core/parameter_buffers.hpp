@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <nanodbc/nanodbc.h>
+#include "core/parameter_batch.hpp"
+
+/// \brief Memory the parameters of a statement are bound to, reused across executions.
+///
+/// Every parameter owns a buffer that grows in powers of two and keeps its length
+/// indicator next to it. Setting a new value writes into the buffer; the parameter is
+/// bound again only when its C type changes or the value outgrows the buffer, so
+/// re-executing with fresh values of the same kind costs neither allocations nor
+/// SQLBindParameter calls. NULL is set through the indicator of the current binding.
+/// Streams are bound for data at execution and sent in chunks through the same buffer.
+class ParameterBuffers {
+public:
+    /// \brief Reads up to length units of a stream into buffer.
+    /// \return The number of units read, 0 at the end of the stream, negative on failure.
+    using StreamReader = std::function<int(void* buffer, int length)>;
+
+    ParameterBuffers();
+
+    ParameterBuffers(const ParameterBuffers&) = delete;
+    ParameterBuffers& operator=(const ParameterBuffers&) = delete;
+
+    ~ParameterBuffers();
+
+    /// \brief Sets the parameter to a fixed-size value.
+    /// \param index Parameter position (0-indexed).
+    /// \throws database_error if the parameter cannot be bound.
+    void set(nanodbc::statement& statement, short index, short value);
+    void set(nanodbc::statement& statement, short index, int value);
+    void set(nanodbc::statement& statement, short index, int64_t value);
+    void set(nanodbc::statement& statement, short index, float value);
+    void set(nanodbc::statement& statement, short index, double value);
+    void set(nanodbc::statement& statement, short index, const nanodbc::date& value);
+    void set(nanodbc::statement& statement, short index, const nanodbc::time& value);
+    void set(nanodbc::statement& statement, short index, const nanodbc::timestamp& value);
+
+    /// \brief Sets the parameter to length UTF-16 code units.
+    void set_string(nanodbc::statement& statement, short index, const nanodbc::string::value_type* data, size_t length);
+
+    /// \brief Sets the parameter to length bytes.
+    void set_binary(nanodbc::statement& statement, short index, const uint8_t* data, size_t length);
+
+    /// \brief Sets the parameter to NULL.
+    void set_null(nanodbc::statement& statement, short index);
+
+    /// \brief Sets the parameter to a stream read while the statement executes.
+    ///
+    /// Only one chunk of the stream is held at a time, whatever its length. The stream
+    /// is read by one execution; later ones send NULL until a new stream is set.
+    /// \param character true for UTF-16 code units, false for bytes.
+    /// \param length Length of the stream in its units, negative if unknown.
+    void set_stream(nanodbc::statement& statement, short index, bool character, StreamReader reader, int64_t length);
+
+    /// \brief Returns true if a parameter is set to a stream.
+    bool has_streams() const;
+
+    /// \brief Sends the stream of the parameter the driver asked for with SQL_NEED_DATA.
+    /// \param token Value SQLParamData returned for the parameter.
+    /// \throws runtime_error if the stream fails to read.
+    /// \throws database_error if the driver rejects a chunk.
+    void put_stream(nanodbc::statement& statement, void* token);
+
+    /// \brief Returns the values of the count parameters of the statement.
+    /// \throws invalid_argument if one of them is not set or is set to a stream, or a later one is set.
+    std::vector<ParameterValue> values(size_t count) const;
+
+    /// \brief Forgets the values and the bindings, keeping the buffers.
+    ///
+    /// Call after the statement's parameters were reset or bound elsewhere.
+    void reset();
+
+    /// \brief Forgets the parameter descriptions too, for a statement prepared again.
+    void clear();
+
+private:
+    enum class Kind : uint8_t {
+        Unset,
+        Null,
+        Short,
+        Int,
+        Long,
+        Float,
+        Double,
+        Date,
+        Time,
+        Timestamp,
+        String,
+        Binary,
+        BinaryStream,
+        CharacterStream
+    };
+
+    struct Slot;
+
+    Slot& slot(short index);
+
+    /// Makes the slot hold size bytes of a value of the kind, binding it again if needed.
+    uint8_t* prepare(nanodbc::statement& statement, short index, Kind kind, size_t size);
+
+    /// Binds data, a buffer of capacity bytes, as the slot's value of the kind.
+    void bind(nanodbc::statement& statement, short index, Slot& slot, Kind kind, uint8_t* data, size_t capacity);
+
+    template <class T>
+    void set_fixed(nanodbc::statement& statement, short index, Kind kind, const T& value);
+
+    std::vector<std::unique_ptr<Slot>> slots_;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <nanodbc/nanodbc.h>
+
+/// \brief Whole columns of parameter values bound as parameter arrays for one execution.
+///
+/// Fixed-width values are bound where the caller keeps them, so they must stay valid
+/// until the statement is executed or the columns are cleared. Only the null bitmap is
+/// expanded into the flags nanodbc expects, and strings are laid out at a fixed width,
+/// the only layout ODBC accepts for a parameter array.
+class ParameterColumns {
+public:
+    /// \brief Binds rows values of a fixed-width type to the parameter.
+    /// \param nulls Null bitmap, bit (row % 8) of byte (row / 8) is set for NULL; nullptr if there are none.
+    /// \throws invalid_argument if rows differs from the columns bound before.
+    template <class T>
+    void bind(nanodbc::statement& statement, short index, const T* values, const uint8_t* nulls, size_t rows) {
+        Column& column = prepare(index, nulls, rows);
+        statement.bind(index, values, rows, column.null_flags.get());
+    }
+
+    /// \brief Binds rows strings packed one after another to the parameter.
+    /// \param data UTF-16 code units of all strings.
+    /// \param length Number of code units at data.
+    /// \param offsets rows + 1 offsets into data in code units, string i ends where string i + 1 starts.
+    /// \param nulls Null bitmap as for bind; nullptr if there are none.
+    /// \throws invalid_argument if rows differs from the columns bound before, or the offsets
+    /// decrease or end past length.
+    void bind_strings(nanodbc::statement& statement, short index, const nanodbc::string::value_type* data,
+                      size_t length, const int32_t* offsets, const uint8_t* nulls, size_t rows);
+
+    /// \brief Number of rows of the bound columns, 0 if none are bound.
+    size_t rows() const {
+        return rows_;
+    }
+
+    /// \brief Number of parameters bound so far.
+    size_t bound() const;
+
+    /// \brief Releases the buffers of all columns.
+    void clear();
+
+private:
+    struct Column {
+        bool bound = false;
+        std::unique_ptr<bool[]> null_flags;
+        std::vector<nanodbc::string::value_type> strings;
+    };
+
+    Column& prepare(short index, const uint8_t* nulls, size_t rows);
+
+    std::vector<Column> columns_;
+    size_t rows_ = 0;
+};
@@ -1,13 +1,80 @@
 #pragma once
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 #include <bimap.hpp>
 #include <nanodbc/nanodbc.h>
+#include "core/column_name_index.hpp"
+#include "core/row_cache.hpp"
+#include "core/row_prefetcher.hpp"
+#include "core/value_arena.hpp"
 #include "utils/number_proxy.hpp"
 #include "utils/string_proxy.hpp"
 #include "utils/string_utils.hpp"
+#include "api/api.h"
+#include "struct/binary_array.h"
+#include "struct/column_batch.h"
+#include "struct/nanodbc_c.h"
+#include "struct/row_layout.h"
+
+class EventLoop;
+class FetchAwaitable;
+
+/// \brief How ResultSet::get reads a column, resolved once from its C type.
+enum class ColumnAccessor : uint8_t {
+    Native, ///< Read directly in the requested type.
+    Char,   ///< Bound as SQL_C_CHAR, numbers are parsed and text is converted from the narrow encoding.
+    Binary, ///< Bound as SQL_C_BINARY, read through the narrow string path.
+    Decimal ///< DECIMAL or NUMERIC of a block cursor, bound as SQL_C_CHAR into buffers of the ResultSet.
+};
+
+/// \brief Rowset buffers of a DECIMAL or NUMERIC column bound as text by ResultSet.
+struct BoundDecimal {
+    /// Characters per row, enough for 38 digits, sign, point and an exponent.
+    static constexpr size_t WIDTH = 64;
+
+    short column = 0;
+    std::vector<char> text;             ///< WIDTH characters per row of the rowset.
+    std::vector<std::intptr_t> lengths; ///< Length or SQL_NULL_DATA per row, an SQLLEN each.
+};
+
+/// \brief Immutable description of a result set column.
+struct ColumnDescriptor {
+    short c_type = 0;                                 ///< C data type the column is bound or read as.
+    short sql_type = 0;                               ///< SQL data type reported by the driver.
+    unsigned long size = 0;                           ///< Column size (precision or maximum length).
+    short scale = 0;                                  ///< Decimal digits.
+    short nullable = 2;                               ///< SQL_NO_NULLS, SQL_NULLABLE or SQL_NULLABLE_UNKNOWN.
+    int32_t batch_type = COLUMN_BATCH_STRING;         ///< ColumnBatchType used by fetch_batch.
+    ColumnAccessor accessor = ColumnAccessor::Native; ///< Pre-resolved accessor kind.
+};
 
 class ResultSet : public nanodbc::result {
 
     stde::bimap<nanodbc::string, short> aliases;
+    std::vector<ColumnDescriptor> descriptors_;
+    mutable ColumnNameIndex name_index_;
+    mutable bool name_index_built_ = false; // a result without columns leaves the index empty once built
+    bool wide_char_fetch_ = false;
+    mutable std::vector<int8_t> direct_nulls_;
+    mutable bool numeric_unsupported_ = false;
+    std::vector<BoundDecimal> bound_decimals_;
+    long rowset_row_ = 0; // row of the rowset nanodbc reads, followed for bound_decimals_
+    short text_column_ = -1;
+    bool text_null_ = false;
+    ApiString text_;
+    const ColumnBatch* prefetched_ = nullptr;
+    int32_t prefetched_row_ = -1;
+    unsigned long prefetched_position_ = 0;
+    mutable const RowLayout* packed_layout_ = nullptr; // layout holding the current row
+    std::unique_ptr<RowCache> row_cache_;
+    std::unique_ptr<ValueArena> value_arena_;
+    std::shared_ptr<void> statement_owner_;
+    // declared last so the worker is joined before the state it reads is destroyed
+    std::unique_ptr<RowPrefetcher> prefetcher_;
 
 public:
     /// \brief Empty result set.
@@ -17,10 +84,229 @@ public:
     explicit ResultSet(const result& rhs);
 
     /// \brief Move constructor.
-    explicit ResultSet(result&& rhs) noexcept;
+    explicit ResultSet(result&& rhs);
 
     ResultSet(nanodbc::statement&& statement, long rowset_size);
 
+    /// \brief Opens a result set over an already executed statement.
+    ///
+    /// With fetch_size > 1 columns stay bound into row arrays and rows are fetched
+    /// in blocks of fetch_size rows. DECIMAL and NUMERIC columns are bound as text there,
+    /// since nanodbc would bind them as doubles. If the driver leaves some column unbound
+    /// (long data), the cursor falls back to single-row fetches, because SQLGetData on a
+    /// block cursor is not supported by every driver. Single-row result sets are fully
+    /// unbound and read through SQLGetData.
+    /// \param statement Executed statement.
+    /// \param fetch_size Number of rows per fetch, values below 1 are treated as 1.
+    /// \param wide_char_fetch Read unbound character columns as SQL_C_WCHAR.
+    /// \throws database_error
+    static ResultSet open(const nanodbc::statement& statement, long fetch_size, bool wide_char_fetch = false);
+
+    /// \brief Starts reading rows ahead on a background thread.
+    ///
+    /// A worker fetches the next batch_rows rows into a column batch while the current
+    /// batch is read through the usual accessors, which are then served from memory.
+    /// Only the worker uses the statement handle from here on, so the cursor becomes
+    /// forward-only: scrolling, fetch_batch and SQLGetData streams are unavailable, and
+    /// DECIMAL columns of a single-row cursor are read as doubles. A fetch error is reported by
+    /// next() once the rows fetched before it have been consumed. The result set must
+    /// not be moved afterwards.
+    /// \param batch_rows Number of rows fetched ahead per batch.
+    /// \throws invalid_argument if batch_rows is not positive.
+    /// \throws logic_error if the row cache is enabled.
+    void enable_prefetch(int batch_rows);
+
+    /// \brief Keeps the rows read so far on the client, so the cursor can scroll over them.
+    ///
+    /// Rows are then read forward from the driver in blocks and stored in memory up to
+    /// memory_budget bytes, the rest in a memory-mapped temporary file. prior, first, last
+    /// and move are served from the cache and work with forward-only driver cursors.
+    /// Rows read before the call are not cached and row numbers start after them.
+    /// Accessors and restrictions are the same as with enable_prefetch, except scrolling.
+    /// \param memory_budget Bytes of rows kept in memory before spilling to disk.
+    /// \throws logic_error while prefetching.
+    void enable_row_cache(size_t memory_budget);
+
+    /// \brief Allocates values returned for the current row from an arena.
+    ///
+    /// Strings, dates, times, timestamps and byte arrays handed out by the C API then stay
+    /// valid until the cursor moves and are released together; they must not be freed
+    /// one by one.
+    void enable_value_arena();
+
+    /// \brief Returns the arena of the current row, nullptr unless enabled.
+    ValueArena* value_arena() const {
+        return value_arena_.get();
+    }
+
+    /// \brief Keeps the statement the rows are read from in use until the result set is gone.
+    /// \param owner Releases the statement when the last reference goes.
+    void hold_statement(std::shared_ptr<void> owner) {
+        statement_owner_ = std::move(owner);
+    }
+
+    /// \brief Hands over the statement held, so it can be released after the result set is destroyed.
+    std::shared_ptr<void> release_statement() {
+        return std::move(statement_owner_);
+    }
+
+    /// \brief Returns true if unbound character columns are read as SQL_C_WCHAR.
+    bool wide_char_fetch() const {
+        return wide_char_fetch_;
+    }
+
+    /// \brief Returns true if rows are served from memory by the prefetcher or the row cache.
+    bool is_buffered() const {
+        return prefetcher_ != nullptr || row_cache_ != nullptr;
+    }
+
+    /// \brief Locks the statement handle against the prefetch worker.
+    ///
+    /// Hold the lock for calls that use the statement directly, such as metadata queries.
+    /// Without prefetching the returned lock is empty.
+    std::unique_lock<std::mutex> lock_cursor() const {
+        return prefetcher_ ? prefetcher_->lock_cursor() : std::unique_lock<std::mutex>();
+    }
+
+    /// \brief Moves to the next row.
+    /// \throws database_error
+    bool next();
+
+    /// \brief Returns an awaitable moving to the next row on a worker thread.
+    ///
+    /// co_await yields what next would return, on a thread of the shared event loop;
+    /// include core/async_operations.hpp to await it.
+    FetchAwaitable fetch_async();
+
+    /// \brief Returns an awaitable moving to the next row, resumed on a thread of the given loop.
+    FetchAwaitable fetch_async(EventLoop& loop);
+
+    /// \brief Moves to the previous row.
+    /// \throws database_error
+    /// \throws logic_error while prefetching.
+    bool prior();
+
+    /// \brief Moves to the first row.
+    /// \throws database_error
+    /// \throws logic_error while prefetching.
+    bool first();
+
+    /// \brief Moves to the last row.
+    /// \throws database_error
+    /// \throws logic_error while prefetching.
+    bool last();
+
+    /// \brief Moves to the given absolute row.
+    /// \throws database_error
+    /// \throws logic_error while prefetching.
+    bool move(long row);
+
+    /// \brief Skips the given number of rows.
+    /// \throws database_error
+    /// \throws logic_error while prefetching.
+    bool skip(long rows);
+
+    /// \brief Returns the current row number, counted here while rows are buffered.
+    unsigned long position() const {
+        if (row_cache_) {
+            return row_cache_->position();
+        }
+        return prefetcher_ ? prefetched_position_ : result::position();
+    }
+
+    using result::is_null;
+
+    /// \brief Returns true if the value of the column in the current row is NULL.
+    ///
+    /// Columns read directly as SQL_C_WCHAR or SQL_C_NUMERIC bypass nanodbc, their indicator is tracked here.
+    /// \param column Column position (0-indexed).
+    /// \throws index_range_error
+    bool is_null(short column) const {
+        if (is_buffered()) {
+            return buffered_value(column).data == nullptr;
+        }
+        return cursor_is_null(column);
+    }
+
+    /// \brief Reads the column of the current row as UTF-16 text.
+    ///
+    /// The value is kept until the cursor moves, so reading the same column again
+    /// does not go back to the driver. This allows retrying a copy into a larger
+    /// buffer even for unbound columns, which can only be read once.
+    /// \param column Column position (0-indexed).
+    /// \return The text, or nullptr if the value is NULL.
+    /// \throws database_error
+    /// \throws index_range_error
+    const ApiString* get_text(short column);
+
+    /// \brief Reads the column of the current row as bytes.
+    ///
+    /// The column's C type decides the conversion up front: binary columns give their bytes,
+    /// character columns their text in the narrow encoding and other columns their text form.
+    /// Unbound binary and character columns are read with SQLGetData into a single allocation
+    /// sized from the length the driver reports. With the value arena enabled the bytes are
+    /// allocated from it and value must not be destroyed.
+    /// \param column Column position (0-indexed).
+    /// \param value Receives the bytes.
+    /// \return false if the value is NULL.
+    /// \throws database_error
+    /// \throws index_range_error
+    bool get_bytes(short column, BinaryArray& value);
+
+    /// \brief Reads the column of the current row as an exact decimal.
+    ///
+    /// Unbound DECIMAL and NUMERIC columns are fetched as SQL_C_NUMERIC with the column's
+    /// precision and scale, block cursors parse the text bound for them. Buffered rows of a
+    /// single-row cursor hold a double, which is converted through its shortest
+    /// round-trip representation and padded to the column scale; this is exact up to
+    /// 15 significant digits. Integer columns are read natively, other columns are parsed
+    /// from their text. If the driver rejects SQL_C_NUMERIC, text is used from then on.
+    /// \param column Column position (0-indexed).
+    /// \param value Receives the unscaled value and scale.
+    /// \return false if the value is NULL or an empty string.
+    /// \throws database_error
+    /// \throws index_range_error
+    /// \throws type_incompatible_error
+    bool get_decimal(short column, CDecimal& value);
+
+    /// \brief Advances the cursor by up to max_rows rows, copying them into batch.
+    ///
+    /// Integer and floating point columns are stored as fixed-width arrays, every other
+    /// column as UTF-16 text or raw bytes addressed by offsets. Nulls are marked in the
+    /// per-column bitmap.
+    /// \param batch Destination batch, reset before the first row is copied.
+    /// \param max_rows Maximum number of rows to copy.
+    /// \return Number of rows copied, 0 once the cursor is exhausted.
+    /// \throws database_error
+    /// \throws logic_error while rows are buffered.
+    int fetch_batch(ColumnBatch& batch, int max_rows);
+
+    /// \brief Returns the ColumnBatchType fetch_batch uses for the given column.
+    /// \param column Column position (0-indexed).
+    /// \throws index_range_error
+    int32_t column_batch_type(short column) const {
+        return descriptor(column).batch_type;
+    }
+
+    /// \brief Returns the descriptor built for the given column when the result set was opened.
+    /// \param column Column position (0-indexed).
+    /// \throws index_range_error
+    const ColumnDescriptor& descriptor(short column) const {
+        if (column < 0 || static_cast<size_t>(column) >= descriptors_.size()) {
+            throw nanodbc::index_range_error();
+        }
+        return descriptors_[column];
+    }
+
+    /// \brief Packs every column of the current row into layout.row.
+    ///
+    /// The layout must have been initialized with the column types of this result set.
+    /// A row still pending in the layout is kept if the cursor has not moved since it was
+    /// packed, since unbound columns can be read only once.
+    /// \param layout Destination layout, its previous row is discarded.
+    /// \throws database_error
+    void pack_row(RowLayout& layout) const;
+
     /// \brief Gets data from the given column of the current rowset.
     ///
     /// Columns are numbered from left to right and 0-indexed.
@@ -31,13 +317,10 @@ public:
     /// \throws null_access_error
     template <class T>
     T get(short column) const {
-        if constexpr (std::is_arithmetic_v<T>) {
-            return getArithmetic<T>(column);
-        }
-        if constexpr (nanodbc::is_string<T>::value){
-            return getString<T>(column);
+        if (is_buffered()) {
+            return getBuffered<T>(column);
         }
-        return result::get<T>(column);
+        return read<T>(column);
     }
 
     /// \brief Gets data from the given column of the current rowset.
@@ -52,13 +335,10 @@ public:
     /// \throws type_incompatible_error
     template <class T>
     T get(short column, T const& fallback) const {
-        if constexpr (std::is_arithmetic_v<T>) {
-            return getArithmetic<T>(column, fallback);
+        if (is_buffered()) {
+            return is_null(column) ? fallback : getBuffered<T>(column);
         }
-        if constexpr (nanodbc::is_string<T>::value){
-            return getString<T>(column, fallback);
-        }
-        return result::get<T>(column, fallback);
+        return read<T>(column, fallback);
     }
 
     /// \brief Gets data from the given column by name of the current rowset.
@@ -70,13 +350,16 @@ public:
     /// \throws null_access_error
     template <class T>
     T get(nanodbc::string const& column_name) const {
+        if (is_buffered()) {
+            return get<T>(find_column(column_name));
+        }
         if constexpr (std::is_arithmetic_v<T>) {
             return getArithmetic<T>(column_name);
         }
         if constexpr (nanodbc::is_string<T>::value){
             return getString<T>(column_name);
         }
-        return result::get<T>(column_name);
+        return result::get<T>(find_column(column_name));
     }
 
     /// \brief Gets data from the given column by name of the current rowset.
@@ -90,15 +373,27 @@ public:
     /// \throws type_incompatible_error
     template <class T>
     T get(nanodbc::string const& column_name, T const& fallback) const {
+        if (is_buffered()) {
+            return get<T>(find_column(column_name), fallback);
+        }
         if constexpr (std::is_arithmetic_v<T>) {
             return getArithmetic<T>(column_name, fallback);
         }
         if constexpr (nanodbc::is_string<T>::value){
             return getString<T>(column_name, fallback);
         }
-        return result::get<T>(column_name, fallback);
+        return result::get<T>(find_column(column_name), fallback);
     }
 
+    /// \brief Returns the position of the column with the given name or alias.
+    ///
+    /// Names are compared case-insensitively; if several columns share a name,
+    /// the leftmost one is returned. The lookup uses a hash index built on first use.
+    /// \param column_name Column name or alias.
+    /// \return Column position (0-indexed).
+    /// \throws index_range_error
+    short find_column(nanodbc::string const& column_name) const;
+
     /// \brief Sets an alias name for the specified column in the rowset.
     ///
     /// If the specified column number is out of range, no alias is set and
@@ -117,127 +412,247 @@ public:
     nanodbc::string map_column_name(nanodbc::string const& column_name, short column) const;
 
 private:
+    template <class T>
+    T read(short column) const {
+        if constexpr (std::is_arithmetic_v<T>) {
+            return getArithmetic<T>(column);
+        }
+        if constexpr (nanodbc::is_string<T>::value){
+            return getString<T>(column);
+        }
+        return result::get<T>(column);
+    }
+
+    template <class T>
+    T read(short column, T const& fallback) const {
+        if constexpr (std::is_arithmetic_v<T>) {
+            return getArithmetic<T>(column, fallback);
+        }
+        if constexpr (nanodbc::is_string<T>::value){
+            return getString<T>(column, fallback);
+        }
+        return result::get<T>(column, fallback);
+    }
+
+    template <class T>
+    T getBuffered(short column) const {
+        const BufferedValue value = buffered_value(column);
+        if (!value.data) {
+            throw nanodbc::null_access_error();
+        }
+        if constexpr (std::is_arithmetic_v<T>) {
+            switch (value.type) {
+                case COLUMN_BATCH_INT32:
+                    return static_cast<T>(buffered_fixed<int32_t>(value));
+                case COLUMN_BATCH_INT64:
+                    return static_cast<T>(buffered_fixed<int64_t>(value));
+                case COLUMN_BATCH_DOUBLE:
+                    return static_cast<T>(buffered_fixed<double>(value));
+                case COLUMN_BATCH_STRING: {
+                    NumberProxy number_proxy(static_cast<std::string>(StringProxy(buffered_text(value))));
+                    return static_cast<T>(number_proxy);
+                }
+                default:
+                    throw nanodbc::type_incompatible_error();
+            }
+        } else if constexpr (nanodbc::is_string<T>::value) {
+            return static_cast<T>(StringProxy(buffered_text(value)));
+        } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+            return buffered_bytes(value);
+        } else if constexpr (std::is_same_v<T, nanodbc::date>) {
+            const nanodbc::timestamp timestamp = buffered_timestamp(column, value);
+            return nanodbc::date{timestamp.year, timestamp.month, timestamp.day};
+        } else if constexpr (std::is_same_v<T, nanodbc::time>) {
+            const nanodbc::timestamp timestamp = buffered_timestamp(column, value);
+            return nanodbc::time{timestamp.hour, timestamp.min, timestamp.sec};
+        } else {
+            static_assert(std::is_same_v<T, nanodbc::timestamp>, "type is not supported on buffered rows");
+            return buffered_timestamp(column, value);
+        }
+    }
+
+    template <typename T>
+    static T buffered_fixed(const BufferedValue& value) {
+        T number;
+        std::memcpy(&number, value.data, sizeof(T));
+        return number;
+    }
+
     template <typename T>
     T getArithmetic(short column) const {
-        if (is_string_or_binary(column)) {
-            const auto str_value = result::get<std::string>(column);
-            NumberProxy number_proxy(str_value);
-            return static_cast<T> (number_proxy);
+        switch (descriptor(column).accessor) {
+            case ColumnAccessor::Decimal:
+                return static_cast<T> (NumberProxy(decimal_text(column)));
+            case ColumnAccessor::Char:
+            case ColumnAccessor::Binary: {
+                const auto str_value = result::get<std::string>(column);
+                NumberProxy number_proxy(str_value);
+                return static_cast<T> (number_proxy);
+            }
+            default:
+                return result::get<T>(column);
         }
-        return result::get<T>(column);
     }
 
     template <class T>
     T getArithmetic(short column, T const& fallback) const {
-        if (is_string_or_binary(column)) {
-            NumberProxy fallback_value(fallback);
-            const auto str_value = result::get<std::string>(column, static_cast<std::string> (fallback_value));
-            NumberProxy number_proxy(str_value);
-            return static_cast<T> (number_proxy);
+        switch (descriptor(column).accessor) {
+            case ColumnAccessor::Decimal:
+                return cursor_is_null(column) ? fallback : static_cast<T> (NumberProxy(decimal_text(column)));
+            case ColumnAccessor::Char:
+            case ColumnAccessor::Binary: {
+                NumberProxy fallback_value(fallback);
+                const auto str_value = result::get<std::string>(column, static_cast<std::string> (fallback_value));
+                NumberProxy number_proxy(str_value);
+                return static_cast<T> (number_proxy);
+            }
+            default:
+                return result::get<T>(column, fallback);
         }
-        return result::get<T>(column, fallback);
     }
 
     template <class T>
     T getArithmetic(nanodbc::string const& column_name) const {
-        if (is_string_or_binary(column_name)) {
-            const auto str_value = result::get<std::string>(column_name);
-            NumberProxy number_proxy(str_value);
-            return static_cast<T> (number_proxy);
-        }
-        return result::get<T>(column_name);
+        return getArithmetic<T>(find_column(column_name));
     }
 
     template <class T>
     T getArithmetic(nanodbc::string const& column_name, T const& fallback) const {
-        if (is_string_or_binary(column_name)) {
-            NumberProxy fallback_value(fallback);
-            const auto str_value = result::get<std::string>(column_name, static_cast<std::string> (fallback_value));
-            NumberProxy number_proxy(str_value);
-            return static_cast<T> (number_proxy);
-        }
-        return result::get<T>(column_name, fallback);
+        return getArithmetic<T>(find_column(column_name), fallback);
     }
 
     template <typename T>
     T getString(short column) const {
+        if (descriptor(column).accessor == ColumnAccessor::Decimal) {
+            return static_cast<T> (StringProxy(decimal_text(column)));
+        }
         if constexpr (std::is_same_v<T, std::string>) {
             return result::get<T>(column);
         }
 
-        if (is_string_or_binary(column)) {
-            const auto str_value = result::get<std::string>(column);
+        switch (descriptor(column).accessor) {
+            case ColumnAccessor::Char:
+                if (wide_char_fetch_ && !is_bound(column)) {
+                    ApiString value;
+                    if (!read_wide_text(column, value)) {
+                        throw nanodbc::null_access_error();
+                    }
+                    return static_cast<T> (StringProxy(std::move(value)));
+                }
+                [[fallthrough]];
+            case ColumnAccessor::Binary: {
+                const auto str_value = result::get<std::string>(column);
 #ifdef _WIN32
-            // On Windows, ODBC drivers typically return SQL_C_CHAR data in the system's active ANSI code page (e.g., CP1251 for Russian locales)
-            StringProxy string_proxy(utils::ansi_to_wstring(str_value));
+                // On Windows, ODBC drivers typically return SQL_C_CHAR data in the system's active ANSI code page (e.g., CP1251 for Russian locales)
+                StringProxy string_proxy(utils::ansi_to_wstring(str_value));
 #else
-            StringProxy string_proxy(str_value);
+                StringProxy string_proxy(str_value);
 #endif
-            return static_cast<T> (string_proxy);
+                return static_cast<T> (string_proxy);
+            }
+            default:
+                return result::get<T>(column);
         }
-        return result::get<T>(column);
     }
 
     template <class T>
     T getString(short column, T const& fallback) const {
+        if (descriptor(column).accessor == ColumnAccessor::Decimal) {
+            return cursor_is_null(column) ? fallback : static_cast<T> (StringProxy(decimal_text(column)));
+        }
         if constexpr (std::is_same_v<T, std::string>) {
             return result::get<T>(column, fallback);
         }
 
-        if (is_string_or_binary(column)) {
-            StringProxy fallback_value(fallback);
-            const auto str_value = result::get<std::string>(column, static_cast<std::string> (fallback_value));
+        switch (descriptor(column).accessor) {
+            case ColumnAccessor::Char:
+                if (wide_char_fetch_ && !is_bound(column)) {
+                    ApiString value;
+                    if (!read_wide_text(column, value)) {
+                        return fallback;
+                    }
+                    return static_cast<T> (StringProxy(std::move(value)));
+                }
+                [[fallthrough]];
+            case ColumnAccessor::Binary: {
+                StringProxy fallback_value(fallback);
+                const auto str_value = result::get<std::string>(column, static_cast<std::string> (fallback_value));
 #ifdef _WIN32
-            // On Windows, ODBC drivers typically return SQL_C_CHAR data in the system's active ANSI code page (e.g., CP1251 for Russian locales)
-            StringProxy string_proxy(utils::ansi_to_wstring(str_value));
+                // On Windows, ODBC drivers typically return SQL_C_CHAR data in the system's active ANSI code page (e.g., CP1251 for Russian locales)
+                StringProxy string_proxy(utils::ansi_to_wstring(str_value));
 #else
-            StringProxy string_proxy(str_value);
+                StringProxy string_proxy(str_value);
 #endif
-            return static_cast<T> (string_proxy);
+                return static_cast<T> (string_proxy);
+            }
+            default:
+                return result::get<T>(column, fallback);
         }
-        return result::get<T>(column, fallback);
     }
 
     template <class T>
     T getString(nanodbc::string const& column_name) const {
-        if constexpr (std::is_same_v<T, std::string>) {
-            return result::get<T>(column_name);
-        }
-
-        if (is_string_or_binary(column_name)) {
-            const auto str_value = result::get<std::string>(column_name);
-#ifdef _WIN32
-            // On Windows, ODBC drivers typically return SQL_C_CHAR data in the system's active ANSI code page (e.g., CP1251 for Russian locales)
-            StringProxy string_proxy(utils::ansi_to_wstring(str_value));
-#else
-            StringProxy string_proxy(str_value);
-#endif
-            return static_cast<T> (string_proxy);
-        }
-        return result::get<T>(column_name);
+        return getString<T>(find_column(column_name));
     }
 
     template <class T>
     T getString(nanodbc::string const& column_name, T const& fallback) const {
-        if constexpr (std::is_same_v<T, std::string>) {
-            return result::get<T>(column_name, fallback);
-        }
+        return getString<T>(find_column(column_name), fallback);
+    }
 
-        if (is_string_or_binary(column_name)) {
-            StringProxy fallback_value(fallback);
-            const auto str_value = result::get<std::string>(column_name, static_cast<std::string> (fallback_value));
-#ifdef _WIN32
-            // On Windows, ODBC drivers typically return SQL_C_CHAR data in the system's active ANSI code page (e.g., CP1251 for Russian locales)
-            StringProxy string_proxy(utils::ansi_to_wstring(str_value));
-#else
-            StringProxy string_proxy(str_value);
-#endif
-            return static_cast<T> (string_proxy);
+    void describe_columns();
+
+    void on_row_changed();
+
+    void reset_direct_nulls();
+
+    void ensure_scrollable() const;
+
+    bool next_prefetched();
+
+    int fill_batch(ColumnBatch& batch, int max_rows);
+
+    bool cursor_is_null(short column) const {
+        if (static_cast<size_t>(column) < direct_nulls_.size() && direct_nulls_[column] >= 0) {
+            return direct_nulls_[column] != 0;
+        }
+        if (!bound_decimals_.empty() && descriptor(column).accessor == ColumnAccessor::Decimal) {
+            return decimal_is_null(column);
         }
-        return result::get<T>(column_name, fallback);
+        return result::is_null(column);
     }
 
-    bool is_string_or_binary(short column) const;
+    BufferedValue buffered_value(short column) const;
+
+    static ApiString buffered_text(const BufferedValue& value);
+
+    static std::vector<uint8_t> buffered_bytes(const BufferedValue& value);
+
+    nanodbc::timestamp buffered_timestamp(short column, const BufferedValue& value) const;
+
+    bool read_wide_text(short column, ApiString& value) const;
+
+    bool read_bytes(short column, short c_type, BinaryArray& value) const;
+
+    int8_t* allocate_bytes(size_t size) const;
+
+    void release_bytes(int8_t* data) const;
+
+    void assign_bytes(BinaryArray& value, const uint8_t* data, size_t size) const;
+
+    bool read_numeric(short column, CDecimal& value) const;
+
+    bool has_unbound_columns() const;
+
+    void bind_decimals();
+
+    const BoundDecimal& bound_decimal(short column) const;
+
+    bool decimal_is_null(short column) const;
+
+    std::string decimal_text(short column) const;
+
+    void follow_rowset(bool had_rows, long row);
 
-    bool is_string_or_binary(const nanodbc::string& column_name) const;
-};
\ No newline at end of file
+    void copy_to_batch(ColumnBatch::Column& target, short column, int32_t row) const;
+};
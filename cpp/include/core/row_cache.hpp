@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "struct/column_batch.h"
+#include "struct/row_layout.h"
+
+/// \brief Column value of a row held in memory.
+struct BufferedValue {
+    int32_t type = COLUMN_BATCH_STRING; ///< ColumnBatchType of the value.
+    const uint8_t* data = nullptr;      ///< Value bytes, nullptr for NULL.
+    size_t size = 0;                    ///< Number of bytes at data.
+};
+
+class SpillFile;
+
+/// \brief Client-side scrollable cursor over rows read forward from the driver.
+///
+/// Rows are fetched in blocks as the cursor moves past the rows seen so far and kept
+/// in the read_row packed format. They are copied into arena blocks until the memory
+/// budget is used up; later rows go to a memory-mapped temporary file, which is
+/// deleted with the cache. Moving backwards never goes back to the driver.
+class RowCache {
+public:
+    /// \brief Fills the batch with up to max_rows rows and returns their count, 0 at the end.
+    using FetchFunction = std::function<int(ColumnBatch&, int)>;
+
+    /// \param fetch Function reading rows forward from the cursor.
+    /// \param column_types ColumnBatchType of each column.
+    /// \param memory_budget Bytes of rows kept in memory before spilling to disk.
+    RowCache(FetchFunction fetch, const std::vector<int32_t>& column_types, size_t memory_budget);
+
+    RowCache(const RowCache&) = delete;
+    RowCache& operator=(const RowCache&) = delete;
+
+    ~RowCache();
+
+    /// \brief Moves to the row with the given 0-based index, fetching rows up to it.
+    ///
+    /// A negative index positions before the first row, an index past the end after the last.
+    /// \return true if the cursor is on a row.
+    /// \throws database_error
+    bool move_to(int64_t index);
+
+    /// \brief Moves to the next row.
+    bool next() {
+        return move_to(current_ + 1);
+    }
+
+    /// \brief Moves to the previous row, from after the last row onto the last one.
+    bool prior() {
+        return move_to(current_ - 1);
+    }
+
+    /// \brief Moves by the given number of rows relative to the current one.
+    bool skip(int64_t rows) {
+        return move_to(current_ + rows);
+    }
+
+    /// \brief Moves to the last row, fetching all remaining rows.
+    bool last();
+
+    /// \brief Moves to a row counted as ODBC SQL_FETCH_ABSOLUTE does.
+    ///
+    /// Positive rows count from 1 at the start, negative ones from -1 at the end.
+    bool absolute(int64_t row);
+
+    /// \brief Returns the 1-based number of the current row, 0 if the cursor is not on a row.
+    unsigned long position() const {
+        return on_row() ? static_cast<unsigned long>(current_ + 1) : 0;
+    }
+
+    /// \brief Returns true if the cursor is on a row.
+    bool on_row() const {
+        return current_ >= 0 && current_ < static_cast<int64_t>(entries_.size());
+    }
+
+    /// \brief Returns the value of the column in the current row.
+    /// \throws logic_error if the cursor is not on a row.
+    const BufferedValue& value(short column) const;
+
+    /// \brief Number of rows fetched so far.
+    size_t size() const {
+        return entries_.size();
+    }
+
+    /// \brief Bytes of rows written to the temporary file.
+    uint64_t spilled_bytes() const;
+
+private:
+    static constexpr int FETCH_ROWS = 64;
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+
+    /// Where a packed row is kept: an arena block, or the spill file if block is negative.
+    struct Entry {
+        uint64_t offset;
+        uint32_t length;
+        int32_t block;
+    };
+
+    void fetch_until(int64_t index);
+
+    void store(const uint8_t* row, size_t length);
+
+    void pack(int32_t row);
+
+    void decode(const Entry& entry);
+
+    FetchFunction fetch_;
+    size_t memory_budget_;
+    size_t memory_used_ = 0;
+    std::vector<std::unique_ptr<uint8_t[]>> blocks_;
+    size_t block_used_ = 0;
+    size_t block_capacity_ = 0;
+    std::unique_ptr<SpillFile> spill_;
+    std::vector<Entry> entries_;
+    ColumnBatch batch_;
+    RowLayout layout_;
+    std::vector<BufferedValue> values_;
+    int64_t current_ = -1;
+    bool exhausted_ = false;
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "struct/column_batch.h"
+
+/// \brief Fills column batches on a worker thread while the consumer reads the previous one.
+///
+/// Two batches are used in turn: the worker fills one while the consumer holds the other,
+/// so at most one batch is fetched ahead. ODBC allows a statement handle to be used by one
+/// thread at a time; the fetch function runs only on the worker and holds the cursor lock,
+/// which the consumer takes for any other call on the same statement.
+class RowPrefetcher {
+public:
+    /// \brief Fills the batch with up to max_rows rows and returns their count, 0 at the end.
+    using FetchFunction = std::function<int(ColumnBatch&, int)>;
+
+    /// \brief Starts the worker, which immediately fetches the first batch.
+    /// \param fetch Function reading rows from the cursor, called on the worker thread only.
+    /// \param batch_rows Maximum number of rows per batch.
+    RowPrefetcher(FetchFunction fetch, int batch_rows);
+
+    RowPrefetcher(const RowPrefetcher&) = delete;
+    RowPrefetcher& operator=(const RowPrefetcher&) = delete;
+
+    /// \brief Stops the worker, waiting for a fetch in progress to complete.
+    ~RowPrefetcher();
+
+    /// \brief Releases the batch returned by the previous call and waits for the next one.
+    ///
+    /// If the fetch function threw, the exception is rethrown here once the batches
+    /// fetched before the failure have been handed out.
+    /// \return The next batch, or nullptr once the cursor is exhausted.
+    const ColumnBatch* next_batch();
+
+    /// \brief Blocks the worker from the statement handle while the lock is held.
+    std::unique_lock<std::mutex> lock_cursor();
+
+private:
+    enum class SlotState : uint8_t {
+        Free,
+        Ready,
+        Consumed
+    };
+
+    void run();
+
+    FetchFunction fetch_;
+    int batch_rows_;
+    ColumnBatch batches_[2];
+    SlotState states_[2] = {SlotState::Free, SlotState::Free};
+    int next_slot_ = 0;
+    int consumed_slot_ = -1;
+    bool finished_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::mutex mutex_;
+    std::mutex cursor_mutex_;
+    std::condition_variable changed_;
+    std::thread worker_;
+};
@@ -0,0 +1,140 @@
+#pragma once
+#include <memory>
+#include <utility>
+#include <vector>
+#include <nanodbc/nanodbc.h>
+#include "core/connection.hpp"
+#include "core/parameter_batch.hpp"
+#include "core/parameter_buffers.hpp"
+#include "core/parameter_columns.hpp"
+#include "core/statement_cache.hpp"
+
+/// \brief Statement handed out by the C API.
+///
+/// Keeps the settings of its connection that affect how results are read,
+/// because nanodbc::statement only refers to the plain nanodbc::connection.
+/// Parameter values are kept in buffers bound once and overwritten by later values;
+/// they also make up the next row of a batch, unless whole columns are bound instead.
+class Statement : public nanodbc::statement {
+    bool wide_char_fetch_;
+    ParameterBuffers parameters_;
+    ParameterBatch batch_;
+    ParameterColumns columns_;
+    std::weak_ptr<StatementCache> cache_;
+    StatementCache::Key cache_key_;
+
+public:
+    /// Row count of a batch row that succeeded without a known count, as in JDBC.
+    static constexpr int BATCH_SUCCESS_NO_INFO = -2;
+    /// Row count of a batch row that failed or was not executed, as in JDBC.
+    static constexpr int BATCH_EXECUTE_FAILED = -3;
+
+    explicit Statement(Connection& conn);
+
+    /// \brief Returns true if character columns are read as SQL_C_WCHAR.
+    bool get_wide_char_fetch() const;
+
+    /// \brief Prepares the SQL, forgetting the parameters and batch of the previous one.
+    /// \throws database_error
+    void prepare(const nanodbc::string& query, long timeout = 0);
+
+    /// \brief Sets a parameter to a fixed-size value, kept for execution and add_batch.
+    /// \param index Parameter position (0-indexed).
+    /// \throws database_error if the parameter cannot be bound.
+    template <class T>
+    void set_parameter(short index, const T& value) {
+        parameters_.set(*this, index, value);
+    }
+
+    /// \brief Sets a parameter to length UTF-16 code units.
+    void set_string_parameter(short index, const nanodbc::string::value_type* data, size_t length) {
+        parameters_.set_string(*this, index, data, length);
+    }
+
+    /// \brief Sets a parameter to length bytes.
+    void set_binary_parameter(short index, const uint8_t* data, size_t length) {
+        parameters_.set_binary(*this, index, data, length);
+    }
+
+    /// \brief Sets a parameter to NULL.
+    void set_null_parameter(short index) {
+        parameters_.set_null(*this, index);
+    }
+
+    /// \brief Sets a parameter to a stream sent in chunks by execute_once.
+    /// \param character true for UTF-16 code units, false for bytes.
+    /// \param length Length of the stream in its units, negative if unknown.
+    void set_stream_parameter(short index, bool character, ParameterBuffers::StreamReader reader, int64_t length) {
+        parameters_.set_stream(*this, index, character, std::move(reader), length);
+    }
+
+    /// \brief Returns true if a parameter is set to a stream.
+    bool has_stream_parameters() const {
+        return parameters_.has_streams();
+    }
+
+    /// \brief Executes the statement for the current parameter values.
+    ///
+    /// Stream parameters are read and sent chunk by chunk when the driver asks for them.
+    /// \param timeout Query timeout in seconds.
+    /// \throws database_error
+    /// \throws runtime_error if a stream fails to read; the execution is cancelled.
+    void execute_once(long timeout);
+
+    /// \brief Adds the current parameter values as a row of the batch.
+    /// \throws invalid_argument if a parameter changes its type within the batch,
+    /// or the values set do not match the parameters of the statement.
+    void add_batch();
+
+    /// \brief Binds a whole column of fixed-width values to the parameter, in place.
+    ///
+    /// Executed by execute_batch instead of rows added with add_batch. The values must
+    /// stay valid until then, and every parameter must be bound as a column.
+    /// \param index Parameter position (0-indexed).
+    /// \param nulls Null bitmap, bit (row % 8) of byte (row / 8) is set for NULL; may be nullptr.
+    /// \throws invalid_argument if rows differs from the columns bound before.
+    template <class T>
+    void bind_column(short index, const T* values, const uint8_t* nulls, size_t rows) {
+        columns_.bind(*this, index, values, nulls, rows);
+    }
+
+    /// \brief Binds a whole column of strings packed as UTF-16 code units to the parameter.
+    /// \param length Number of code units at data.
+    /// \param offsets rows + 1 offsets into data in code units.
+    /// \throws invalid_argument if the offsets decrease or end past length.
+    /// \see bind_column
+    void bind_string_column(short index, const nanodbc::string::value_type* data, size_t length, const int32_t* offsets,
+                            const uint8_t* nulls, size_t rows);
+
+    /// \brief Executes all rows of the batch, or of the bound columns, at once with SQL_ATTR_PARAMSET_SIZE.
+    ///
+    /// Afterwards the batch, the columns, the parameter values and the bindings are cleared.
+    /// \param timeout Query timeout in seconds.
+    /// \param row_counts Receives the row count of each row, filled also if the execution fails.
+    /// Rows of a multi-row array get BATCH_SUCCESS_NO_INFO unless the driver reports each row
+    /// with SQL_PARAM_ARRAY_ROW_COUNTS, as most give one total for the whole array.
+    /// \throws database_error
+    /// \throws logic_error if both batch rows and columns are present, or a parameter is not bound as a column.
+    void execute_batch(long timeout, std::vector<int>& row_counts);
+
+    /// \brief Removes the rows added to the batch and the bound columns.
+    void clear_batch();
+
+    /// \brief Returns the cache the statement is given back to when closed, nullptr if none.
+    std::shared_ptr<StatementCache> cache() const {
+        return cache_.lock();
+    }
+
+    const StatementCache::Key& cache_key() const {
+        return cache_key_;
+    }
+
+    /// \brief Makes the statement go back to the cache instead of being freed.
+    void attach_cache(std::weak_ptr<StatementCache> cache, StatementCache::Key key);
+
+    /// \brief Prepares the statement for its next user, keeping the prepared SQL.
+    ///
+    /// Closes the open cursor and clears the parameter bindings, values and batch.
+    /// \throws database_error
+    void recycle();
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <nanodbc/nanodbc.h>
+
+class Statement;
+
+/// \brief Prepared statements of a connection kept for reuse, least recently used first out.
+///
+/// A statement is keyed by its SQL text and the connection settings it was created with.
+/// Borrowing takes it out of the cache, so it serves one caller at a time, and giving it
+/// back closes its cursor and makes it the most recently used one. When more statements
+/// are given back than the capacity allows, the least recently used ones are freed.
+/// The statement keeps its prepared plan and parameter descriptions in between.
+class StatementCache : public std::enable_shared_from_this<StatementCache> {
+public:
+    /// \brief Identifies statements that can stand in for each other.
+    struct Key {
+        nanodbc::string sql;
+        bool wide_char_fetch = false;
+
+        bool operator==(const Key& other) const {
+            return wide_char_fetch == other.wide_char_fetch && sql == other.sql;
+        }
+    };
+
+    /// \brief Called with the SQL text of each statement freed to stay within the capacity.
+    using EvictionCallback = std::function<void(const nanodbc::string& sql)>;
+
+    /// \param capacity Number of idle statements kept.
+    explicit StatementCache(size_t capacity);
+
+    StatementCache(const StatementCache&) = delete;
+    StatementCache& operator=(const StatementCache&) = delete;
+
+    ~StatementCache();
+
+    /// \brief Takes an idle statement for the key out of the cache.
+    /// \return The statement, or nullptr if none is idle.
+    std::unique_ptr<Statement> borrow(const Key& key);
+
+    /// \brief Remembers that the statement is to be given back to this cache once closed.
+    void adopt(Statement& statement, const Key& key);
+
+    /// \brief Gives a statement borrowed or adopted from this cache back for reuse.
+    /// \throws database_error if its cursor cannot be closed; the statement is freed then.
+    void give_back(std::unique_ptr<Statement> statement);
+
+    /// \brief Gives the statement back to the cache it came from, or frees it if there is none.
+    static void release(Statement* statement);
+
+    /// \brief Changes the number of idle statements kept, freeing the surplus.
+    void set_capacity(size_t capacity);
+
+    size_t capacity() const;
+
+    /// \brief Number of idle statements.
+    size_t size() const;
+
+    void set_eviction_callback(EvictionCallback callback);
+
+    /// \brief Frees all idle statements without calling the eviction callback.
+    void clear();
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        std::unique_ptr<Statement> statement;
+    };
+
+    using Entries = std::list<Entry>;
+
+    /// Moves the entries beyond the capacity to evicted, the caller frees them unlocked.
+    void trim(Entries& evicted);
+
+    void evict(Entries& evicted);
+
+    mutable std::mutex mutex_;
+    size_t capacity_;
+    Entries entries_; // most recently used first
+    std::unordered_multimap<Key, Entries::iterator, KeyHash> index_;
+    EvictionCallback eviction_callback_;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// \brief Bump allocator for values handed out for the current row.
+///
+/// Memory is taken from blocks in order and released all at once by reset, which
+/// keeps the regular blocks for the next row and frees the ones made for large values.
+/// Destructors of objects created here are never run.
+class ValueArena {
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    ValueArena() = default;
+
+    ValueArena(const ValueArena&) = delete;
+    ValueArena& operator=(const ValueArena&) = delete;
+
+    /// \brief Returns uninitialized memory valid until the next reset.
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /// \brief Constructs an object in the arena; it must not own memory outside of it.
+    template <class T, class... Args>
+    T* create(Args&&... args) {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /// \brief Copies the string with a terminating zero into the arena.
+    template <class CharT>
+    CharT* copy_string(const CharT* src, size_t length) {
+        auto* copy = static_cast<CharT*>(allocate((length + 1) * sizeof(CharT), alignof(CharT)));
+        std::memcpy(copy, src, length * sizeof(CharT));
+        copy[length] = CharT();
+        return copy;
+    }
+
+    /// \brief Releases everything allocated so far.
+    void reset();
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    size_t current_ = 0;
+    size_t used_ = 0;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief Threads running blocking ODBC calls so that the caller's thread does not wait.
+///
+/// Tasks run in the order submitted, each on whichever worker is free.
+class WorkerPool {
+public:
+    /// \param threads Number of worker threads, at least one.
+    explicit WorkerPool(unsigned threads);
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// \brief Runs the queued tasks, then stops the workers.
+    ~WorkerPool();
+
+    /// \brief Queues the task. It must not throw.
+    void submit(std::function<void()> task);
+
+    /// \brief Returns the pool shared by the library, sized for slow I/O-bound calls.
+    static WorkerPool& shared();
+
+private:
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable queued_;
+    std::deque<std::function<void()>> tasks_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /// \brief Layout of the values buffer of a ColumnBatch column.
+    enum ColumnBatchType : int32_t {
+        COLUMN_BATCH_INT32 = 0,  ///< One int32_t per row.
+        COLUMN_BATCH_INT64 = 1,  ///< One int64_t per row.
+        COLUMN_BATCH_DOUBLE = 2, ///< One double per row.
+        COLUMN_BATCH_STRING = 3, ///< UTF-16 code units, addressed through byte offsets.
+        COLUMN_BATCH_BINARY = 4  ///< Raw bytes, addressed through byte offsets.
+    };
+
+    struct ColumnBatch {
+        /// \brief Contiguous buffers holding one column of the batch.
+        struct Column {
+            int32_t type = COLUMN_BATCH_STRING; ///< ColumnBatchType of the values buffer.
+            uint8_t* nulls = nullptr;           ///< Null bitmap, bit (row % 8) of byte (row / 8) is set for NULL.
+            uint8_t* values = nullptr;          ///< Fixed-width values, or variable-width data.
+            int32_t* offsets = nullptr;         ///< row_count + 1 byte offsets into values, variable-width types only.
+            int32_t data_length = 0;            ///< Bytes used in values.
+            int32_t data_capacity = 0;          ///< Bytes allocated for values.
+
+            Column() = default;
+            Column(const Column&) = delete;
+            Column& operator=(const Column&) = delete;
+            ~Column();
+
+            /// \brief Prepares the column for a new batch, keeping allocated buffers.
+            void reset(int32_t column_type, int32_t rows);
+
+            /// \brief Grows the null bitmap and offsets to hold rows entries.
+            void grow_rows(int32_t rows);
+
+            /// \brief Marks row as NULL.
+            void set_null(int32_t row);
+
+            /// \brief Stores a fixed-width value at row.
+            void put_fixed(int32_t row, const void* value, size_t size);
+
+            /// \brief Appends variable-width data for row.
+            void put_variable(int32_t row, const void* data, size_t size);
+
+            [[nodiscard]] bool is_variable_width() const;
+
+        private:
+            void reserve(size_t bytes);
+        };
+
+        int32_t column_count = 0;  ///< Number of columns.
+        int32_t row_count = 0;     ///< Number of rows filled by the last fetch.
+        int32_t row_capacity = 0;  ///< Rows the buffers hold without reallocation.
+        Column* columns = nullptr; ///< column_count column buffers.
+
+        ColumnBatch() = default;
+        ColumnBatch(const ColumnBatch&) = delete;
+        ColumnBatch& operator=(const ColumnBatch&) = delete;
+        ~ColumnBatch();
+
+        /// \brief Prepares the batch for up to rows rows of columns_count columns.
+        void reset(int32_t columns_count, int32_t rows);
+    };
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
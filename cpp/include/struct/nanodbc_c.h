@@ -79,6 +79,12 @@ extern "C" {
         explicit CTimestamp(const nanodbc::timestamp& other);
     };    
 
+    struct CDecimal {
+        uint64_t unscaled_low = 0; ///< Low 64 bits of the unscaled value.
+        int64_t unscaled_high = 0; ///< High 64 bits of the unscaled value, two's complement together with unscaled_low.
+        int32_t scale = 0;         ///< Value is unscaled * 10^-scale, negative for exponents.
+    };
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
\ No newline at end of file
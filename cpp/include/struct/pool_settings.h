@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /// \brief Settings of a connection pool, see pool_borrow.
+    struct PoolSettings {
+        int32_t min_size = 0;                 ///< Connections kept open even when idle.
+        int32_t max_size = 10;                ///< Connections open at most, idle or borrowed.
+        int64_t borrow_timeout_ms = 30000;    ///< Time to wait for a connection when max_size are borrowed.
+        int64_t idle_timeout_ms = 600000;     ///< Time after which an idle connection is closed, 0 for never.
+        int64_t max_lifetime_ms = 1800000;    ///< Age after which a connection is closed once idle, 0 for never.
+    };
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
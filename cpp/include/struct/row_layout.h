@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /// \brief Describes the packed rows produced by read_row.
+    ///
+    /// A packed row starts with a null bitmap of (column_count + 7) / 8 bytes,
+    /// bit (column % 8) of byte (column / 8) is set for NULL. It is followed by the
+    /// values of non-null columns in column order, unaligned and in native byte order:
+    /// int32_t, int64_t or double for fixed-width types, and an int32_t byte length
+    /// followed by the bytes for strings (UTF-16) and binary data.
+    struct RowLayout {
+        int32_t column_count = 0;  ///< Number of columns.
+        int32_t length = 0;        ///< Bytes of the last packed row.
+        int32_t* types = nullptr;  ///< ColumnBatchType of each column.
+        uint8_t* row = nullptr;    ///< Last packed row, kept until it has been copied out.
+        int32_t capacity = 0;      ///< Bytes allocated for row.
+        int32_t pending = 0;       ///< Non-zero if row did not fit the caller buffer yet.
+
+        RowLayout() = default;
+        RowLayout(const RowLayout&) = delete;
+        RowLayout& operator=(const RowLayout&) = delete;
+        ~RowLayout();
+
+        /// \brief Sets the column types, resetting the packed row.
+        void set_types(const int32_t* column_types, int32_t columns_count);
+
+        /// \brief Starts packing a new row with all columns marked non-null.
+        void begin_row();
+
+        /// \brief Marks column as NULL in the packed row.
+        void set_null(int32_t column);
+
+        /// \brief Appends a fixed-width value to the packed row.
+        void append(const void* value, size_t size);
+
+        /// \brief Appends a length-prefixed value to the packed row.
+        void append_prefixed(const void* data, size_t size);
+
+    private:
+        void reserve(size_t bytes);
+    };
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
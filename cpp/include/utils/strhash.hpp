@@ -23,4 +23,16 @@ constexpr auto hash_djb2a(const std::wstring_view sv) {
 
 constexpr auto operator"" _sh(const wchar_t* str, const size_t len) {
     return hash_djb2a(std::wstring_view{ str, len });
-}
\ No newline at end of file
+}
+
+constexpr auto hash_djb2a(const std::u16string_view sv) {
+    unsigned long hash{ 5381 };
+    for (const char16_t c : sv) {
+        hash = ((hash << 5) + hash) ^ static_cast<unsigned long>(c);
+    }
+    return hash;
+}
+
+constexpr auto operator"" _sh(const char16_t* str, const size_t len) {
+    return hash_djb2a(std::u16string_view{ str, len });
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+
+namespace utils::unicode {
+
+    // Code point limits
+    inline constexpr char32_t MAX_CODEPOINT        = 0x10FFFF;
+    inline constexpr char32_t BMP_MAX              = 0xFFFF;
+    inline constexpr char32_t SURROGATE_MIN        = 0xD800;
+    inline constexpr char32_t SURROGATE_MAX        = 0xDFFF;
+    inline constexpr char32_t REPLACEMENT_CHAR     = 0xFFFD;
+    inline constexpr char32_t ASTRAL_PLANE_START   = 0x10000;
+
+    // Surrogate encoding specifics
+    inline constexpr char16_t HIGH_SURROGATE_MIN   = 0xD800;
+    inline constexpr char16_t HIGH_SURROGATE_MAX   = 0xDBFF;
+    inline constexpr char16_t LOW_SURROGATE_MIN    = 0xDC00;
+    inline constexpr char16_t LOW_SURROGATE_MAX    = 0xDFFF;
+
+    inline constexpr char32_t SURROGATE_OFFSET     = ASTRAL_PLANE_START;  // 0x10000
+    inline constexpr char32_t HIGH_SURROGATE_BASE  = HIGH_SURROGATE_MIN;  // 0xD800
+    inline constexpr char32_t LOW_SURROGATE_BASE   = LOW_SURROGATE_MIN;   // 0xDC00
+    inline constexpr int      SURROGATE_SHIFT_BITS = 10;
+    inline constexpr char32_t SURROGATE_MASK       = 0x3FF;  // = 0b11'1111'1111
+
+}  // namespace utils::unicode
+
+namespace utils::utf {
+
+    /// \brief Instruction set the transcoder selected at startup.
+    enum class SimdLevel {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /// \brief Returns the instruction set used by the transcoding kernels.
+    SimdLevel simd_level();
+
+    /// \brief Transcodes UTF-8 to UTF-16, replacing every ill-formed subsequence with U+FFFD.
+    /// \param src UTF-8 input.
+    /// \param length Number of bytes in src.
+    /// \param dst Output buffer of at least length code units.
+    /// \return Number of code units written.
+    size_t utf8_to_utf16(const char* src, size_t length, char16_t* dst);
+
+    /// \brief Transcodes UTF-8 to UTF-32, replacing every ill-formed subsequence with U+FFFD.
+    /// \param src UTF-8 input.
+    /// \param length Number of bytes in src.
+    /// \param dst Output buffer of at least length code points.
+    /// \return Number of code points written.
+    size_t utf8_to_utf32(const char* src, size_t length, char32_t* dst);
+
+    /// \brief Transcodes UTF-16 to UTF-8, replacing unpaired surrogates with U+FFFD.
+    /// \param src UTF-16 input.
+    /// \param length Number of code units in src.
+    /// \param dst Output buffer of at least 3 * length bytes.
+    /// \return Number of bytes written.
+    size_t utf16_to_utf8(const char16_t* src, size_t length, char* dst);
+
+    /// \brief Transcodes UTF-32 to UTF-8, replacing surrogates and values above U+10FFFF with U+FFFD.
+    /// \param src UTF-32 input.
+    /// \param length Number of code points in src.
+    /// \param dst Output buffer of at least 4 * length bytes.
+    /// \return Number of bytes written.
+    size_t utf32_to_utf8(const char32_t* src, size_t length, char* dst);
+
+    /// \brief Returns the length of the longest prefix that does not end inside a multibyte sequence.
+    /// Used to carry an incomplete sequence at the end of a chunk over to the next one.
+    /// \param src UTF-8 input.
+    /// \param length Number of bytes in src.
+    size_t utf8_complete_length(const char* src, size_t length);
+
+} // namespace utils::utf
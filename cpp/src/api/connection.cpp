@@ -1,5 +1,12 @@
 #include "api/connection.h"
+#include "core/async_operations.hpp"
+#include "core/connection_pool.hpp"
+#include "core/statement.hpp"
+#include <algorithm>
+#include <chrono>
 #include <exception>
+#include <memory>
+#include <stdexcept>
 #include "utils/string_utils.hpp"
 #include "utils/logger.hpp"
 #include "utils/string_proxy.hpp"
@@ -55,7 +62,55 @@ Connection *connection_with_user_pass_timeout(const ApiChar *dsn, const ApiChar
     );
 }
 
-nanodbc::statement *create_statement(Connection *conn, NativeError *error) noexcept {
+Connection *pool_borrow(const ApiChar *connection_string, long timeout, const PoolSettings *settings,
+                        NativeError *error) noexcept {
+    StringProxy str_connection_string(connection_string);
+
+    LOG_DEBUG("Borrowing connection_string={}, timeout={}", str_connection_string, timeout);
+    return connection_with_error_handling(
+        [&] {
+            const PoolSettings defaults;
+            const PoolSettings &requested = settings ? *settings : defaults;
+            if (requested.min_size < 0 || requested.max_size < 0) {
+                throw invalid_argument("Pool size is negative");
+            }
+            ConnectionPool::Settings pool_settings;
+            pool_settings.min_size = static_cast<size_t>(requested.min_size);
+            pool_settings.max_size = static_cast<size_t>(requested.max_size);
+            pool_settings.borrow_timeout = chrono::milliseconds(max<int64_t>(requested.borrow_timeout_ms, 0));
+            pool_settings.idle_timeout = chrono::milliseconds(max<int64_t>(requested.idle_timeout_ms, 0));
+            pool_settings.max_lifetime = chrono::milliseconds(max<int64_t>(requested.max_lifetime_ms, 0));
+            pool_settings.login_timeout = timeout;
+
+            const auto pool = ConnectionPool::get(static_cast<nanodbc::string>(str_connection_string), pool_settings);
+            Connection *conn = pool->borrow().release();
+            LOG_DEBUG("Borrowed connection {}, pool size {}", reinterpret_cast<uintptr_t>(conn), pool->size());
+            return conn;
+        },
+        error
+    );
+}
+
+void pool_return(Connection *conn, NativeError *error) noexcept {
+    LOG_DEBUG("Returning connection: {}", reinterpret_cast<uintptr_t>(conn));
+    init_error(error);
+    try {
+        if (!conn) {
+            LOG_ERROR("Connection is null, cannot return it");
+            set_error(error, "Connection is null");
+            return;
+        }
+        ConnectionPool::release(conn);
+    } catch (const exception &e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception returning connection: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown connection error");
+        LOG_ERROR("Unknown exception returning connection");
+    }
+}
+
+Statement *create_statement(Connection *conn, NativeError *error) noexcept {
     LOG_DEBUG("Creating statement for connection: {}", reinterpret_cast<uintptr_t>(conn));
     init_error(error);
     try {
@@ -65,7 +120,7 @@ nanodbc::statement *create_statement(Connection *conn, NativeError *error) noexc
             return nullptr;
         }
 
-        auto stmt = new nanodbc::statement(*conn);
+        auto stmt = new Statement(*conn);
         LOG_DEBUG("Statement created successfully: {}", reinterpret_cast<uintptr_t>(stmt));
         return stmt;
     } catch (const exception &e) {
@@ -78,6 +133,94 @@ nanodbc::statement *create_statement(Connection *conn, NativeError *error) noexc
     return nullptr;
 }
 
+Statement *create_prepared_statement(Connection *conn, const ApiChar *sql, NativeError *error) noexcept {
+    LOG_DEBUG("Creating prepared statement for connection: {}", reinterpret_cast<uintptr_t>(conn));
+    init_error(error);
+    try {
+        if (!conn) {
+            LOG_ERROR("Connection is null, cannot create prepared statement");
+            set_error(error, "Connection is null");
+            return nullptr;
+        }
+
+        const StringProxy str_sql(sql);
+        Statement *stmt = conn->prepare_statement(static_cast<nanodbc::string>(str_sql));
+        LOG_DEBUG("Prepared statement created successfully: {}", reinterpret_cast<uintptr_t>(stmt));
+        return stmt;
+    } catch (const exception &e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in create_prepared_statement: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown create prepared statement error");
+        LOG_ERROR("Unknown exception in create_prepared_statement");
+    }
+    return nullptr;
+}
+
+void set_statement_cache_size(Connection *conn, int size, NativeError *error) noexcept {
+    LOG_DEBUG("Setting statement cache size {} for connection: {}", size, reinterpret_cast<uintptr_t>(conn));
+    init_error(error);
+    try {
+        if (!conn) {
+            LOG_ERROR("Connection is null, cannot set statement cache size");
+            set_error(error, "Connection is null");
+            return;
+        }
+        conn->set_statement_cache_size(static_cast<size_t>(std::max(size, 0)));
+    } catch (const exception &e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in set_statement_cache_size: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown set statement cache size error");
+        LOG_ERROR("Unknown exception in set_statement_cache_size");
+    }
+}
+
+int get_statement_cache_size(Connection *conn, NativeError *error) noexcept {
+    LOG_DEBUG("Getting statement cache size for connection: {}", reinterpret_cast<uintptr_t>(conn));
+    init_error(error);
+    try {
+        if (!conn) {
+            LOG_ERROR("Connection is null, cannot get statement cache size");
+            set_error(error, "Connection is null");
+            return 0;
+        }
+        return static_cast<int>(conn->get_statement_cache_size());
+    } catch (const exception &e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in get_statement_cache_size: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown get statement cache size error");
+        LOG_ERROR("Unknown exception in get_statement_cache_size");
+    }
+    return 0;
+}
+
+void set_statement_eviction_callback(Connection *conn, StatementEvictionCallback callback, void *context, NativeError *error) noexcept {
+    LOG_DEBUG("Setting statement eviction callback for connection: {}", reinterpret_cast<uintptr_t>(conn));
+    init_error(error);
+    try {
+        if (!conn) {
+            LOG_ERROR("Connection is null, cannot set statement eviction callback");
+            set_error(error, "Connection is null");
+            return;
+        }
+        if (!callback) {
+            conn->set_statement_eviction_callback(nullptr);
+            return;
+        }
+        conn->set_statement_eviction_callback([callback, context](const nanodbc::string &sql) {
+            callback(sql.c_str(), context);
+        });
+    } catch (const exception &e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in set_statement_eviction_callback: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown set statement eviction callback error");
+        LOG_ERROR("Unknown exception in set_statement_eviction_callback");
+    }
+}
+
 void set_auto_commit_transaction(Connection *conn, bool autoCommit, NativeError *error) noexcept {
     LOG_DEBUG("Checking connection: {}", reinterpret_cast<uintptr_t>(conn));
     init_error(error);
@@ -258,8 +401,53 @@ int get_transaction_isolation_level(Connection *conn, NativeError *error) noexce
     return 0;
 }
 
+void set_wide_char_fetch(Connection *conn, bool enabled, NativeError *error) noexcept {
+    LOG_DEBUG("Checking connection: {}", reinterpret_cast<uintptr_t>(conn));
+    init_error(error);
+    try {
+        if (!conn) {
+            LOG_ERROR("Connection is null, cannot set wide char fetch");
+            set_error(error, "Connection is null");
+            return;
+        }
+        conn->set_wide_char_fetch(enabled);
+        LOG_DEBUG("Wide char fetch: {}", enabled);
+    } catch (const exception &e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception during set wide char fetch: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown set wide char fetch error");
+        LOG_ERROR("Unknown exception during set wide char fetch");
+    }
+}
+
+bool get_wide_char_fetch(Connection *conn, NativeError *error) noexcept {
+    LOG_DEBUG("Checking connection: {}", reinterpret_cast<uintptr_t>(conn));
+    init_error(error);
+    try {
+        if (!conn) {
+            LOG_ERROR("Connection is null, cannot get wide char fetch");
+            set_error(error, "Connection is null");
+            return false;
+        }
+        return conn->get_wide_char_fetch();
+    } catch (const exception &e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception during get wide char fetch: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown get wide char fetch error");
+        LOG_ERROR("Unknown exception during get wide char fetch");
+    }
+    return false;
+}
+
 ResultSet *execute_request(Connection *conn, const ApiChar *sql, int timeout, NativeError *error) noexcept {
-    LOG_DEBUG("Executing request: {}", reinterpret_cast<uintptr_t>(conn));
+    return execute_request_with_fetch_size(conn, sql, timeout, BATCH_OPERATIONS, error);
+}
+
+ResultSet *execute_request_with_fetch_size(Connection *conn, const ApiChar *sql, int timeout, int fetch_size,
+                                           NativeError *error) noexcept {
+    LOG_DEBUG("Executing request: {}, fetch size: {}", reinterpret_cast<uintptr_t>(conn), fetch_size);
     init_error(error);
     try {
         if (!conn) {
@@ -270,11 +458,26 @@ ResultSet *execute_request(Connection *conn, const ApiChar *sql, int timeout, Na
 
         const StringProxy str_sql(sql);
 
+        if (conn->statement_cache()) {
+            // the result set keeps the statement until it is closed, then it goes back to the cache
+            std::shared_ptr<Statement> stmt(conn->prepare_statement(static_cast<nanodbc::string>(str_sql)), [](Statement *statement) {
+                try {
+                    StatementCache::release(statement);
+                } catch (const exception &e) {
+                    LOG_ERROR("Exception releasing cached statement: {}", StringProxy(e.what()));
+                }
+            });
+            stmt->just_execute(BATCH_OPERATIONS, timeout);
+            auto result_ptr = new ResultSet(ResultSet::open(*stmt, fetch_size, conn->get_wide_char_fetch()));
+            result_ptr->hold_statement(std::move(stmt));
+            LOG_DEBUG("Execute succeeded with cached statement, result: {}", reinterpret_cast<uintptr_t>(result_ptr));
+            return result_ptr;
+        }
+
         nanodbc::statement stmt(*conn);
         stmt.prepare(static_cast<const nanodbc::string>(str_sql));
-        auto result = stmt.execute(BATCH_OPERATIONS, timeout);
-        result.unbind();
-        auto result_ptr = new ResultSet(std::move(result));
+        stmt.just_execute(BATCH_OPERATIONS, timeout);
+        auto result_ptr = new ResultSet(ResultSet::open(stmt, fetch_size, conn->get_wide_char_fetch()));
         LOG_DEBUG("Execute succeeded, result: {}", reinterpret_cast<uintptr_t>(result_ptr));
         return result_ptr;
     } catch (const exception &e) {
@@ -287,6 +490,61 @@ ResultSet *execute_request(Connection *conn, const ApiChar *sql, int timeout, Na
     return nullptr;
 }
 
+AsyncExecution *execute_request_async(Connection *conn, const ApiChar *sql, int timeout, NativeError *error) noexcept {
+    LOG_DEBUG("Starting request: {}", reinterpret_cast<uintptr_t>(conn));
+    init_error(error);
+    try {
+        if (!conn) {
+            LOG_ERROR("Connection is null, cannot execute");
+            set_error(error, "Connection is null");
+            return nullptr;
+        }
+        const StringProxy str_sql(sql);
+        auto execution = AsyncExecution::start(*conn, static_cast<nanodbc::string>(str_sql), timeout).release();
+        LOG_DEBUG("Request started, polling: {}", execution->polling());
+        return execution;
+    } catch (const exception &e) {
+        set_error(error, e.what());
+        LOG_ERROR("Database error starting request: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown execute connection error");
+        LOG_ERROR("Unknown exception starting request");
+    }
+    return nullptr;
+}
+
+void execute_request_with_callback(Connection *conn, const ApiChar *sql, int timeout, int fetch_size,
+                                   ExecutionCallback callback, void *context, NativeError *error) noexcept {
+    LOG_DEBUG("Starting request with callback: {}", reinterpret_cast<uintptr_t>(conn));
+    init_error(error);
+    try {
+        if (!conn) {
+            LOG_ERROR("Connection is null, cannot execute");
+            set_error(error, "Connection is null");
+            return;
+        }
+        if (!callback) {
+            LOG_ERROR("Callback is null, cannot execute");
+            set_error(error, "Callback is null");
+            return;
+        }
+        const StringProxy str_sql(sql);
+        ExecuteAwaitable awaitable(*conn, static_cast<nanodbc::string>(str_sql), timeout, fetch_size, EventLoop::shared());
+        complete_execution(move(awaitable), [callback, context](ResultSet *result, const char *error_message) {
+            if (error_message) {
+                LOG_ERROR("Request with callback failed: {}", StringProxy(error_message));
+            }
+            callback(context, result, error_message);
+        });
+    } catch (const exception &e) {
+        set_error(error, e.what());
+        LOG_ERROR("Database error starting request: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown execute connection error");
+        LOG_ERROR("Unknown exception starting request");
+    }
+}
+
 void disconnect(Connection *connection, NativeError *error) noexcept {
     LOG_DEBUG("Disconnecting connection: {}", reinterpret_cast<uintptr_t>(connection));
     init_error(error);
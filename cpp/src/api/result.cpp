@@ -1,8 +1,15 @@
 #include "api/result.h"
+#include <cstring>
 #include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "utils/string_utils.hpp"
 #include "utils/logger.hpp"
 #include "utils/string_proxy.hpp"
+#include "core/arrow_stream.hpp"
+#include "core/async_operations.hpp"
 
 #ifdef _WIN32
 // needs to be included above sql.h for windows
@@ -16,9 +23,21 @@
 using namespace std;
 using namespace utils;
 
+template<typename T, typename... Args>
+static T* make_value(const ResultSet* results, Args&&... args) {
+    // with the value arena the value goes with the row instead of being freed by the caller
+    if (ValueArena* arena = results->value_arena()) {
+        return arena->create<T>(std::forward<Args>(args)...);
+    }
+    return new T(std::forward<Args>(args)...);
+}
+
 template<typename T>
-static T get_value_by_index(ResultSet* results, int index, NativeError* error, T fallback = T{}) noexcept {
+static T get_value_by_index(ResultSet* results, int index, NativeError* error, T fallback = T{}, bool* is_null = nullptr) noexcept {
     init_error(error);
+    if (is_null) {
+        *is_null = false;
+    }
     try {
         if (!results) {
             LOG_ERROR("Result is null");
@@ -31,6 +50,9 @@ static T get_value_by_index(ResultSet* results, int index, NativeError* error, T
         // for unbound columns, null indicator is determined by SQLGetData call
         if (results->is_null(static_cast<short>(index))) {
             LOG_DEBUG("Column is NULL, returning fallback");
+            if (is_null) {
+                *is_null = true;
+            }
             return fallback;
         }
         return value;
@@ -45,12 +67,12 @@ static T get_value_by_index(ResultSet* results, int index, NativeError* error, T
 }
 
 template<typename T>
-static T get_value_by_name(ResultSet* results, const StringProxy<ApiChar>& column_name, NativeError* error, T fallback = T{}) noexcept {
+static T get_value_by_name(ResultSet* results, const StringProxy<ApiChar>& column_name, NativeError* error, T fallback = T{}, bool* is_null = nullptr) noexcept {
     int index = find_column_by_name(results, column_name.c_str(), error);
     if (error && error->status) {
         return fallback;
     }
-    return get_value_by_index(results, index, error, fallback);
+    return get_value_by_index(results, index, error, fallback, is_null);
 }
 
 template<typename T>
@@ -83,6 +105,37 @@ bool next_result(ResultSet* results, NativeError* error) noexcept {
     error);
 }
 
+static DetachedTask report_next(ResultSet* results, FetchCallback callback, void* context) {
+    int has_row = -1;
+    string message;
+    try {
+        has_row = co_await results->fetch_async() ? 1 : 0;
+    } catch (const exception& e) {
+        message = e.what();
+        LOG_ERROR("Exception in next_with_callback: {}", StringProxy(e.what()));
+    } catch (...) {
+        message = "Unknown error";
+        LOG_ERROR("Unknown exception in next_with_callback");
+    }
+    callback(context, has_row, has_row < 0 ? message.c_str() : nullptr);
+}
+
+void next_with_callback(ResultSet* results, FetchCallback callback, void* context, NativeError* error) noexcept {
+    LOG_DEBUG("Calling next() with callback on result: {}", reinterpret_cast<uintptr_t>(results));
+    init_error(error);
+    if (!results) {
+        LOG_ERROR("Result is null, cannot fetch");
+        set_error(error, "Result is null");
+        return;
+    }
+    if (!callback) {
+        LOG_ERROR("Callback is null, cannot fetch");
+        set_error(error, "Callback is null");
+        return;
+    }
+    report_next(results, callback, context);
+}
+
 bool previous_result(ResultSet* results, NativeError* error) noexcept {
     LOG_DEBUG("Calling previous_result() on result: {}", reinterpret_cast<uintptr_t>(results));
     return execute_result_set_query<bool>(results, [](ResultSet* results) {
@@ -115,6 +168,14 @@ bool absolute_result(ResultSet* results, int row, NativeError* error) noexcept {
     error);
 }
 
+bool relative_result(ResultSet* results, int rows, NativeError* error) noexcept {
+    LOG_DEBUG("Calling relative_result() on result: {}", reinterpret_cast<uintptr_t>(results));
+    return execute_result_set_query<bool>(results, [rows](ResultSet* results) {
+        return results->skip(rows);
+    },
+    error);
+}
+
 int get_row_position_result(ResultSet* results, NativeError* error) noexcept {
     LOG_DEBUG("Calling get_row_result() on result: {}", reinterpret_cast<uintptr_t>(results));
     return execute_result_set_query<int>(results, [](const ResultSet* results) {
@@ -126,11 +187,217 @@ int get_row_position_result(ResultSet* results, NativeError* error) noexcept {
 int affected_rows_result(ResultSet* results, NativeError* error) noexcept {
     LOG_DEBUG("Calling get_row_position_result() on result: {}", reinterpret_cast<uintptr_t>(results));
     return execute_result_set_query<int>(results, [](const ResultSet* results) {
+        const auto cursor_lock = results->lock_cursor();
         return results->affected_rows();
     },
     error);
 }
 
+void enable_prefetch(ResultSet* results, int batch_rows, NativeError* error) noexcept {
+    LOG_DEBUG("Enabling prefetch of {} rows on result: {}", batch_rows, reinterpret_cast<uintptr_t>(results));
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return;
+        }
+        results->enable_prefetch(batch_rows);
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in enable_prefetch: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in enable_prefetch");
+    }
+}
+
+void enable_row_cache(ResultSet* results, int64_t memory_budget, NativeError* error) noexcept {
+    LOG_DEBUG("Enabling row cache of {} bytes on result: {}", memory_budget, reinterpret_cast<uintptr_t>(results));
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return;
+        }
+        if (memory_budget < 0) {
+            LOG_ERROR("Invalid memory budget: {}", memory_budget);
+            set_error(error, "Memory budget must not be negative");
+            return;
+        }
+        results->enable_row_cache(static_cast<size_t>(memory_budget));
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in enable_row_cache: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in enable_row_cache");
+    }
+}
+
+void enable_value_arena(ResultSet* results, NativeError* error) noexcept {
+    LOG_DEBUG("Enabling value arena on result: {}", reinterpret_cast<uintptr_t>(results));
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return;
+        }
+        results->enable_value_arena();
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in enable_value_arena: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in enable_value_arena");
+    }
+}
+
+ColumnBatch* create_column_batch(NativeError* error) noexcept {
+    init_error(error);
+    try {
+        auto batch = new ColumnBatch();
+        LOG_DEBUG("ColumnBatch created: {}", reinterpret_cast<uintptr_t>(batch));
+        return batch;
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in create_column_batch: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in create_column_batch");
+    }
+    return nullptr;
+}
+
+int fetch_batch(ResultSet* results, int max_rows, ColumnBatch* batch, NativeError* error) noexcept {
+    LOG_DEBUG("Fetching batch of {} rows from result: {}", max_rows, reinterpret_cast<uintptr_t>(results));
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return -1;
+        }
+        if (!batch) {
+            LOG_ERROR("ColumnBatch is null");
+            set_error(error, "ColumnBatch is null");
+            return -1;
+        }
+        if (max_rows <= 0) {
+            LOG_ERROR("Invalid batch size: {}", max_rows);
+            set_error(error, "Batch size must be positive");
+            return -1;
+        }
+
+        const int rows = results->fetch_batch(*batch, max_rows);
+        LOG_DEBUG("Fetched {} rows into batch", rows);
+        return rows;
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in fetch_batch: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in fetch_batch");
+    }
+    return -1;
+}
+
+RowLayout* create_row_layout(ResultSet* results, NativeError* error) noexcept {
+    LOG_DEBUG("Creating row layout for result: {}", reinterpret_cast<uintptr_t>(results));
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return nullptr;
+        }
+
+        const short columns = results->columns();
+        vector<int32_t> types(columns);
+        for (short column = 0; column < columns; ++column) {
+            types[column] = results->column_batch_type(column);
+        }
+        auto layout = new RowLayout();
+        layout->set_types(types.data(), columns);
+        LOG_DEBUG("RowLayout created: {}", reinterpret_cast<uintptr_t>(layout));
+        return layout;
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in create_row_layout: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in create_row_layout");
+    }
+    return nullptr;
+}
+
+int read_row(ResultSet* results, uint8_t* buffer, int capacity, RowLayout* layout, NativeError* error) noexcept {
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return -1;
+        }
+        if (!layout) {
+            LOG_ERROR("RowLayout is null");
+            set_error(error, "RowLayout is null");
+            return -1;
+        }
+
+        // a row that did not fit is kept for the retry, until the cursor moves
+        results->pack_row(*layout);
+        if (!buffer || layout->length > capacity) {
+            LOG_DEBUG("Packed row needs {} bytes, buffer has {}", layout->length, capacity);
+            layout->pending = 1;
+            return layout->length;
+        }
+        memcpy(buffer, layout->row, layout->length);
+        layout->pending = 0;
+        return layout->length;
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in read_row: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in read_row");
+    }
+    return -1;
+}
+
+void export_arrow_stream(ResultSet* results, int batch_size, ArrowArrayStream* stream, NativeError* error) noexcept {
+    LOG_DEBUG("Exporting result {} as Arrow stream, batch size: {}", reinterpret_cast<uintptr_t>(results), batch_size);
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return;
+        }
+        if (!stream) {
+            LOG_ERROR("ArrowArrayStream is null");
+            set_error(error, "ArrowArrayStream is null");
+            return;
+        }
+        if (batch_size <= 0) {
+            LOG_ERROR("Invalid batch size: {}", batch_size);
+            set_error(error, "Batch size must be positive");
+            return;
+        }
+
+        ArrowStream::export_stream(results, batch_size, stream);
+        LOG_DEBUG("Arrow stream exported");
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in export_arrow_stream: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in export_arrow_stream");
+    }
+}
+
 int get_int_value_by_index(ResultSet* results, int index, NativeError* error) noexcept {
     return get_value_by_index<int>(results, index, error, 0);
 }
@@ -156,6 +423,31 @@ short get_short_value_by_index(ResultSet* results, int index, NativeError* error
     return get_value_by_index<short>(results, index, error, 0);
 }
 
+int get_int_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept {
+    return get_value_by_index<int>(results, index, error, 0, is_null);
+}
+
+long get_long_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept {
+    return get_value_by_index<long>(results, index, error, 0L, is_null);
+}
+
+double get_double_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept {
+    return get_value_by_index<double>(results, index, error, 0.0, is_null);
+}
+
+bool get_bool_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept {
+    // result->get<bool>() does not work
+    return get_value_by_index<BOOL>(results, index, error, 0, is_null);
+}
+
+float get_float_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept {
+    return get_value_by_index<float>(results, index, error, 0.0f, is_null);
+}
+
+short get_short_value_nullable_by_index(ResultSet* results, int index, bool* is_null, NativeError* error) noexcept {
+    return get_value_by_index<short>(results, index, error, 0, is_null);
+}
+
 const ApiChar* get_string_value_by_index(const ResultSet* results, int index, NativeError* error) noexcept {
     LOG_DEBUG("Getting string value by index: {}", index);
     init_error(error);
@@ -175,6 +467,9 @@ const ApiChar* get_string_value_by_index(const ResultSet* results, int index, Na
         }
         LOG_DEBUG("String value retrieved from index {}: '{}'", index, result);
         const auto str_result = static_cast<ApiString> (result);
+        if (ValueArena* arena = results->value_arena()) {
+            return arena->copy_string(str_result.c_str(), str_result.length());
+        }
         return duplicate_string(str_result.c_str(), str_result.length());
     } catch (const exception& e) {
         set_error(error, e.what());
@@ -186,10 +481,66 @@ const ApiChar* get_string_value_by_index(const ResultSet* results, int index, Na
     return nullptr;
 }
 
+int get_string_into_by_index(ResultSet* results, int index, ApiChar* buffer, int capacity, NativeError* error) noexcept {
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return -2;
+        }
+
+        const ApiString* value = results->get_text(static_cast<short>(index));
+        if (!value) {
+            return -1;
+        }
+        const auto length = static_cast<int>(value->length());
+        if (buffer && length <= capacity) {
+            memcpy(buffer, value->data(), value->length() * sizeof(ApiChar));
+            if (length < capacity) {
+                buffer[length] = 0;
+            }
+        }
+        return length;
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in get_string_into_by_index {}: {}", index, StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in get_string_into_by_index {}", index);
+    }
+    return -2;
+}
+
+bool get_decimal_by_index(ResultSet* results, int index, CDecimal* value, NativeError* error) noexcept {
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return false;
+        }
+        if (!value) {
+            LOG_ERROR("Decimal is null");
+            set_error(error, "Decimal is null");
+            return false;
+        }
+        return results->get_decimal(static_cast<short>(index), *value);
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in get_decimal_by_index {}: {}", index, StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in get_decimal_by_index {}", index);
+    }
+    return false;
+}
+
 CDate* get_date_value_by_index(ResultSet* results, int index, NativeError* error) noexcept {
-    const auto date = get_value_by_index<nanodbc::date>(results, index, error);
+    bool is_null = false;
+    const auto date = get_value_by_index<nanodbc::date>(results, index, error, {}, &is_null);
 
-    if (was_null_by_index(results, index, error) || error && error->status) {
+    if (is_null || error && error->status) {
         LOG_DEBUG("Column '{}' is NULL", index);
         return nullptr;
     }
@@ -199,13 +550,14 @@ CDate* get_date_value_by_index(ResultSet* results, int index, NativeError* error
         return nullptr;
     }
 
-    return new CDate(date);
+    return make_value<CDate>(results, date);
 }
 
 CTime* get_time_value_by_index(ResultSet* results, int index, NativeError* error) noexcept {
-    const auto time = get_value_by_index<nanodbc::time>(results, index, error);
+    bool is_null = false;
+    const auto time = get_value_by_index<nanodbc::time>(results, index, error, {}, &is_null);
 
-    if (was_null_by_index(results, index, error) || error && error->status) {
+    if (is_null || error && error->status) {
         LOG_DEBUG("Column '{}' is NULL", index);
         return nullptr;
     }
@@ -215,13 +567,14 @@ CTime* get_time_value_by_index(ResultSet* results, int index, NativeError* error
         return nullptr;
     }
 
-    return new CTime(time);
+    return make_value<CTime>(results, time);
 }
 
 CTimestamp* get_timestamp_value_by_index(ResultSet* results, int index, NativeError* error) noexcept {
-    const auto ts = get_value_by_index<nanodbc::timestamp>(results, index, error);
+    bool is_null = false;
+    const auto ts = get_value_by_index<nanodbc::timestamp>(results, index, error, {}, &is_null);
 
-    if (was_null_by_index(results, index, error) || error && error->status) {
+    if (is_null || error && error->status) {
         LOG_DEBUG("Column '{}' is NULL", index);
         return nullptr;
     }
@@ -231,7 +584,7 @@ CTimestamp* get_timestamp_value_by_index(ResultSet* results, int index, NativeEr
         return nullptr;
     }
 
-    return new CTimestamp(ts);
+    return make_value<CTimestamp>(results, ts);
 }
 
 ChunkedBinaryStream* get_binary_stream_by_index(ResultSet* results, int index, NativeError* error) noexcept {
@@ -291,18 +644,85 @@ int read_binary_stream(ChunkedBinaryStream* stream, uint8_t* buffer, int offset,
     return -1;
 }
 
+ChunkedCharacterStream* get_character_stream_by_index(ResultSet* results, int index, NativeError* error) noexcept {
+    LOG_DEBUG("Getting character stream by index: {}", index);
+    init_error(error);
+    try {
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return nullptr;
+        }
+
+        // the first chunk is read here, an unbound column tells whether it is NULL only then
+        auto stream = make_unique<ChunkedCharacterStream>(results, index);
+        if (stream->is_null()) {
+            LOG_DEBUG("Column '{}' is NULL", index);
+            return nullptr;
+        }
+        LOG_DEBUG("Character stream ptr retrieved from index {}: '{}'", index, reinterpret_cast<uintptr_t>(stream.get()));
+        return stream.release();
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in get_character_stream_by_index {}: {}", index, StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in get_character_stream_by_index {}", index);
+    }
+    return nullptr;
+}
+
+int read_character_stream(ChunkedCharacterStream* stream, ApiChar* buffer, int offset, int length, NativeError* error) noexcept {
+    LOG_DEBUG("Reading character stream: {}", reinterpret_cast<uintptr_t>(stream));
+    init_error(error);
+    try {
+        if (!stream) {
+            set_error(error, "ChunkedCharacterStream is null");
+            return -1;
+        }
+        if (buffer == nullptr) {
+            set_error(error, "buffer is null");
+            return -1;
+        }
+        if (offset < 0 || length < 0) {
+            set_error(error, "Invalid offset or length");
+            return -1;
+        }
+        int result = stream->read(buffer, offset, length);
+        LOG_DEBUG("Reading {} chars", result);
+        return result;
+    } catch (const exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Exception in read_character_stream: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception");
+    }
+    return -1;
+}
+
 BinaryArray* get_bytes_array_by_index(ResultSet* results, int index, NativeError* error) noexcept {
+    LOG_DEBUG("Getting bytes array by index: {}", index);
+    init_error(error);
     try {
-        try {
-            // Try to get as binary data
-            const auto binary_data = results->get<vector<uint8_t>>(static_cast<short>(index));
-            return results->is_null(static_cast<short>(index)) ? nullptr : new BinaryArray(binary_data);
-        } catch (const nanodbc::type_incompatible_error&) {
-            // If not binary, try as string (for CLOB)
-            auto string_data = results->get<std::string>(static_cast<short>(index));
-            const vector<uint8_t> binary_data(string_data.begin(), string_data.end());
-            return results->is_null(static_cast<short>(index)) ? nullptr : new BinaryArray(binary_data);
+        if (!results) {
+            LOG_ERROR("Result is null");
+            set_error(error, "Result is null");
+            return nullptr;
+        }
+
+        if (ValueArena* arena = results->value_arena()) {
+            // the array and its bytes live in the arena and are never destroyed
+            auto* value = arena->create<BinaryArray>();
+            return results->get_bytes(static_cast<short>(index), *value) ? value : nullptr;
         }
+
+        auto value = make_unique<BinaryArray>();
+        if (!results->get_bytes(static_cast<short>(index), *value)) {
+            LOG_DEBUG("Column '{}' is NULL", index);
+            return nullptr;
+        }
+        return value.release();
     } catch (const exception& e) {
         set_error(error, e.what());
         LOG_ERROR("Exception in get_bytes_array_by_index {}: {}", index, StringProxy(e.what()));
@@ -377,12 +797,9 @@ const ApiChar* get_string_value_by_name(ResultSet* results, const ApiChar* name,
 
 CDate* get_date_value_by_name(ResultSet* results, const ApiChar* name, NativeError* error) noexcept {
     const StringProxy str_name (name);
-    auto date = get_value_by_name<nanodbc::date>(results, str_name, error, {});
-    if (error && error->status) {
-        return nullptr;
-    }
-
-    if (was_null_by_name(results, name, error) || error && error->status) {
+    bool is_null = false;
+    auto date = get_value_by_name<nanodbc::date>(results, str_name, error, {}, &is_null);
+    if (is_null || error && error->status) {
         LOG_DEBUG("Column '{}' is NULL", str_name);
         return nullptr;
     }
@@ -392,18 +809,14 @@ CDate* get_date_value_by_name(ResultSet* results, const ApiChar* name, NativeErr
         return nullptr;
     }
 
-    return new CDate(date);
+    return make_value<CDate>(results, date);
 }
 
 CTime* get_time_value_by_name(ResultSet* results, const ApiChar* name, NativeError* error) noexcept {
     const StringProxy str_name (name);
-    const auto time = get_value_by_name<nanodbc::time>(results, str_name, error, {});
-
-    if (error && error->status) {
-        return nullptr;
-    }
-
-    if (was_null_by_name(results, name, error) || error && error->status) {
+    bool is_null = false;
+    const auto time = get_value_by_name<nanodbc::time>(results, str_name, error, {}, &is_null);
+    if (is_null || error && error->status) {
         LOG_DEBUG("Column '{}' is NULL", str_name);
         return nullptr;
     }
@@ -413,17 +826,14 @@ CTime* get_time_value_by_name(ResultSet* results, const ApiChar* name, NativeErr
         return nullptr;
     }
 
-    return new CTime(time);
+    return make_value<CTime>(results, time);
 }
 
 CTimestamp* get_timestamp_value_by_name(ResultSet* results, const ApiChar* name, NativeError* error) noexcept {
     const StringProxy str_name (name);
-    const auto ts = get_value_by_name<nanodbc::timestamp>(results, str_name, error, {});
-    if (error && error->status) {
-        return nullptr;
-    }
-
-    if (was_null_by_name(results, name, error) || error && error->status) {
+    bool is_null = false;
+    auto ts = get_value_by_name<nanodbc::timestamp>(results, str_name, error, {}, &is_null);
+    if (is_null || error && error->status) {
         LOG_DEBUG("Column '{}' is NULL", str_name);
         return nullptr;
     }
@@ -433,7 +843,7 @@ CTimestamp* get_timestamp_value_by_name(ResultSet* results, const ApiChar* name,
         return nullptr;
     }
 
-    return new CTimestamp(ts);
+    return make_value<CTimestamp>(results, ts);
 }
 
 BinaryArray* get_bytes_array_by_name(ResultSet* results, const ApiChar* name, NativeError* error) noexcept {
@@ -452,6 +862,14 @@ ChunkedBinaryStream* get_binary_stream_by_name(ResultSet* results, const ApiChar
     return get_binary_stream_by_index(results, index, error);
 }
 
+ChunkedCharacterStream* get_character_stream_by_name(ResultSet* results, const ApiChar* name, NativeError* error) noexcept {
+    int index = find_column_by_name(results, name, error);
+    if (error && error->status) {
+        return nullptr;
+    }
+    return get_character_stream_by_index(results, index, error);
+}
+
 int find_column_by_name(ResultSet* results, const ApiChar* name, NativeError* error) noexcept {
     LOG_DEBUG("Closing result: {}", reinterpret_cast<uintptr_t>(results));
     const StringProxy str_name (name);
@@ -461,7 +879,7 @@ int find_column_by_name(ResultSet* results, const ApiChar* name, NativeError* er
             LOG_ERROR("Attempted to close null result");
             return 0;
         }
-        int index = results->column(static_cast<nanodbc::string>(str_name));
+        int index = results->find_column(static_cast<nanodbc::string>(str_name));
         LOG_DEBUG("Index retrieved by name '{}': '{}'", str_name, index);
         return index;
     } catch (const std::exception& e) {
@@ -483,7 +901,7 @@ bool was_null_by_name(ResultSet* results, const ApiChar* name, NativeError* erro
             LOG_ERROR("Attempted to close null result");
             return true;
         }
-        bool is_null = results->is_null(static_cast<nanodbc::string>(str_name));
+        bool is_null = results->is_null(results->find_column(static_cast<nanodbc::string>(str_name)));
         LOG_DEBUG("Index was null '{}': '{}'", str_name, is_null);
         return is_null;
     } catch (const std::exception& e) {
@@ -547,6 +965,8 @@ void close_result(ResultSet* results, NativeError* error) noexcept {
             LOG_ERROR("Attempted to close null result");
             return;
         }
+        // a statement borrowed from the cache is given back only once the cursor is gone
+        const std::shared_ptr<void> statement = results->release_statement();
         delete results;
         LOG_DEBUG("Result successfully closed and deleted");
     } catch (const exception& e) {
@@ -590,10 +1010,34 @@ void delete_timestamp(CTimestamp* timestamp) noexcept {
     }
 }
 
+void delete_column_batch(ColumnBatch* batch) noexcept {
+    LOG_DEBUG("Deleting ColumnBatch object: {}", reinterpret_cast<uintptr_t>(batch));
+    if (batch) {
+        delete batch;
+        LOG_DEBUG("ColumnBatch deleted");
+    }
+}
+
+void delete_row_layout(RowLayout* layout) noexcept {
+    LOG_DEBUG("Deleting RowLayout object: {}", reinterpret_cast<uintptr_t>(layout));
+    if (layout) {
+        delete layout;
+        LOG_DEBUG("RowLayout deleted");
+    }
+}
+
 void close_binary_stream(ChunkedBinaryStream* stream) noexcept {
     LOG_DEBUG("Deleting ChunkedBinaryStream object: {}", reinterpret_cast<uintptr_t>(stream));
     if (stream) {
         delete stream;
         LOG_DEBUG("ChunkedBinaryStream deleted");
     }
+}
+
+void close_character_stream(ChunkedCharacterStream* stream) noexcept {
+    LOG_DEBUG("Deleting ChunkedCharacterStream object: {}", reinterpret_cast<uintptr_t>(stream));
+    if (stream) {
+        delete stream;
+        LOG_DEBUG("ChunkedCharacterStream deleted");
+    }
 }
\ No newline at end of file
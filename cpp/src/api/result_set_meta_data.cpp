@@ -12,6 +12,7 @@ CResultSetMetaData* get_meta_data(ResultSet* results, NativeError* error) noexce
 			return nullptr;
 		}
 
+		const auto cursor_lock = results->lock_cursor();
 		const ResultSetMetaData result_set_meta_data(*results);
 		auto meta_data = new CResultSetMetaData(result_set_meta_data);
 		LOG_DEBUG("Metadata created successfully: columns count = {}", meta_data->columnCount);
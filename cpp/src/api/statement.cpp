@@ -1,4 +1,12 @@
 #include "api/statement.h"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "core/async_operations.hpp"
+#include "core/statement.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/logger.hpp"
 #include "utils/string_proxy.hpp"
@@ -17,10 +25,10 @@ using namespace utils;
 #define BATCH_OPERATIONS 1
 
 template<typename T>
-static void set_value_with_error_handling(nanodbc::statement* stmt, int index, const T& value, NativeError* error) noexcept {
+static void set_value_with_error_handling(Statement* stmt, int index, const T& value, NativeError* error) noexcept {
     init_error(error);
-    try {        
-        stmt->bind(index, &value);
+    try {
+        stmt->set_parameter(static_cast<short>(index), value);
     } catch (const std::exception& e) {
         set_error(error, e.what());
         LOG_ERROR("Standard exception in set_value: {}", StringProxy(e.what()));
@@ -30,13 +38,11 @@ static void set_value_with_error_handling(nanodbc::statement* stmt, int index, c
     }
 }
 
-static void set_value_with_error_handling(nanodbc::statement* stmt, int index, const StringProxy<ApiChar> & value, NativeError* error) noexcept {
+static void set_value_with_error_handling(Statement* stmt, int index, const ApiChar* value, NativeError* error) noexcept {
+    static_assert(std::is_same_v<ApiChar, nanodbc::string::value_type>, "strings are bound without conversion");
     init_error(error);
     try {
-        // Wrap a single string in a vector
-        std::vector<nanodbc::string> vec;
-        vec.emplace_back(value);
-        stmt->bind_strings(static_cast<short>(index), vec);
+        stmt->set_string_parameter(static_cast<short>(index), value, std::char_traits<ApiChar>::length(value));
     } catch (const std::exception& e) {
         set_error(error, e.what());
         LOG_ERROR("Standard exception (String {}", StringProxy(e.what()));
@@ -46,10 +52,10 @@ static void set_value_with_error_handling(nanodbc::statement* stmt, int index, c
     }
 }
 
-static void set_value_with_error_handling(nanodbc::statement* stmt, int index, nullptr_t, NativeError* error) noexcept {
+static void set_value_with_error_handling(Statement* stmt, int index, nullptr_t, NativeError* error) noexcept {
     init_error(error);
     try {
-        stmt->bind_null(static_cast<short>(index));
+        stmt->set_null_parameter(static_cast<short>(index));
     } catch (const std::exception& e) {
         set_error(error, e.what());
         LOG_ERROR("Standard exception (NULL): {}", StringProxy(e.what()));
@@ -59,7 +65,7 @@ static void set_value_with_error_handling(nanodbc::statement* stmt, int index, n
     }
 }
 
-void prepare_statement(nanodbc::statement* stmt, const ApiChar* sql, NativeError* error) noexcept {
+void prepare_statement(Statement* stmt, const ApiChar* sql, NativeError* error) noexcept {
     const StringProxy str_sql (sql);
     init_error(error);
 
@@ -72,7 +78,7 @@ void prepare_statement(nanodbc::statement* stmt, const ApiChar* sql, NativeError
             set_error(error, "Statement is null");
             return;
         }
-        nanodbc::prepare(*stmt, static_cast<nanodbc::string>(str_sql));
+        stmt->prepare(static_cast<nanodbc::string>(str_sql));
     } catch (const std::exception& e) {
         set_error(error, e.what());
         LOG_ERROR("Standard exception during prepare: {}", StringProxy( e.what()));
@@ -82,41 +88,40 @@ void prepare_statement(nanodbc::statement* stmt, const ApiChar* sql, NativeError
     }
 }
 
-void set_int_value(nanodbc::statement* stmt, int index, int value, NativeError* error) noexcept {
+void set_int_value(Statement* stmt, int index, int value, NativeError* error) noexcept {
     set_value_with_error_handling(stmt, index, value, error);
 }
 
-void set_long_value(nanodbc::statement* stmt, int index, long value, NativeError* error) noexcept {
-    set_value_with_error_handling(stmt, index, value, error);
+void set_long_value(Statement* stmt, int index, long long value, NativeError* error) noexcept {
+    set_value_with_error_handling(stmt, index, static_cast<int64_t>(value), error);
 }
 
-void set_double_value(nanodbc::statement* stmt, int index, double value, NativeError* error) noexcept {
+void set_double_value(Statement* stmt, int index, double value, NativeError* error) noexcept {
     set_value_with_error_handling(stmt, index, value, error);
 }
 
-void set_bool_value(nanodbc::statement* stmt, int index, bool value, NativeError* error) noexcept {
+void set_bool_value(Statement* stmt, int index, bool value, NativeError* error) noexcept {
     // bool type is not supported by nanodbc
     set_value_with_error_handling<BOOL>(stmt, index, value, error);
 }
 
-void set_float_value(nanodbc::statement* stmt, int index, float value, NativeError* error) noexcept {
+void set_float_value(Statement* stmt, int index, float value, NativeError* error) noexcept {
     set_value_with_error_handling(stmt, index, value, error);
 }
 
-void set_short_value(nanodbc::statement* stmt, int index, short value, NativeError* error) noexcept {
+void set_short_value(Statement* stmt, int index, short value, NativeError* error) noexcept {
     set_value_with_error_handling(stmt, index, value, error);
 }
 
-void set_string_value(nanodbc::statement* stmt, int index, const ApiChar* value, NativeError* error) noexcept {
+void set_string_value(Statement* stmt, int index, const ApiChar* value, NativeError* error) noexcept {
     if (!value) {
         set_value_with_error_handling(stmt, index, nullptr, error);
         return;
     }
-    const StringProxy str_value (value);
-    set_value_with_error_handling(stmt, index, str_value, error);
+    set_value_with_error_handling(stmt, index, value, error);
 }
 
-void set_date_value(nanodbc::statement* stmt, int index, CDate* value, NativeError* error) noexcept {
+void set_date_value(Statement* stmt, int index, CDate* value, NativeError* error) noexcept {
     if (!value) {
         set_value_with_error_handling(stmt, index, nullptr, error);
         return;
@@ -130,7 +135,7 @@ void set_date_value(nanodbc::statement* stmt, int index, CDate* value, NativeErr
     set_value_with_error_handling(stmt, index, d, error);
 }
 
-void set_time_value(nanodbc::statement* stmt, int index, CTime* value, NativeError* error) noexcept {
+void set_time_value(Statement* stmt, int index, CTime* value, NativeError* error) noexcept {
     if (!value) {
         set_value_with_error_handling(stmt, index, nullptr, error);
         return;
@@ -144,7 +149,7 @@ void set_time_value(nanodbc::statement* stmt, int index, CTime* value, NativeErr
     set_value_with_error_handling(stmt, index, t, error);
 }
 
-void set_timestamp_value(nanodbc::statement* stmt, int index, CTimestamp* value, NativeError* error) noexcept {
+void set_timestamp_value(Statement* stmt, int index, CTimestamp* value, NativeError* error) noexcept {
     if (!value) {
         set_value_with_error_handling(stmt, index, nullptr, error);
         return;
@@ -162,7 +167,7 @@ void set_timestamp_value(nanodbc::statement* stmt, int index, CTimestamp* value,
     set_value_with_error_handling(stmt, index, ts, error);
 }
 
-void set_binary_array_value(nanodbc::statement* stmt, int index, BinaryArray* value, NativeError* error) noexcept {
+void set_binary_array_value(Statement* stmt, int index, BinaryArray* value, NativeError* error) noexcept {
     if (!value) {
         set_value_with_error_handling(stmt, index, nullptr, error);
         return;
@@ -170,15 +175,8 @@ void set_binary_array_value(nanodbc::statement* stmt, int index, BinaryArray* va
 
     init_error(error);
     try {
-        std::vector<uint8_t> data = value->to_vector();
-        if (data.empty()) {
-            const std::vector<std::vector<uint8_t>> empty_batch;
-            stmt->bind(static_cast<short>(index), empty_batch);
-        } else {
-            std::vector<std::vector<uint8_t>> batch;
-            batch.push_back(data);
-            stmt->bind(static_cast<short>(index), batch);
-        }
+        stmt->set_binary_parameter(static_cast<short>(index), reinterpret_cast<const uint8_t*>(value->data),
+                                                            static_cast<size_t>(std::max(value->length, 0)));
     } catch (const std::exception& e) {
         set_error(error, e.what());
         LOG_ERROR("Exception in set_binary_array_value: {}", StringProxy(e.what()));
@@ -188,8 +186,108 @@ void set_binary_array_value(nanodbc::statement* stmt, int index, BinaryArray* va
     }
 }
 
-ResultSet* execute(nanodbc::statement* stmt, int timeout, NativeError* error) noexcept {
-    LOG_DEBUG("Executing statement: {}", reinterpret_cast<uintptr_t>(stmt));
+static void set_stream_with_error_handling(Statement* stmt, int index, bool character,
+                                           ParameterBuffers::StreamReader reader, long long length, NativeError* error) noexcept {
+    LOG_DEBUG("Binding {} stream of length {} to parameter {}", character ? "character" : "binary", length, index);
+    init_error(error);
+    try {
+        if (!stmt) {
+            LOG_ERROR("Statement is null, cannot bind stream");
+            set_error(error, "Statement is null");
+            return;
+        }
+        if (!reader) {
+            stmt->set_null_parameter(static_cast<short>(index));
+            return;
+        }
+        stmt->set_stream_parameter(static_cast<short>(index), character, std::move(reader), length);
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Standard exception in set_stream: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in set_stream");
+    }
+}
+
+void set_binary_stream_value(Statement* stmt, int index, BinaryStreamReader reader, void* context, long long length, NativeError* error) noexcept {
+    ParameterBuffers::StreamReader read;
+    if (reader) {
+        read = [reader, context](void* buffer, int capacity) {
+            return reader(context, static_cast<uint8_t*>(buffer), capacity);
+        };
+    }
+    set_stream_with_error_handling(stmt, index, false, std::move(read), length, error);
+}
+
+void set_character_stream_value(Statement* stmt, int index, CharacterStreamReader reader, void* context, long long length, NativeError* error) noexcept {
+    ParameterBuffers::StreamReader read;
+    if (reader) {
+        read = [reader, context](void* buffer, int capacity) {
+            return reader(context, static_cast<ApiChar*>(buffer), capacity);
+        };
+    }
+    set_stream_with_error_handling(stmt, index, true, std::move(read), length, error);
+}
+
+template<typename T>
+static void set_column_with_error_handling(Statement* stmt, int index, const T* values, const uint8_t* nulls, int rows, NativeError* error) noexcept {
+    LOG_DEBUG("Binding column of {} rows to parameter {}", rows, index);
+    init_error(error);
+    try {
+        if (!stmt || !values) {
+            LOG_ERROR("Statement or values are null");
+            set_error(error, "Statement or values are null");
+            return;
+        }
+        stmt->bind_column(static_cast<short>(index), values, nulls, static_cast<size_t>(std::max(rows, 0)));
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Standard exception in set_column: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error");
+        LOG_ERROR("Unknown exception in set_column");
+    }
+}
+
+void set_int_column(Statement* stmt, int index, const int32_t* values, const uint8_t* nulls, int rows, NativeError* error) noexcept {
+    set_column_with_error_handling(stmt, index, values, nulls, rows, error);
+}
+
+void set_long_column(Statement* stmt, int index, const int64_t* values, const uint8_t* nulls, int rows, NativeError* error) noexcept {
+    set_column_with_error_handling(stmt, index, values, nulls, rows, error);
+}
+
+void set_double_column(Statement* stmt, int index, const double* values, const uint8_t* nulls, int rows, NativeError* error) noexcept {
+    set_column_with_error_handling(stmt, index, values, nulls, rows, error);
+}
+
+void set_string_column(Statement* stmt, int index, const ApiChar* data, int length, const int32_t* offsets, const uint8_t* nulls, int rows, NativeError* error) noexcept {
+    LOG_DEBUG("Binding string column of {} rows to parameter {}", rows, index);
+    init_error(error);
+    try {
+        if (!stmt || !data || !offsets) {
+            LOG_ERROR("Statement, data or offsets are null");
+            set_error(error, "Statement, data or offsets are null");
+            return;
+        }
+        stmt->bind_string_column(static_cast<short>(index), data, static_cast<size_t>(std::max(length, 0)), offsets, nulls,
+                                 static_cast<size_t>(std::max(rows, 0)));
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Standard exception in set_string_column: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown error setting string column");
+        LOG_ERROR("Unknown exception in set_string_column");
+    }
+}
+
+ResultSet* execute(Statement* stmt, int timeout, NativeError* error) noexcept {
+    return execute_with_fetch_size(stmt, timeout, BATCH_OPERATIONS, error);
+}
+
+ResultSet* execute_with_fetch_size(Statement* stmt, int timeout, int fetch_size, NativeError* error) noexcept {
+    LOG_DEBUG("Executing statement: {}, fetch size: {}", reinterpret_cast<uintptr_t>(stmt), fetch_size);
     init_error(error);
     try {
         if (!stmt) {
@@ -197,9 +295,9 @@ ResultSet* execute(nanodbc::statement* stmt, int timeout, NativeError* error) no
             set_error(error, "Statement is null");
             return nullptr;
         }
-        auto results = stmt->execute(BATCH_OPERATIONS, timeout);
-        results.unbind();
-        auto result_ptr = new ResultSet(std::move(results));
+        stmt->execute_once(timeout);
+        const bool wide_char_fetch = stmt->get_wide_char_fetch();
+        auto result_ptr = new ResultSet(ResultSet::open(*stmt, fetch_size, wide_char_fetch));
         LOG_DEBUG("Execute succeeded, result: {}", reinterpret_cast<uintptr_t>(result_ptr));
         return result_ptr;
     } catch (const std::exception& e) {
@@ -212,7 +310,219 @@ ResultSet* execute(nanodbc::statement* stmt, int timeout, NativeError* error) no
     return nullptr;
 }
 
-void cancel_statement(nanodbc::statement* stmt, NativeError* error) noexcept {
+AsyncExecution* execute_async(Statement* stmt, int timeout, NativeError* error) noexcept {
+    LOG_DEBUG("Starting execution: {}", reinterpret_cast<uintptr_t>(stmt));
+    init_error(error);
+    try {
+        if (!stmt) {
+            LOG_ERROR("Statement is null, cannot execute");
+            set_error(error, "Statement is null");
+            return nullptr;
+        }
+        auto execution = AsyncExecution::start(*stmt, timeout).release();
+        LOG_DEBUG("Execution started, polling: {}", execution->polling());
+        return execution;
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Database error starting execution: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown execute statement error");
+        LOG_ERROR("Unknown exception starting execution");
+    }
+    return nullptr;
+}
+
+void execute_with_callback(Statement* stmt, int timeout, int fetch_size, ExecutionCallback callback, void* context,
+                           NativeError* error) noexcept {
+    LOG_DEBUG("Starting execution with callback: {}", reinterpret_cast<uintptr_t>(stmt));
+    init_error(error);
+    try {
+        if (!stmt) {
+            LOG_ERROR("Statement is null, cannot execute");
+            set_error(error, "Statement is null");
+            return;
+        }
+        if (!callback) {
+            LOG_ERROR("Callback is null, cannot execute");
+            set_error(error, "Callback is null");
+            return;
+        }
+        ExecuteAwaitable awaitable(*stmt, timeout, fetch_size, EventLoop::shared());
+        complete_execution(std::move(awaitable), [callback, context](ResultSet* result, const char* error_message) {
+            if (error_message) {
+                LOG_ERROR("Execution with callback failed: {}", StringProxy(error_message));
+            }
+            callback(context, result, error_message);
+        });
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Database error starting execution: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown execute statement error");
+        LOG_ERROR("Unknown exception starting execution");
+    }
+}
+
+int poll_execution(AsyncExecution* execution, NativeError* error) noexcept {
+    init_error(error);
+    try {
+        if (!execution) {
+            LOG_ERROR("Execution is null, cannot poll");
+            set_error(error, "Execution is null");
+            return -1;
+        }
+        return execution->poll() ? 1 : 0;
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Standard exception during poll_execution: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown poll execution error");
+        LOG_ERROR("Unknown exception during poll_execution");
+    }
+    return -1;
+}
+
+int wait_for_execution(AsyncExecution* execution, int timeout_millis, NativeError* error) noexcept {
+    init_error(error);
+    try {
+        if (!execution) {
+            LOG_ERROR("Execution is null, cannot wait");
+            set_error(error, "Execution is null");
+            return -1;
+        }
+        return execution->wait_for(std::chrono::milliseconds(std::max(timeout_millis, 0))) ? 1 : 0;
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Standard exception during wait_for_execution: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown wait for execution error");
+        LOG_ERROR("Unknown exception during wait_for_execution");
+    }
+    return -1;
+}
+
+void cancel_execution(AsyncExecution* execution, NativeError* error) noexcept {
+    LOG_DEBUG("Cancel execution: {}", reinterpret_cast<uintptr_t>(execution));
+    init_error(error);
+    try {
+        if (!execution) {
+            LOG_ERROR("Execution is null, cannot cancel");
+            set_error(error, "Execution is null");
+            return;
+        }
+        execution->cancel();
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Standard exception during cancel_execution: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown cancel execution error");
+        LOG_ERROR("Unknown exception during cancel_execution");
+    }
+}
+
+ResultSet* execution_result(AsyncExecution* execution, int fetch_size, NativeError* error) noexcept {
+    LOG_DEBUG("Opening result of execution: {}, fetch size: {}", reinterpret_cast<uintptr_t>(execution), fetch_size);
+    init_error(error);
+    try {
+        if (!execution) {
+            LOG_ERROR("Execution is null, cannot open result");
+            set_error(error, "Execution is null");
+            return nullptr;
+        }
+        Statement& stmt = execution->statement();
+        auto result_ptr = new ResultSet(ResultSet::open(stmt, fetch_size, stmt.get_wide_char_fetch()));
+        LOG_DEBUG("Execution result: {}", reinterpret_cast<uintptr_t>(result_ptr));
+        return result_ptr;
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Database error during execution: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown execution result error");
+        LOG_ERROR("Unknown exception opening execution result");
+    }
+    return nullptr;
+}
+
+void close_execution(AsyncExecution* execution, NativeError* error) noexcept {
+    LOG_DEBUG("Closing execution: {}", reinterpret_cast<uintptr_t>(execution));
+    init_error(error);
+    try {
+        delete execution;
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Standard exception during close_execution: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown close execution error");
+        LOG_ERROR("Unknown exception during close_execution");
+    }
+}
+
+void add_batch(Statement* stmt, NativeError* error) noexcept {
+    LOG_DEBUG("Adding batch row: {}", reinterpret_cast<uintptr_t>(stmt));
+    init_error(error);
+    try {
+        if (!stmt) {
+            LOG_ERROR("Statement is null, cannot add batch");
+            set_error(error, "Statement is null");
+            return;
+        }
+        stmt->add_batch();
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Standard exception during add_batch: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown add batch error");
+        LOG_ERROR("Unknown exception during add_batch");
+    }
+}
+
+int execute_batch(Statement* stmt, int timeout, int* row_counts, int capacity, NativeError* error) noexcept {
+    LOG_DEBUG("Executing batch: {}", reinterpret_cast<uintptr_t>(stmt));
+    init_error(error);
+    std::vector<int> counts;
+    try {
+        if (!stmt) {
+            LOG_ERROR("Statement is null, cannot execute batch");
+            set_error(error, "Statement is null");
+            return -1;
+        }
+        stmt->execute_batch(timeout, counts);
+        LOG_DEBUG("Batch of {} rows executed", counts.size());
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Database error during execute_batch: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown execute batch error");
+        LOG_ERROR("Unknown exception during execute_batch");
+    }
+    // the counts tell which rows failed, so they are returned with the error
+    if (row_counts) {
+        const size_t copied = std::min(counts.size(), static_cast<size_t>(std::max(capacity, 0)));
+        std::copy_n(counts.begin(), copied, row_counts);
+    }
+    return counts.empty() && error && error->status ? -1 : static_cast<int>(counts.size());
+}
+
+void clear_batch(Statement* stmt, NativeError* error) noexcept {
+    LOG_DEBUG("Clearing batch: {}", reinterpret_cast<uintptr_t>(stmt));
+    init_error(error);
+    try {
+        if (!stmt) {
+            LOG_ERROR("Statement is null, cannot clear batch");
+            set_error(error, "Statement is null");
+            return;
+        }
+        stmt->clear_batch();
+    } catch (const std::exception& e) {
+        set_error(error, e.what());
+        LOG_ERROR("Standard exception during clear_batch: {}", StringProxy(e.what()));
+    } catch (...) {
+        set_error(error, "Unknown clear batch error");
+        LOG_ERROR("Unknown exception during clear_batch");
+    }
+}
+
+void cancel_statement(Statement* stmt, NativeError* error) noexcept {
     LOG_DEBUG("Cancel statement: {}", reinterpret_cast<uintptr_t>(stmt));
     init_error(error);
     try {
@@ -231,7 +541,7 @@ void cancel_statement(nanodbc::statement* stmt, NativeError* error) noexcept {
     }
 }
 
-void close_statement(nanodbc::statement* stmt, NativeError* error) noexcept {
+void close_statement(Statement* stmt, NativeError* error) noexcept {
     LOG_DEBUG("Closing statement: {}", reinterpret_cast<uintptr_t>(stmt));
     init_error(error);
     try {
@@ -239,10 +549,9 @@ void close_statement(nanodbc::statement* stmt, NativeError* error) noexcept {
             LOG_ERROR("Attempted to close null statement");
             return;
         }
-        stmt->close();
-        LOG_DEBUG("Statement closed, now deleting object");
-        delete stmt;
-        LOG_DEBUG("Statement successfully closed and deleted");
+        // a cached statement goes back to its connection's cache instead
+        StatementCache::release(stmt);
+        LOG_DEBUG("Statement successfully closed");
     } catch (const std::exception& e) {
         set_error(error, e.what());
         LOG_ERROR("Standard exception during close_statement: {}", StringProxy(e.what()));
@@ -0,0 +1,265 @@
+#include "core/arrow_stream.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include "api/api.h"
+#include "utils/string_utils.hpp"
+
+using namespace std;
+
+namespace {
+
+    struct SchemaData {
+        string format;
+        string name;
+        vector<ArrowSchema*> children;
+    };
+
+    struct ArrayData {
+        vector<const void*> buffers;
+        vector<ArrowArray*> children;
+    };
+
+    void release_schema(ArrowSchema* schema) {
+        if (!schema || !schema->release) {
+            return;
+        }
+        auto* data = static_cast<SchemaData*>(schema->private_data);
+        for (auto* child : data->children) {
+            if (child->release) {
+                child->release(child);
+            }
+            delete child;
+        }
+        delete data;
+        schema->release = nullptr;
+    }
+
+    void release_array(ArrowArray* array) {
+        if (!array || !array->release) {
+            return;
+        }
+        auto* data = static_cast<ArrayData*>(array->private_data);
+        for (auto* child : data->children) {
+            if (child->release) {
+                child->release(child);
+            }
+            delete child;
+        }
+        for (const void* buffer : data->buffers) {
+            free(const_cast<void*>(buffer));
+        }
+        delete data;
+        array->release = nullptr;
+    }
+
+    SchemaData* init_schema(ArrowSchema* out, string format, string name, int64_t flags) {
+        auto* data = new SchemaData{std::move(format), std::move(name), {}};
+        *out = ArrowSchema{};
+        out->format = data->format.c_str();
+        out->name = data->name.c_str();
+        out->flags = flags;
+        out->release = release_schema;
+        out->private_data = data;
+        return data;
+    }
+
+    ArrayData* init_array(ArrowArray* out, int64_t length) {
+        auto* data = new ArrayData();
+        *out = ArrowArray{};
+        out->length = length;
+        out->release = release_array;
+        out->private_data = data;
+        return data;
+    }
+
+    void sync_array(ArrowArray* out, ArrayData* data) {
+        out->n_buffers = static_cast<int64_t>(data->buffers.size());
+        out->buffers = data->buffers.data();
+        out->n_children = static_cast<int64_t>(data->children.size());
+        out->children = data->children.empty() ? nullptr : data->children.data();
+    }
+
+    template <typename T>
+    T* take(T*& buffer) {
+        T* taken = buffer;
+        buffer = nullptr;
+        return taken;
+    }
+
+    const char* arrow_format(int32_t type) {
+        switch (type) {
+            case COLUMN_BATCH_INT32:
+                return "i";
+            case COLUMN_BATCH_INT64:
+                return "l";
+            case COLUMN_BATCH_DOUBLE:
+                return "g";
+            case COLUMN_BATCH_BINARY:
+                return "z";
+            default:
+                return "u";
+        }
+    }
+
+    /// Turns the null bitmap of the column into an Arrow validity bitmap.
+    const void* take_validity(ColumnBatch::Column& column, int32_t rows, int64_t& null_count) {
+        null_count = 0;
+        for (int32_t row = 0; row < rows; ++row) {
+            null_count += (column.nulls[row >> 3] >> (row & 7)) & 1;
+        }
+        if (null_count == 0) {
+            return nullptr;
+        }
+        for (int32_t i = 0; i < (rows + 7) / 8; ++i) {
+            column.nulls[i] = static_cast<uint8_t>(~column.nulls[i]);
+        }
+        return take(column.nulls);
+    }
+
+    /// Transcodes UTF-16 text of the column into UTF-8 offsets and data buffers.
+    void transcode_strings(const ColumnBatch::Column& column, int32_t rows, ArrayData* data) {
+        string utf8;
+        auto* offsets = static_cast<int32_t*>(malloc((static_cast<size_t>(rows) + 1) * sizeof(int32_t)));
+        if (!offsets) {
+            throw bad_alloc();
+        }
+        data->buffers.push_back(offsets);
+        offsets[0] = 0;
+        for (int32_t row = 0; row < rows; ++row) {
+            const auto* begin = reinterpret_cast<const ApiChar*>(column.values + column.offsets[row]);
+            const auto* end = reinterpret_cast<const ApiChar*>(column.values + column.offsets[row + 1]);
+            if (begin != end) {
+                utf8 += utils::to_string(ApiString(begin, end));
+            }
+            offsets[row + 1] = static_cast<int32_t>(utf8.size());
+        }
+
+        void* values = nullptr;
+        if (!utf8.empty()) {
+            values = malloc(utf8.size());
+            if (!values) {
+                throw bad_alloc();
+            }
+            memcpy(values, utf8.data(), utf8.size());
+        }
+        data->buffers.push_back(values);
+    }
+
+    void export_column(ColumnBatch::Column& column, int32_t rows, ArrowArray* out) {
+        ArrayData* data = init_array(out, rows);
+        data->buffers.push_back(take_validity(column, rows, out->null_count));
+        switch (column.type) {
+            case COLUMN_BATCH_INT32:
+            case COLUMN_BATCH_INT64:
+            case COLUMN_BATCH_DOUBLE:
+                data->buffers.push_back(take(column.values));
+                break;
+            case COLUMN_BATCH_BINARY:
+                data->buffers.push_back(take(column.offsets));
+                data->buffers.push_back(take(column.values));
+                break;
+            default:
+                transcode_strings(column, rows, data);
+                break;
+        }
+        sync_array(out, data);
+    }
+}
+
+ArrowStream::ArrowStream(ResultSet* rs, int batch_size)
+    : rs_(rs)
+    , batch_size_(batch_size) {
+    const short columns = rs_->columns();
+    types_.reserve(columns);
+    names_.reserve(columns);
+    for (short column = 0; column < columns; ++column) {
+        types_.push_back(rs_->column_batch_type(column));
+        names_.push_back(static_cast<string>(StringProxy(rs_->map_column_name(rs_->column_name(column), column))));
+    }
+}
+
+void ArrowStream::export_stream(ResultSet* rs, int batch_size, ArrowArrayStream* out) {
+    auto* stream = new ArrowStream(rs, batch_size);
+    out->get_schema = get_schema_callback;
+    out->get_next = get_next_callback;
+    out->get_last_error = get_last_error_callback;
+    out->release = release_callback;
+    out->private_data = stream;
+}
+
+void ArrowStream::get_schema(ArrowSchema* out) const {
+    SchemaData* data = init_schema(out, "+s", "", 0);
+    try {
+        for (size_t column = 0; column < types_.size(); ++column) {
+            data->children.push_back(new ArrowSchema{});
+            init_schema(data->children.back(), arrow_format(types_[column]), names_[column], ARROW_FLAG_NULLABLE);
+        }
+    } catch (...) {
+        out->n_children = static_cast<int64_t>(data->children.size());
+        release_schema(out);
+        throw;
+    }
+    out->n_children = static_cast<int64_t>(data->children.size());
+    out->children = data->children.empty() ? nullptr : data->children.data();
+}
+
+void ArrowStream::get_next(ArrowArray* out) const {
+    ColumnBatch batch;
+    const int rows = rs_->fetch_batch(batch, batch_size_);
+    if (rows == 0) {
+        // end of stream is signalled by a released array
+        *out = ArrowArray{};
+        return;
+    }
+
+    ArrayData* data = init_array(out, rows);
+    data->buffers.push_back(nullptr);
+    try {
+        for (int32_t column = 0; column < batch.column_count; ++column) {
+            data->children.push_back(new ArrowArray{});
+            export_column(batch.columns[column], rows, data->children.back());
+        }
+    } catch (...) {
+        release_array(out);
+        throw;
+    }
+    sync_array(out, data);
+}
+
+int ArrowStream::get_schema_callback(ArrowArrayStream* stream, ArrowSchema* out) {
+    auto* self = static_cast<ArrowStream*>(stream->private_data);
+    try {
+        self->get_schema(out);
+        return 0;
+    } catch (const exception& e) {
+        self->last_error_ = e.what();
+    } catch (...) {
+        self->last_error_ = "Unknown error";
+    }
+    return EIO;
+}
+
+int ArrowStream::get_next_callback(ArrowArrayStream* stream, ArrowArray* out) {
+    auto* self = static_cast<ArrowStream*>(stream->private_data);
+    try {
+        self->get_next(out);
+        return 0;
+    } catch (const exception& e) {
+        self->last_error_ = e.what();
+    } catch (...) {
+        self->last_error_ = "Unknown error";
+    }
+    return EIO;
+}
+
+const char* ArrowStream::get_last_error_callback(ArrowArrayStream* stream) {
+    const auto* self = static_cast<ArrowStream*>(stream->private_data);
+    return self->last_error_.empty() ? nullptr : self->last_error_.c_str();
+}
+
+void ArrowStream::release_callback(ArrowArrayStream* stream) {
+    delete static_cast<ArrowStream*>(stream->private_data);
+    stream->private_data = nullptr;
+    stream->release = nullptr;
+}
@@ -0,0 +1,224 @@
+#include "core/async_execution.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "core/worker_pool.hpp"
+
+#ifdef _WIN32
+// needs to be included above sql.h for windows
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include <sqlext.h>
+#include "core/nanodbc_defs.h"
+
+namespace {
+    constexpr std::chrono::milliseconds MIN_POLL_PAUSE{1};
+    constexpr std::chrono::milliseconds MAX_POLL_PAUSE{50};
+
+    bool executes_asynchronously(nanodbc::statement& statement) {
+        SQLUINTEGER mode = SQL_AM_NONE;
+        const SQLRETURN rc = SQLGetInfo(statement.connection().native_dbc_handle(), SQL_ASYNC_MODE, &mode, sizeof(mode), nullptr);
+        // with SQL_AM_CONNECTION every statement of the connection would turn asynchronous
+        return SQL_SUCCEEDED(rc) && mode == SQL_AM_STATEMENT;
+    }
+}
+
+/// State the worker thread shares with the execution.
+struct AsyncExecution::Shared {
+    mutable std::mutex mutex;
+    std::condition_variable finished;
+    Status status = Status::Running;
+    std::exception_ptr error;
+    bool cancel_requested = false;
+    std::function<void()> on_finished;
+
+    void complete(std::exception_ptr failure) {
+        std::function<void()> callback;
+        {
+            std::lock_guard lock(mutex);
+            if (!failure) {
+                status = Status::Succeeded;
+            } else {
+                status = cancel_requested ? Status::Cancelled : Status::Failed;
+            }
+            error = std::move(failure);
+            callback = std::move(on_finished);
+        }
+        finished.notify_all();
+        if (callback) {
+            callback();
+        }
+    }
+};
+
+std::unique_ptr<AsyncExecution> AsyncExecution::start(Statement& statement, long timeout) {
+    std::unique_ptr<AsyncExecution> execution(new AsyncExecution(statement, nullptr, timeout));
+    execution->begin();
+    return execution;
+}
+
+std::unique_ptr<AsyncExecution> AsyncExecution::start(Connection& connection, const nanodbc::string& sql, long timeout) {
+    auto statement = std::make_unique<Statement>(connection);
+    statement->prepare(sql);
+    Statement& prepared = *statement;
+    std::unique_ptr<AsyncExecution> execution(new AsyncExecution(prepared, std::move(statement), timeout));
+    execution->begin();
+    return execution;
+}
+
+AsyncExecution::AsyncExecution(Statement& statement, std::unique_ptr<Statement> owned, long timeout)
+    : owned_(std::move(owned))
+    , statement_(statement)
+    , timeout_(timeout)
+    , shared_(std::make_shared<Shared>()) {
+}
+
+AsyncExecution::~AsyncExecution() {
+    if (status() != Status::Running) {
+        return;
+    }
+    cancel();
+    if (polling_) {
+        // the driver stops soon after SQLCancel, but only reports it when polled
+        while (!advance()) {
+            std::this_thread::sleep_for(MIN_POLL_PAUSE);
+        }
+        return;
+    }
+    std::unique_lock lock(shared_->mutex);
+    shared_->finished.wait(lock, [this] {
+        return shared_->status != Status::Running;
+    });
+}
+
+bool AsyncExecution::poll() {
+    if (status() != Status::Running) {
+        return true;
+    }
+    return polling_ && advance();
+}
+
+bool AsyncExecution::wait_for(std::chrono::milliseconds timeout) {
+    if (!polling_) {
+        std::unique_lock lock(shared_->mutex);
+        return shared_->finished.wait_for(lock, timeout, [this] {
+            return shared_->status != Status::Running;
+        });
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::chrono::milliseconds pause = MIN_POLL_PAUSE;
+    while (!poll()) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(pause, deadline - now));
+        pause = std::min(pause * 2, MAX_POLL_PAUSE);
+    }
+    return true;
+}
+
+void AsyncExecution::cancel() {
+    {
+        std::lock_guard lock(shared_->mutex);
+        if (shared_->status != Status::Running) {
+            return;
+        }
+        shared_->cancel_requested = true;
+    }
+    // a queued execution notices the request before it starts, a running one fails with HY008
+    SQLCancel(statement_.native_statement_handle());
+}
+
+void AsyncExecution::when_finished(std::function<void()> callback) {
+    {
+        std::lock_guard lock(shared_->mutex);
+        if (shared_->status == Status::Running) {
+            shared_->on_finished = std::move(callback);
+            return;
+        }
+    }
+    callback();
+}
+
+AsyncExecution::Status AsyncExecution::status() const {
+    std::lock_guard lock(shared_->mutex);
+    return shared_->status;
+}
+
+Statement& AsyncExecution::statement() {
+    std::lock_guard lock(shared_->mutex);
+    switch (shared_->status) {
+        case Status::Running:
+            throw std::logic_error("Execution has not finished");
+        case Status::Cancelled:
+            throw std::runtime_error("Execution was cancelled");
+        case Status::Failed:
+            std::rethrow_exception(shared_->error);
+        default:
+            return statement_;
+    }
+}
+
+void AsyncExecution::begin() {
+    const HSTMT handle = statement_.native_statement_handle();
+    if (!statement_.has_stream_parameters() && executes_asynchronously(statement_)) {
+        statement_.timeout(timeout_);
+        SQLSetStmtAttr(handle, SQL_ATTR_PARAMSET_SIZE, reinterpret_cast<SQLPOINTER>(1), 0);
+        polling_ = SQL_SUCCEEDED(SQLSetStmtAttr(handle, SQL_ATTR_ASYNC_ENABLE,
+                                                reinterpret_cast<SQLPOINTER>(SQL_ASYNC_ENABLE_ON), 0));
+    }
+    if (polling_) {
+        advance();
+        return;
+    }
+
+    // the execution waits for the task in its destructor, so the statement outlives it
+    WorkerPool::shared().submit([shared = shared_, statement = &statement_, timeout = timeout_] {
+        bool cancelled = false;
+        {
+            std::lock_guard lock(shared->mutex);
+            cancelled = shared->cancel_requested;
+        }
+        std::exception_ptr failure;
+        try {
+            if (cancelled) {
+                throw std::runtime_error("Execution was cancelled");
+            }
+            statement->execute_once(timeout);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        shared->complete(std::move(failure));
+    });
+}
+
+bool AsyncExecution::advance() {
+    const HSTMT handle = statement_.native_statement_handle();
+    const SQLRETURN rc = SQLExecute(handle);
+    if (rc == SQL_STILL_EXECUTING) {
+        return false;
+    }
+
+    std::exception_ptr failure;
+    if (!SQL_SUCCEEDED(rc) && rc != SQL_NO_DATA) {
+        // read the diagnostics before setting the attribute clears them
+        try {
+            NANODBC_THROW_DATABASE_ERROR(handle, SQL_HANDLE_STMT);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+    }
+    SQLSetStmtAttr(handle, SQL_ATTR_ASYNC_ENABLE, reinterpret_cast<SQLPOINTER>(SQL_ASYNC_ENABLE_OFF), 0);
+    shared_->complete(std::move(failure));
+    return true;
+}
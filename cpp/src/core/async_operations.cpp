@@ -0,0 +1,90 @@
+#include "core/async_operations.hpp"
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "core/worker_pool.hpp"
+
+ExecuteAwaitable::ExecuteAwaitable(Connection& connection, nanodbc::string sql, long timeout, long fetch_size, EventLoop& loop)
+    : connection_(&connection)
+    , statement_(nullptr)
+    , sql_(std::move(sql))
+    , timeout_(timeout)
+    , fetch_size_(fetch_size)
+    , loop_(&loop) {
+}
+
+ExecuteAwaitable::ExecuteAwaitable(Statement& statement, long timeout, long fetch_size, EventLoop& loop)
+    : connection_(nullptr)
+    , statement_(&statement)
+    , timeout_(timeout)
+    , fetch_size_(fetch_size)
+    , loop_(&loop) {
+}
+
+bool ExecuteAwaitable::await_ready() {
+    execution_ = statement_ ? AsyncExecution::start(*statement_, timeout_) : AsyncExecution::start(*connection_, sql_, timeout_);
+    return execution_->status() != AsyncExecution::Status::Running;
+}
+
+void ExecuteAwaitable::await_suspend(std::coroutine_handle<> handle) {
+    const auto resume = [handle] {
+        handle.resume();
+    };
+    if (execution_->polling()) {
+        AsyncExecution* execution = execution_.get();
+        loop_->watch([execution] {
+            return execution->poll();
+        }, resume);
+        return;
+    }
+    // worker executions report back themselves, the loop need not poll them
+    execution_->when_finished([loop = loop_, resume] {
+        loop->post(resume);
+    });
+}
+
+ResultSet ExecuteAwaitable::await_resume() {
+    Statement& statement = execution_->statement();
+    // a statement of its own lives on in the result set
+    return ResultSet::open(statement, fetch_size_, statement.get_wide_char_fetch());
+}
+
+FetchAwaitable::FetchAwaitable(ResultSet& result, EventLoop& loop)
+    : result_(&result)
+    , loop_(&loop) {
+}
+
+void FetchAwaitable::await_suspend(std::coroutine_handle<> handle) {
+    WorkerPool::shared().submit([this, handle] {
+        try {
+            row_ = result_->next();
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+        // posting orders these writes before the resumed coroutine reads them
+        loop_->post([handle] {
+            handle.resume();
+        });
+    });
+}
+
+bool FetchAwaitable::await_resume() {
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    return row_;
+}
+
+DetachedTask complete_execution(ExecuteAwaitable awaitable, std::function<void(ResultSet* result, const char* error_message)> callback) {
+    ResultSet* result = nullptr;
+    std::string message;
+    try {
+        ResultSet opened = co_await awaitable;
+        result = new ResultSet(std::move(opened));
+    } catch (const std::exception& e) {
+        message = e.what();
+    } catch (...) {
+        message = "Unknown execution error";
+    }
+    callback(result, result ? nullptr : message.c_str());
+}
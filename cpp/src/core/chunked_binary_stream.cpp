@@ -1,4 +1,6 @@
 #include "core/chunked_binary_stream.hpp"
+#include <algorithm>
+#include <cstring>
 
 #ifdef _WIN32
 // needs to be included above sql.h for windows
@@ -11,73 +13,101 @@
 #include <sql.h>
 #include "core/nanodbc_defs.h"
 
-ChunkedBinaryStream::ChunkedBinaryStream(nanodbc::result* rs, int column_index)
+ChunkedBinaryStream::ChunkedBinaryStream(ResultSet* rs, int column_index)
     : rs_(rs)
     , column_index_(column_index)
+    , buffer_length_(0)
     , position_(0)
-    , eof_(false) {
+    , chunk_size_(MIN_CHUNK_SIZE)
+    , exhausted_(false) {
 }
 
 int ChunkedBinaryStream::read(uint8_t* output_buffer, size_t offset, size_t length) {
-    if (eof_) return -1;
-
     size_t total_read = 0;
 
-    while (total_read < length && !eof_) {
-        if (position_ >= buffer_.size() && !read_next_chunk()) {
-            if (!read_next_chunk()) {
-                eof_ = true;
-                break;
-            }
-        }
-
-        size_t available = buffer_.size() - position_;
-        size_t to_copy = std::min(length - total_read, available);
-
-        if (to_copy > 0) {
-            std::memcpy(output_buffer + offset + total_read,
-                buffer_.data() + position_,
-                to_copy);
-
+    while (total_read < length) {
+        if (position_ < buffer_length_) {
+            const size_t to_copy = std::min(length - total_read, buffer_length_ - position_);
+            std::memcpy(output_buffer + offset + total_read, buffer_.data() + position_, to_copy);
             position_ += to_copy;
             total_read += to_copy;
+            continue;
+        }
+        if (exhausted_) {
+            break;
+        }
+
+        const size_t remaining = length - total_read;
+        if (remaining >= MIN_CHUNK_SIZE && reads_in_place()) {
+            // large requests skip the intermediate copy
+            total_read += fetch(output_buffer + offset + total_read, remaining);
+        } else {
+            refill();
         }
     }
 
     return total_read > 0 ? static_cast<int>(total_read) : -1;
 }
 
-bool ChunkedBinaryStream::read_next_chunk() {
-    SQLLEN indicator = 0;
-    buffer_.resize(DEFAULT_CHUNK_SIZE);
+bool ChunkedBinaryStream::reads_in_place() const {
+    const auto column = static_cast<short>(column_index_);
+    // Block cursors keep the value in the bound row array, SQLGetData is not allowed there;
+    // a buffered value is already in memory and the cursor has moved past it
+    return !rs_->is_bound(column) && !rs_->is_buffered();
+}
+
+void ChunkedBinaryStream::refill() {
+    position_ = 0;
+    buffer_length_ = 0;
+    if (!reads_in_place()) {
+        buffer_ = rs_->get<std::vector<uint8_t>>(static_cast<short>(column_index_), {});
+        buffer_length_ = buffer_.size();
+        exhausted_ = true;
+        return;
+    }
 
-    SQLRETURN rc = SQLGetData(
+    if (buffer_.size() < chunk_size_) {
+        buffer_.resize(chunk_size_);
+    }
+    buffer_length_ = fetch(buffer_.data(), chunk_size_);
+}
+
+size_t ChunkedBinaryStream::fetch(uint8_t* target, size_t capacity) {
+    SQLLEN indicator = 0;
+    const SQLRETURN rc = SQLGetData(
         rs_->native_statement_handle(),
         static_cast<SQLUSMALLINT>(column_index_ + 1), // ODBC uses 1-based indexing
         SQL_C_BINARY,
-        buffer_.data(),
-        buffer_.size(),
+        target,
+        static_cast<SQLLEN>(capacity),
         &indicator
     );
 
-    if (SQL_SUCCEEDED(rc)) {
-        if (indicator == SQL_NULL_DATA) {
-            buffer_.clear();
-            return false;
-        } else if (indicator == SQL_NO_TOTAL || indicator > buffer_.size()) {
-            // Data didn't fit completely
-            buffer_.resize(buffer_.size());
-        } else {
-            // All data received
-            buffer_.resize(indicator);
-            eof_ = true;
-        }
-        position_ = 0;
-        return true;
-    } else if (rc == SQL_NO_DATA) {
-        buffer_.clear();
-        return false;
-    } else {
+    if (rc == SQL_NO_DATA) {
+        exhausted_ = true;
+        return 0;
+    }
+    if (!SQL_SUCCEEDED(rc)) {
         throw nanodbc::database_error(rs_->native_statement_handle(), SQL_HANDLE_STMT);
     }
-}
\ No newline at end of file
+    if (indicator == SQL_NULL_DATA) {
+        exhausted_ = true;
+        return 0;
+    }
+
+    if (indicator == SQL_NO_TOTAL) {
+        // the driver does not know the length, so the value is assumed to go on
+        chunk_size_ = std::min(chunk_size_ * 2, MAX_CHUNK_SIZE);
+        return capacity;
+    }
+    if (static_cast<size_t>(indicator) > capacity) {
+        // indicator is the length left before this call, the next chunk needs no more than the rest
+        const size_t rest = static_cast<size_t>(indicator) - capacity;
+        chunk_size_ = std::clamp(std::min(chunk_size_ * 2, rest), MIN_CHUNK_SIZE, MAX_CHUNK_SIZE);
+        return capacity;
+    }
+
+    // all data received
+    exhausted_ = true;
+    return static_cast<size_t>(indicator);
+}
@@ -0,0 +1,151 @@
+#include "core/chunked_character_stream.hpp"
+#include <algorithm>
+#include <cstring>
+#include "utils/utf_transcoder.hpp"
+
+#ifdef _WIN32
+// needs to be included above sql.h for windows
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include <sqlext.h>
+#include <sql.h>
+#include "core/nanodbc_defs.h"
+
+ChunkedCharacterStream::ChunkedCharacterStream(ResultSet* rs, int column_index)
+    : rs_(rs)
+    , column_index_(column_index)
+    , narrow_type_(SQL_C_CHAR)
+    , wide_(rs->wide_char_fetch())
+    , carried_(0)
+    , decoded_length_(0)
+    , position_(0)
+    , chunk_size_(MIN_CHUNK_SIZE)
+    , exhausted_(false)
+    , null_(false) {
+    const ColumnDescriptor& descriptor = rs_->descriptor(static_cast<short>(column_index_));
+    if (descriptor.c_type == SQL_C_BINARY) {
+        narrow_type_ = SQL_C_BINARY;
+        wide_ = false;
+    } else {
+#ifdef _WIN32
+        wide_ = true;
+#endif
+    }
+    refill();
+}
+
+int ChunkedCharacterStream::read(ApiChar* output_buffer, size_t offset, size_t length) {
+    size_t total_read = 0;
+
+    while (total_read < length) {
+        if (position_ < decoded_length_) {
+            const size_t to_copy = std::min(length - total_read, decoded_length_ - position_);
+            std::memcpy(output_buffer + offset + total_read, decoded_.data() + position_, to_copy * sizeof(ApiChar));
+            position_ += to_copy;
+            total_read += to_copy;
+            continue;
+        }
+        if (exhausted_) {
+            break;
+        }
+
+        const size_t remaining = length - total_read;
+        if (wide_ && remaining * sizeof(ApiChar) >= MIN_CHUNK_SIZE && reads_in_place()) {
+            // large requests skip the intermediate copy, the last unit receives the terminator
+            total_read += fetch(output_buffer + offset + total_read, remaining * sizeof(ApiChar), SQL_C_WCHAR, sizeof(ApiChar)) / sizeof(ApiChar);
+        } else {
+            refill();
+        }
+    }
+
+    return total_read > 0 ? static_cast<int>(total_read) : -1;
+}
+
+bool ChunkedCharacterStream::reads_in_place() const {
+    const auto column = static_cast<short>(column_index_);
+    return !rs_->is_bound(column) && !rs_->is_buffered();
+}
+
+void ChunkedCharacterStream::refill() {
+    static_assert(sizeof(ApiChar) == sizeof(SQLWCHAR), "ApiChar must match SQLWCHAR");
+
+    position_ = 0;
+    decoded_length_ = 0;
+    if (!reads_in_place()) {
+        const ApiString* text = rs_->get_text(static_cast<short>(column_index_));
+        null_ = text == nullptr;
+        if (text) {
+            decoded_.assign(text->begin(), text->end());
+            decoded_length_ = decoded_.size();
+        }
+        exhausted_ = true;
+        return;
+    }
+
+    if (wide_) {
+        const size_t units = chunk_size_ / sizeof(ApiChar);
+        if (decoded_.size() < units) {
+            decoded_.resize(units);
+        }
+        decoded_length_ = fetch(decoded_.data(), units * sizeof(ApiChar), SQL_C_WCHAR, sizeof(ApiChar)) / sizeof(ApiChar);
+        return;
+    }
+
+    const size_t terminator = narrow_type_ == SQL_C_CHAR ? 1 : 0;
+    if (raw_.size() < carried_ + chunk_size_) {
+        raw_.resize(carried_ + chunk_size_);
+    }
+    const size_t length = carried_ + fetch(raw_.data() + carried_, chunk_size_, narrow_type_, terminator);
+
+    // at the end a cut sequence is ill-formed and gets replaced, before it waits for the next chunk
+    const size_t complete = exhausted_ ? length : utils::utf::utf8_complete_length(raw_.data(), length);
+    if (decoded_.size() < complete) {
+        decoded_.resize(complete);
+    }
+    decoded_length_ = utils::utf::utf8_to_utf16(raw_.data(), complete, reinterpret_cast<char16_t*>(decoded_.data()));
+    carried_ = length - complete;
+    std::memmove(raw_.data(), raw_.data() + complete, carried_);
+}
+
+size_t ChunkedCharacterStream::fetch(void* target, size_t capacity, short c_type, size_t terminator) {
+    SQLLEN indicator = 0;
+    const SQLRETURN rc = SQLGetData(
+        rs_->native_statement_handle(),
+        static_cast<SQLUSMALLINT>(column_index_ + 1), // ODBC uses 1-based indexing
+        c_type,
+        target,
+        static_cast<SQLLEN>(capacity),
+        &indicator
+    );
+
+    if (rc == SQL_NO_DATA) {
+        exhausted_ = true;
+        return 0;
+    }
+    if (!SQL_SUCCEEDED(rc)) {
+        throw nanodbc::database_error(rs_->native_statement_handle(), SQL_HANDLE_STMT);
+    }
+    if (indicator == SQL_NULL_DATA) {
+        null_ = true;
+        exhausted_ = true;
+        return 0;
+    }
+
+    // a truncated chunk holds capacity bytes of data less the terminator
+    const size_t data_capacity = capacity - terminator;
+    if (indicator == SQL_NO_TOTAL) {
+        chunk_size_ = std::min(chunk_size_ * 2, MAX_CHUNK_SIZE);
+        return data_capacity;
+    }
+    if (static_cast<size_t>(indicator) > data_capacity) {
+        const size_t rest = static_cast<size_t>(indicator) - data_capacity;
+        chunk_size_ = std::clamp(std::min(chunk_size_ * 2, rest + terminator), MIN_CHUNK_SIZE, MAX_CHUNK_SIZE);
+        return data_capacity;
+    }
+
+    exhausted_ = true;
+    return static_cast<size_t>(indicator);
+}
@@ -0,0 +1,94 @@
+#include "core/column_name_index.hpp"
+#include <cwctype>
+#include "utils/strhash.hpp"
+
+void ColumnNameIndex::build(const nanodbc::result& result) {
+    const short columns = result.columns();
+    entries_.clear();
+    size_ = 0;
+    size_t capacity = 8;
+    // keep the load factor at or below one half so probe sequences stay short
+    while (capacity < static_cast<size_t>(columns) * 2) {
+        capacity *= 2;
+    }
+    entries_.resize(capacity);
+    for (short column = 0; column < columns; ++column) {
+        insert(result.column_name(column), column, false);
+    }
+}
+
+void ColumnNameIndex::insert(nanodbc::string const& name, short column, bool replace) {
+    if (entries_.empty() || (size_ + 1) * 2 > entries_.size()) {
+        grow();
+    }
+    nanodbc::string folded = fold_case(name);
+    const unsigned long hash = hash_djb2a(folded);
+    const size_t mask = entries_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        Entry& entry = entries_[i];
+        if (entry.column < 0) {
+            entry.hash = hash;
+            entry.column = column;
+            entry.name = std::move(folded);
+            ++size_;
+            return;
+        }
+        if (entry.hash == hash && entry.name == folded) {
+            if (replace) {
+                entry.column = column;
+            }
+            return;
+        }
+    }
+}
+
+short ColumnNameIndex::find(nanodbc::string const& name) const {
+    if (entries_.empty()) {
+        return -1;
+    }
+    const nanodbc::string folded = fold_case(name);
+    const unsigned long hash = hash_djb2a(folded);
+    const size_t mask = entries_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const Entry& entry = entries_[i];
+        if (entry.column < 0) {
+            return -1;
+        }
+        if (entry.hash == hash && entry.name == folded) {
+            return entry.column;
+        }
+    }
+}
+
+nanodbc::string ColumnNameIndex::fold_case(nanodbc::string const& name) {
+    nanodbc::string folded(name);
+    for (auto& c : folded) {
+        if (c < 0x80) {
+            if (c >= 'A' && c <= 'Z') {
+                c = static_cast<nanodbc::string::value_type>(c + ('a' - 'A'));
+            }
+        } else {
+            c = static_cast<nanodbc::string::value_type>(std::towlower(static_cast<wint_t>(c)));
+        }
+    }
+    return folded;
+}
+
+void ColumnNameIndex::grow() {
+    std::vector<Entry> old = std::move(entries_);
+    entries_.clear();
+    entries_.resize(old.empty() ? 8 : old.size() * 2);
+    size_ = 0;
+    const size_t mask = entries_.size() - 1;
+    for (Entry& entry : old) {
+        if (entry.column < 0) {
+            continue;
+        }
+        size_t i = entry.hash & mask;
+        while (entries_[i].column >= 0) {
+            i = (i + 1) & mask;
+        }
+        entries_[i] = std::move(entry);
+        ++size_;
+    }
+}
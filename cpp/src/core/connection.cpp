@@ -1,4 +1,8 @@
 #include "core/connection.hpp"
+#include "core/async_operations.hpp"
+#include "core/statement.hpp"
+#include <stdexcept>
+#include <string>
 
 #ifdef _WIN32
 // needs to be included above sql.h for windows
@@ -10,6 +14,26 @@
 #include <sqlext.h>
 #include "core/nanodbc_defs.h"
 
+namespace {
+    std::optional<uint32_t> get_attribute(SQLHDBC handle, SQLINTEGER attribute) {
+        SQLUINTEGER value = 0;
+        if (!SQL_SUCCEEDED(SQLGetConnectAttr(handle, attribute, &value, 0, nullptr))) {
+            return std::nullopt;
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    void restore_attribute(SQLHDBC handle, SQLINTEGER attribute, const std::optional<uint32_t>& recorded, const char* name) {
+        if (!recorded || get_attribute(handle, attribute) == recorded) {
+            return;
+        }
+        const SQLRETURN rc = SQLSetConnectAttr(handle, attribute, (SQLPOINTER)(std::intptr_t)*recorded, 0);
+        if (!SQL_SUCCEEDED(rc)) {
+            throw std::runtime_error(std::string("ODBC error in SQLSetConnectAttr(") + name + ") restoring the session");
+        }
+    }
+}
+
 void Connection::set_catalog(const nanodbc::string& catalog) {
     if (!connected()) {
         throw std::runtime_error("Cannot set isolation level: connection is not active");
@@ -115,4 +139,97 @@ void Connection::rollback() {
 
 bool Connection::get_auto_commit() const {
     return transaction_ == nullptr;
-}
\ No newline at end of file
+}
+
+void Connection::set_wide_char_fetch(bool enabled) {
+    wide_char_fetch_ = enabled;
+}
+
+bool Connection::get_wide_char_fetch() const {
+    return wide_char_fetch_;
+}
+
+void Connection::set_statement_cache_size(size_t capacity) {
+    if (capacity == 0) {
+        statement_cache_.reset();
+    } else if (statement_cache_) {
+        statement_cache_->set_capacity(capacity);
+    } else {
+        statement_cache_ = std::make_shared<StatementCache>(capacity);
+        statement_cache_->set_eviction_callback(statement_eviction_callback_);
+    }
+}
+
+void Connection::set_statement_eviction_callback(StatementCache::EvictionCallback callback) {
+    statement_eviction_callback_ = std::move(callback);
+    if (statement_cache_) {
+        statement_cache_->set_eviction_callback(statement_eviction_callback_);
+    }
+}
+
+size_t Connection::get_statement_cache_size() const {
+    return statement_cache_ ? statement_cache_->capacity() : 0;
+}
+
+Statement* Connection::prepare_statement(const nanodbc::string& sql) {
+    const StatementCache::Key key{sql, wide_char_fetch_};
+    if (statement_cache_) {
+        if (std::unique_ptr<Statement> statement = statement_cache_->borrow(key)) {
+            return statement.release();
+        }
+    }
+
+    auto statement = std::make_unique<Statement>(*this);
+    statement->prepare(sql);
+    if (statement_cache_) {
+        statement_cache_->adopt(*statement, key);
+    }
+    return statement.release();
+}
+
+ExecuteAwaitable Connection::execute_async(const nanodbc::string& sql, long timeout, long fetch_size) {
+    return execute_async(sql, timeout, fetch_size, EventLoop::shared());
+}
+
+ExecuteAwaitable Connection::execute_async(const nanodbc::string& sql, long timeout, long fetch_size, EventLoop& loop) {
+    return ExecuteAwaitable(*this, sql, timeout, fetch_size, loop);
+}
+
+void Connection::attach_pool(std::weak_ptr<ConnectionPool> pool, std::shared_ptr<void> place) {
+    pool_ = std::move(pool);
+    pool_place_ = std::move(place);
+
+    session_defaults_.isolation = get_attribute(native_dbc_handle(), SQL_ATTR_TXN_ISOLATION);
+    session_defaults_.access_mode = get_attribute(native_dbc_handle(), SQL_ATTR_ACCESS_MODE);
+    try {
+        session_defaults_.catalog = catalog_name();
+    } catch (const nanodbc::database_error&) {
+        // drivers without catalogs leave it alone
+        session_defaults_.catalog.reset();
+    }
+}
+
+void Connection::reset_session() {
+    if (transaction_) {
+        transaction_->rollback();
+        transaction_.reset();
+    }
+    wide_char_fetch_ = false;
+    if (!connected()) {
+        return;
+    }
+
+    restore_attribute(native_dbc_handle(), SQL_ATTR_TXN_ISOLATION, session_defaults_.isolation, "SQL_ATTR_TXN_ISOLATION");
+    restore_attribute(native_dbc_handle(), SQL_ATTR_ACCESS_MODE, session_defaults_.access_mode, "SQL_ATTR_ACCESS_MODE");
+    if (session_defaults_.catalog && !session_defaults_.catalog->empty() && catalog_name() != *session_defaults_.catalog) {
+        set_catalog(*session_defaults_.catalog);
+    }
+}
+
+void Connection::disconnect() {
+    // statements must be freed before their connection
+    if (statement_cache_) {
+        statement_cache_->clear();
+    }
+    connection::disconnect();
+}
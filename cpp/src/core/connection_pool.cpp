@@ -0,0 +1,375 @@
+#include "core/connection_pool.hpp"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "utils/logger.hpp"
+#include "utils/string_proxy.hpp"
+
+#ifdef _WIN32
+// needs to be included above sql.h for windows
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include <sqlext.h>
+
+namespace {
+    constexpr std::chrono::seconds HOUSEKEEPING_INTERVAL{1};
+
+    bool is_blank(nanodbc::string::value_type c) {
+        return c == ' ' || c == '\t';
+    }
+
+    nanodbc::string trimmed(const nanodbc::string& text) {
+        size_t first = 0;
+        size_t last = text.size();
+        while (first < last && is_blank(text[first])) {
+            ++first;
+        }
+        while (last > first && is_blank(text[last - 1])) {
+            --last;
+        }
+        return text.substr(first, last - first);
+    }
+
+    bool is_alive(Connection& connection) {
+        if (!connection.connected()) {
+            return false;
+        }
+        SQLUINTEGER dead = SQL_CD_FALSE;
+        const SQLRETURN rc = SQLGetConnectAttr(connection.native_dbc_handle(), SQL_ATTR_CONNECTION_DEAD, &dead, 0, nullptr);
+        // drivers without the attribute get the benefit of the doubt
+        return !SQL_SUCCEEDED(rc) || dead != SQL_CD_TRUE;
+    }
+
+    /// Pools by normalized connection string, and the thread maintaining them.
+    class Registry {
+    public:
+        ~Registry() {
+            {
+                std::lock_guard lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_one();
+            if (housekeeper_.joinable()) {
+                housekeeper_.join();
+            }
+        }
+
+        std::shared_ptr<ConnectionPool> get(const nanodbc::string& connection_string, const ConnectionPool::Settings& settings) {
+            const nanodbc::string key = ConnectionPool::normalize(connection_string);
+            std::lock_guard lock(mutex_);
+            if (!housekeeper_.joinable()) {
+                housekeeper_ = std::thread([this] {
+                    run();
+                });
+            }
+            const auto found = pools_.find(key);
+            if (found != pools_.end()) {
+                found->second->configure(settings);
+                return found->second;
+            }
+            auto pool = std::make_shared<ConnectionPool>(connection_string, settings);
+            pools_.emplace(key, pool);
+            return pool;
+        }
+
+    private:
+        void run() {
+            std::unique_lock lock(mutex_);
+            while (!wake_.wait_for(lock, HOUSEKEEPING_INTERVAL, [this] {
+                return stop_;
+            })) {
+                std::vector<std::shared_ptr<ConnectionPool>> pools;
+                pools.reserve(pools_.size());
+                for (const auto& [key, pool] : pools_) {
+                    pools.push_back(pool);
+                }
+                // connecting may take a while, get must not wait for it
+                lock.unlock();
+                for (const std::shared_ptr<ConnectionPool>& pool : pools) {
+                    try {
+                        pool->maintain();
+                    } catch (const std::exception& e) {
+                        LOG_ERROR("Exception maintaining connection pool: {}", StringProxy(e.what()));
+                    }
+                }
+                lock.lock();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::unordered_map<nanodbc::string, std::shared_ptr<ConnectionPool>> pools_;
+        std::thread housekeeper_;
+        bool stop_ = false;
+    };
+
+    Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+}
+
+std::shared_ptr<ConnectionPool> ConnectionPool::get(const nanodbc::string& connection_string, const Settings& settings) {
+    return registry().get(connection_string, settings);
+}
+
+nanodbc::string ConnectionPool::normalize(const nanodbc::string& connection_string) {
+    std::vector<std::pair<nanodbc::string, nanodbc::string>> attributes;
+    size_t start = 0;
+    bool braced = false;
+    for (size_t i = 0; i <= connection_string.size(); ++i) {
+        if (i < connection_string.size()) {
+            const auto c = connection_string[i];
+            if (c == '{') {
+                braced = true;
+            } else if (c == '}') {
+                braced = false;
+            }
+            if (braced || c != ';') {
+                continue;
+            }
+        }
+        const nanodbc::string attribute = connection_string.substr(start, i - start);
+        start = i + 1;
+        const size_t equals = attribute.find('=');
+        nanodbc::string keyword = trimmed(attribute.substr(0, equals));
+        if (keyword.empty()) {
+            continue;
+        }
+        // keywords are case-insensitive, values such as passwords are not
+        std::transform(keyword.begin(), keyword.end(), keyword.begin(), [](nanodbc::string::value_type c) {
+            return c >= 'A' && c <= 'Z' ? static_cast<nanodbc::string::value_type>(c - 'A' + 'a') : c;
+        });
+        nanodbc::string value = equals == nanodbc::string::npos ? nanodbc::string() : trimmed(attribute.substr(equals + 1));
+        attributes.emplace_back(std::move(keyword), std::move(value));
+    }
+    // stable, as the driver manager takes the first of repeated keywords
+    std::stable_sort(attributes.begin(), attributes.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    nanodbc::string normalized;
+    for (const auto& [keyword, value] : attributes) {
+        normalized += keyword;
+        normalized += '=';
+        normalized += value;
+        normalized += ';';
+    }
+    return normalized;
+}
+
+void ConnectionPool::release(Connection* connection) {
+    std::unique_ptr<Connection> owned(connection);
+    if (const std::shared_ptr<ConnectionPool> pool = connection->pool()) {
+        pool->give_back(std::move(owned));
+        return;
+    }
+    if (owned->connected()) {
+        owned->disconnect();
+    }
+}
+
+ConnectionPool::ConnectionPool(nanodbc::string connection_string, const Settings& settings)
+    : connection_string_(std::move(connection_string))
+    , settings_(settings) {
+    validate(settings);
+}
+
+ConnectionPool::~ConnectionPool() {
+    clear();
+}
+
+std::unique_ptr<Connection> ConnectionPool::borrow() {
+    std::unique_lock lock(mutex_);
+    const auto deadline = std::chrono::steady_clock::now() + settings_.borrow_timeout;
+    for (;;) {
+        while (!idle_.empty()) {
+            std::unique_ptr<Connection> connection = std::move(idle_.back().connection);
+            idle_.pop_back();
+            const std::chrono::milliseconds max_lifetime = settings_.max_lifetime;
+            lock.unlock();
+            if (!expired(*connection, std::chrono::steady_clock::now(), max_lifetime) && is_alive(*connection)) {
+                return connection;
+            }
+            discard(std::move(connection));
+            lock.lock();
+        }
+        if (size_ < settings_.max_size) {
+            ++size_;
+            lock.unlock();
+            return connect();
+        }
+        const bool available = available_.wait_until(lock, deadline, [this] {
+            return !idle_.empty() || size_ < settings_.max_size;
+        });
+        if (!available) {
+            throw std::runtime_error("Timed out after " + std::to_string(settings_.borrow_timeout.count()) +
+                                     " ms waiting for a pooled connection");
+        }
+    }
+}
+
+void ConnectionPool::give_back(std::unique_ptr<Connection> connection) {
+    std::chrono::milliseconds max_lifetime;
+    {
+        std::lock_guard lock(mutex_);
+        max_lifetime = settings_.max_lifetime;
+    }
+    bool reusable = false;
+    try {
+        connection->reset_session();
+        reusable = connection->connected() && !expired(*connection, std::chrono::steady_clock::now(), max_lifetime);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Exception resetting pooled connection: {}", StringProxy(e.what()));
+    }
+    if (!reusable) {
+        discard(std::move(connection));
+        return;
+    }
+    {
+        std::lock_guard lock(mutex_);
+        idle_.push_back({std::move(connection), std::chrono::steady_clock::now()});
+    }
+    available_.notify_one();
+}
+
+void ConnectionPool::maintain() {
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<Connection>> evicted;
+    size_t missing = 0;
+    {
+        std::lock_guard lock(mutex_);
+        size_t remaining = size_;
+        for (auto it = idle_.begin(); it != idle_.end();) {
+            const bool idle_expired = settings_.idle_timeout.count() > 0 && now - it->since >= settings_.idle_timeout &&
+                                      remaining > settings_.min_size;
+            if (idle_expired || remaining > settings_.max_size || expired(*it->connection, now, settings_.max_lifetime)) {
+                evicted.push_back(std::move(it->connection));
+                it = idle_.erase(it);
+                --remaining;
+            } else {
+                ++it;
+            }
+        }
+        if (remaining < settings_.min_size) {
+            missing = settings_.min_size - remaining;
+            size_ += missing;
+        }
+    }
+    for (std::unique_ptr<Connection>& connection : evicted) {
+        discard(std::move(connection));
+    }
+
+    for (; missing > 0; --missing) {
+        std::unique_ptr<Connection> connection;
+        try {
+            connection = connect();
+        } catch (...) {
+            // connect freed this place, the others are still counted
+            std::lock_guard lock(mutex_);
+            size_ -= missing - 1;
+            available_.notify_all();
+            throw;
+        }
+        give_back(std::move(connection));
+    }
+}
+
+void ConnectionPool::configure(const Settings& settings) {
+    validate(settings);
+    {
+        std::lock_guard lock(mutex_);
+        settings_ = settings;
+    }
+    // a larger maximum lets waiting borrowers open connections
+    available_.notify_all();
+}
+
+ConnectionPool::Settings ConnectionPool::settings() const {
+    std::lock_guard lock(mutex_);
+    return settings_;
+}
+
+size_t ConnectionPool::size() const {
+    std::lock_guard lock(mutex_);
+    return size_;
+}
+
+size_t ConnectionPool::idle() const {
+    std::lock_guard lock(mutex_);
+    return idle_.size();
+}
+
+void ConnectionPool::clear() {
+    std::deque<Idle> cleared;
+    {
+        std::lock_guard lock(mutex_);
+        cleared.swap(idle_);
+    }
+    for (Idle& entry : cleared) {
+        discard(std::move(entry.connection));
+    }
+}
+
+std::unique_ptr<Connection> ConnectionPool::connect() {
+    long login_timeout = 0;
+    {
+        std::lock_guard lock(mutex_);
+        login_timeout = settings_.login_timeout;
+    }
+    std::unique_ptr<Connection> connection;
+    try {
+        connection = std::make_unique<Connection>(connection_string_, login_timeout);
+    } catch (...) {
+        vacate();
+        throw;
+    }
+    std::shared_ptr<void> place(nullptr, [pool = weak_from_this()](void*) {
+        if (const std::shared_ptr<ConnectionPool> owner = pool.lock()) {
+            owner->vacate();
+        }
+    });
+    connection->attach_pool(weak_from_this(), std::move(place));
+    return connection;
+}
+
+void ConnectionPool::vacate() {
+    {
+        std::lock_guard lock(mutex_);
+        --size_;
+    }
+    available_.notify_one();
+}
+
+bool ConnectionPool::expired(const Connection& connection, std::chrono::steady_clock::time_point now,
+                             std::chrono::milliseconds max_lifetime) {
+    return max_lifetime.count() > 0 && now - connection.created_at() >= max_lifetime;
+}
+
+void ConnectionPool::validate(const Settings& settings) {
+    if (settings.max_size == 0) {
+        throw std::invalid_argument("Maximum pool size must be at least 1");
+    }
+    if (settings.min_size > settings.max_size) {
+        throw std::invalid_argument("Minimum pool size exceeds the maximum");
+    }
+}
+
+void ConnectionPool::discard(std::unique_ptr<Connection> connection) noexcept {
+    try {
+        if (connection->connected()) {
+            connection->disconnect();
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Exception closing pooled connection: {}", StringProxy(e.what()));
+    }
+    connection.reset();
+}
@@ -0,0 +1,126 @@
+#include "core/event_loop.hpp"
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <utility>
+#include "utils/logger.hpp"
+#include "utils/string_proxy.hpp"
+
+namespace {
+    constexpr std::chrono::milliseconds MIN_PAUSE{1};
+    constexpr std::chrono::milliseconds MAX_PAUSE{50};
+}
+
+EventLoop::EventLoop(unsigned threads) {
+    threads = std::max(threads, 1u);
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // started once all workers exist, since add picks any of them
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        worker->thread = std::thread([this, &worker = *worker] {
+            run(worker);
+        });
+    }
+}
+
+EventLoop::~EventLoop() {
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        {
+            std::lock_guard lock(worker->mutex);
+            worker->stop = true;
+        }
+        worker->woken.notify_one();
+    }
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+void EventLoop::watch(PollFunction poll, Task completion) {
+    add({std::move(poll), std::move(completion)});
+}
+
+void EventLoop::post(Task task) {
+    add({[] {
+        return true;
+    }, std::move(task)});
+}
+
+size_t EventLoop::pending() const {
+    return pending_.load();
+}
+
+EventLoop& EventLoop::shared() {
+    static EventLoop loop(2);
+    return loop;
+}
+
+void EventLoop::add(Operation operation) {
+    Worker* worker = nullptr;
+    {
+        std::lock_guard lock(mutex_);
+        worker = workers_[next_worker_].get();
+        next_worker_ = (next_worker_ + 1) % workers_.size();
+    }
+    ++pending_;
+    // notified under the lock, so a loop being destroyed waits until the caller is done with it
+    std::lock_guard lock(worker->mutex);
+    worker->incoming.push_back(std::move(operation));
+    worker->woken.notify_one();
+}
+
+void EventLoop::run(Worker& worker) {
+    std::vector<Operation> active;
+    std::chrono::milliseconds pause = MIN_PAUSE;
+    for (;;) {
+        {
+            std::unique_lock lock(worker.mutex);
+            const auto woken = [&worker] {
+                return worker.stop || !worker.incoming.empty();
+            };
+            if (active.empty()) {
+                worker.woken.wait(lock, woken);
+            } else {
+                worker.woken.wait_for(lock, pause, woken);
+            }
+            if (worker.stop) {
+                return;
+            }
+            if (!worker.incoming.empty()) {
+                std::move(worker.incoming.begin(), worker.incoming.end(), std::back_inserter(active));
+                worker.incoming.clear();
+                pause = MIN_PAUSE;
+            }
+        }
+
+        bool progressed = false;
+        for (size_t i = 0; i < active.size();) {
+            bool finished = true;
+            try {
+                finished = active[i].poll();
+            } catch (const std::exception& e) {
+                // the completion finds out about the failure itself
+                LOG_ERROR("Exception polling an asynchronous operation: {}", StringProxy(e.what()));
+            }
+            if (!finished) {
+                ++i;
+                continue;
+            }
+            Operation done = std::move(active[i]);
+            if (i + 1 != active.size()) {
+                active[i] = std::move(active.back());
+            }
+            active.pop_back();
+            try {
+                done.completion();
+            } catch (const std::exception& e) {
+                LOG_ERROR("Exception completing an asynchronous operation: {}", StringProxy(e.what()));
+            }
+            --pending_;
+            progressed = true;
+        }
+        pause = progressed ? MIN_PAUSE : std::min(pause * 2, MAX_PAUSE);
+    }
+}
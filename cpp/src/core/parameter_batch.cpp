@@ -0,0 +1,85 @@
+#include "core/parameter_batch.hpp"
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+void ParameterBatch::add(const std::vector<ParameterValue>& row) {
+    // checked before anything is appended, so a rejected row leaves the batch as it was
+    for (size_t index = 0; index < row.size() && index < columns_.size(); ++index) {
+        check_type(columns_[index], row[index], index);
+    }
+
+    if (row.size() > columns_.size()) {
+        const size_t first_new = columns_.size();
+        columns_.resize(row.size());
+        for (size_t index = first_new; index < columns_.size(); ++index) {
+            // parameters first set in this row were NULL in the earlier ones
+            columns_[index].nulls.assign(rows_, 1);
+        }
+    }
+    for (size_t index = 0; index < columns_.size(); ++index) {
+        append(columns_[index], index < row.size() ? row[index] : ParameterValue(), rows_);
+    }
+    ++rows_;
+}
+
+void ParameterBatch::bind(nanodbc::statement& statement) {
+    for (size_t index = 0; index < columns_.size(); ++index) {
+        Column& column = columns_[index];
+        const auto parameter = static_cast<short>(index);
+        column.null_flags = std::make_unique<bool[]>(rows_);
+        for (size_t row = 0; row < rows_; ++row) {
+            column.null_flags[row] = column.nulls[row] != 0;
+        }
+
+        std::visit([&](auto& values) {
+            using V = std::decay_t<decltype(values)>;
+            if constexpr (std::is_same_v<V, std::monostate>) {
+                statement.bind_null(parameter, rows_);
+            } else if constexpr (std::is_same_v<V, std::vector<nanodbc::string>>) {
+                statement.bind_strings(parameter, values, column.null_flags.get());
+            } else if constexpr (std::is_same_v<V, std::vector<std::vector<uint8_t>>>) {
+                statement.bind(parameter, values, column.null_flags.get());
+            } else {
+                statement.bind(parameter, values.data(), rows_, column.null_flags.get());
+            }
+        }, column.values);
+    }
+}
+
+void ParameterBatch::clear() {
+    columns_.clear();
+    rows_ = 0;
+}
+
+void ParameterBatch::check_type(const Column& column, const ParameterValue& value, size_t index) {
+    std::visit([&](const auto& parameter) {
+        using T = std::decay_t<decltype(parameter)>;
+        if constexpr (!std::is_same_v<T, std::monostate>) {
+            if (column.values.index() != 0 && !std::holds_alternative<std::vector<T>>(column.values)) {
+                throw std::invalid_argument("Parameter " + std::to_string(index + 1) + " changes its type within the batch");
+            }
+        }
+    }, value);
+}
+
+void ParameterBatch::append(Column& column, const ParameterValue& value, size_t rows) {
+    std::visit([&](const auto& parameter) {
+        using T = std::decay_t<decltype(parameter)>;
+        if constexpr (std::is_same_v<T, std::monostate>) {
+            std::visit([](auto& values) {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(values)>, std::monostate>) {
+                    values.emplace_back();
+                }
+            }, column.values);
+            column.nulls.push_back(1);
+        } else {
+            if (column.values.index() == 0) {
+                // the rows before the first value were NULL
+                column.values.template emplace<std::vector<T>>(rows);
+            }
+            std::get<std::vector<T>>(column.values).push_back(parameter);
+            column.nulls.push_back(0);
+        }
+    }, value);
+}
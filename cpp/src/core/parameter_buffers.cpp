@@ -0,0 +1,448 @@
+#include "core/parameter_buffers.hpp"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+// needs to be included above sql.h for windows
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include <sqlext.h>
+#include "core/nanodbc_defs.h"
+
+namespace {
+    constexpr size_t MIN_CAPACITY = 32;
+    /// Bytes of a stream sent per SQLPutData call.
+    constexpr size_t STREAM_CHUNK = 64 * 1024;
+
+    bool is_high_surrogate(nanodbc::string::value_type unit) {
+        return unit >= 0xD800 && unit <= 0xDBFF;
+    }
+
+    /// Whether the column size of a parameter of this SQL type counts characters or bytes of the value.
+    bool is_sized_by_value(SQLSMALLINT sql_type) {
+        switch (sql_type) {
+            case SQL_CHAR:
+            case SQL_VARCHAR:
+            case SQL_LONGVARCHAR:
+            case SQL_WCHAR:
+            case SQL_WVARCHAR:
+            case SQL_WLONGVARCHAR:
+            case SQL_BINARY:
+            case SQL_VARBINARY:
+            case SQL_LONGVARBINARY:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+struct ParameterBuffers::Slot {
+    Kind kind = Kind::Unset;       ///< Kind of the value set.
+    Kind bound_kind = Kind::Unset; ///< Kind the buffer is bound as, Unset if not bound.
+    std::unique_ptr<uint8_t[]> data;
+    size_t capacity = 0;
+    size_t bound_capacity = 0;
+    SQLLEN indicator = SQL_NULL_DATA;
+    bool described = false;
+    SQLSMALLINT sql_type = 0;
+    SQLULEN column_size = 0;
+    SQLSMALLINT decimal_digits = 0;
+    StreamReader reader; ///< Source of a stream, empty once read.
+};
+
+ParameterBuffers::ParameterBuffers() = default;
+
+// out of line, Slot is complete here
+ParameterBuffers::~ParameterBuffers() = default;
+
+void ParameterBuffers::set(nanodbc::statement& statement, short index, short value) {
+    set_fixed(statement, index, Kind::Short, value);
+}
+
+void ParameterBuffers::set(nanodbc::statement& statement, short index, int value) {
+    set_fixed(statement, index, Kind::Int, value);
+}
+
+void ParameterBuffers::set(nanodbc::statement& statement, short index, int64_t value) {
+    set_fixed(statement, index, Kind::Long, value);
+}
+
+void ParameterBuffers::set(nanodbc::statement& statement, short index, float value) {
+    set_fixed(statement, index, Kind::Float, value);
+}
+
+void ParameterBuffers::set(nanodbc::statement& statement, short index, double value) {
+    set_fixed(statement, index, Kind::Double, value);
+}
+
+void ParameterBuffers::set(nanodbc::statement& statement, short index, const nanodbc::date& value) {
+    SQL_DATE_STRUCT date{};
+    date.year = value.year;
+    date.month = static_cast<SQLUSMALLINT>(value.month);
+    date.day = static_cast<SQLUSMALLINT>(value.day);
+    set_fixed(statement, index, Kind::Date, date);
+}
+
+void ParameterBuffers::set(nanodbc::statement& statement, short index, const nanodbc::time& value) {
+    SQL_TIME_STRUCT time{};
+    time.hour = static_cast<SQLUSMALLINT>(value.hour);
+    time.minute = static_cast<SQLUSMALLINT>(value.min);
+    time.second = static_cast<SQLUSMALLINT>(value.sec);
+    set_fixed(statement, index, Kind::Time, time);
+}
+
+void ParameterBuffers::set(nanodbc::statement& statement, short index, const nanodbc::timestamp& value) {
+    SQL_TIMESTAMP_STRUCT timestamp{};
+    timestamp.year = value.year;
+    timestamp.month = static_cast<SQLUSMALLINT>(value.month);
+    timestamp.day = static_cast<SQLUSMALLINT>(value.day);
+    timestamp.hour = static_cast<SQLUSMALLINT>(value.hour);
+    timestamp.minute = static_cast<SQLUSMALLINT>(value.min);
+    timestamp.second = static_cast<SQLUSMALLINT>(value.sec);
+    timestamp.fraction = static_cast<SQLUINTEGER>(value.fract);
+    set_fixed(statement, index, Kind::Timestamp, timestamp);
+}
+
+void ParameterBuffers::set_string(nanodbc::statement& statement, short index, const nanodbc::string::value_type* data, size_t length) {
+    const size_t size = length * sizeof(nanodbc::string::value_type);
+    uint8_t* buffer = prepare(statement, index, Kind::String, size);
+    std::memcpy(buffer, data, size);
+    slot(index).indicator = static_cast<SQLLEN>(size);
+}
+
+void ParameterBuffers::set_binary(nanodbc::statement& statement, short index, const uint8_t* data, size_t length) {
+    uint8_t* buffer = prepare(statement, index, Kind::Binary, length);
+    if (length != 0) {
+        std::memcpy(buffer, data, length);
+    }
+    slot(index).indicator = static_cast<SQLLEN>(length);
+}
+
+void ParameterBuffers::set_null(nanodbc::statement& statement, short index) {
+    Slot& target = slot(index);
+    if (target.bound_kind == Kind::Unset) {
+        prepare(statement, index, Kind::Null, 0);
+    }
+    // any binding takes NULL through its indicator
+    target.kind = Kind::Null;
+    target.indicator = SQL_NULL_DATA;
+    target.reader = nullptr;
+}
+
+void ParameterBuffers::set_stream(nanodbc::statement& statement, short index, bool character, StreamReader reader,
+                                  int64_t length) {
+    const Kind kind = character ? Kind::CharacterStream : Kind::BinaryStream;
+    prepare(statement, index, kind, STREAM_CHUNK);
+    Slot& target = slot(index);
+    const int64_t unit = character ? static_cast<int64_t>(sizeof(nanodbc::string::value_type)) : 1;
+    target.indicator = length < 0 ? SQL_DATA_AT_EXEC : SQL_LEN_DATA_AT_EXEC(static_cast<SQLLEN>(length * unit));
+    target.reader = std::move(reader);
+}
+
+bool ParameterBuffers::has_streams() const {
+    return std::any_of(slots_.begin(), slots_.end(), [](const std::unique_ptr<Slot>& target) {
+        return target && (target->kind == Kind::BinaryStream || target->kind == Kind::CharacterStream);
+    });
+}
+
+void ParameterBuffers::put_stream(nanodbc::statement& statement, void* token) {
+    // the token is the parameter position plus one, see bind
+    const size_t index = reinterpret_cast<uintptr_t>(token) - 1;
+    if (index >= slots_.size() || !slots_[index]) {
+        throw std::logic_error("Driver asked for data of parameter " + std::to_string(index + 1) + ", which is not a stream");
+    }
+    Slot& source = *slots_[index];
+    const HSTMT handle = statement.native_statement_handle();
+    const auto put = [handle](SQLPOINTER data, SQLLEN length) {
+        if (!SQL_SUCCEEDED(SQLPutData(handle, data, length))) {
+            NANODBC_THROW_DATABASE_ERROR(handle, SQL_HANDLE_STMT);
+        }
+    };
+
+    const StreamReader reader = std::move(source.reader);
+    source.reader = nullptr;
+    if (!reader) {
+        put(nullptr, SQL_NULL_DATA);
+        return;
+    }
+
+    const bool character = source.kind == Kind::CharacterStream;
+    const size_t unit = character ? sizeof(nanodbc::string::value_type) : 1;
+    const size_t capacity = std::min<size_t>(source.capacity / unit, INT_MAX);
+    uint8_t* const data = source.data.get();
+    size_t held = 0; // a high surrogate kept back, so no chunk ends within a pair
+    bool sent = false;
+    for (;;) {
+        const int read = reader(data + held * unit, static_cast<int>(capacity - held));
+        if (read < 0) {
+            throw std::runtime_error("Reading the stream of parameter " + std::to_string(index + 1) + " failed");
+        }
+        if (read == 0) {
+            break;
+        }
+        size_t units = held + static_cast<size_t>(read);
+        held = 0;
+        if (character) {
+            nanodbc::string::value_type last;
+            std::memcpy(&last, data + (units - 1) * unit, unit);
+            if (is_high_surrogate(last)) {
+                held = 1;
+                --units;
+            }
+        }
+        if (units != 0) {
+            put(data, static_cast<SQLLEN>(units * unit));
+            sent = true;
+        }
+        if (held != 0) {
+            std::memmove(data, data + units * unit, unit);
+        }
+    }
+    if (held != 0 || !sent) {
+        // an empty stream still sends its zero length
+        put(data, static_cast<SQLLEN>(held * unit));
+    }
+}
+
+std::vector<ParameterValue> ParameterBuffers::values(size_t count) const {
+    const auto is_set = [this](size_t index) {
+        return index < slots_.size() && slots_[index] && slots_[index]->kind != Kind::Unset;
+    };
+    for (size_t index = 0; index < count; ++index) {
+        if (!is_set(index)) {
+            throw std::invalid_argument("Parameter " + std::to_string(index + 1) + " is not set");
+        }
+    }
+    for (size_t index = count; index < slots_.size(); ++index) {
+        if (is_set(index)) {
+            throw std::invalid_argument("Parameter " + std::to_string(index + 1) + " is set, but the statement has only "
+                                        + std::to_string(count));
+        }
+    }
+
+    std::vector<ParameterValue> values(count);
+    for (size_t index = 0; index < count; ++index) {
+        const Slot& source = *slots_[index];
+        const uint8_t* data = source.data.get();
+        const auto read = [data]<class T>(T value) {
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        };
+        switch (source.kind) {
+            case Kind::Short:
+                values[index] = read(short());
+                break;
+            case Kind::Int:
+                values[index] = read(int());
+                break;
+            case Kind::Long:
+                values[index] = read(int64_t());
+                break;
+            case Kind::Float:
+                values[index] = read(float());
+                break;
+            case Kind::Double:
+                values[index] = read(double());
+                break;
+            case Kind::Date: {
+                const auto date = read(SQL_DATE_STRUCT());
+                values[index] = nanodbc::date{date.year, static_cast<int16_t>(date.month), static_cast<int16_t>(date.day)};
+                break;
+            }
+            case Kind::Time: {
+                const auto time = read(SQL_TIME_STRUCT());
+                values[index] = nanodbc::time{static_cast<int16_t>(time.hour), static_cast<int16_t>(time.minute),
+                                              static_cast<int16_t>(time.second)};
+                break;
+            }
+            case Kind::Timestamp: {
+                const auto timestamp = read(SQL_TIMESTAMP_STRUCT());
+                values[index] = nanodbc::timestamp{timestamp.year, static_cast<int16_t>(timestamp.month),
+                                                   static_cast<int16_t>(timestamp.day), static_cast<int16_t>(timestamp.hour),
+                                                   static_cast<int16_t>(timestamp.minute), static_cast<int16_t>(timestamp.second),
+                                                   static_cast<int32_t>(timestamp.fraction)};
+                break;
+            }
+            case Kind::String:
+                values[index] = nanodbc::string(reinterpret_cast<const nanodbc::string::value_type*>(data),
+                                                static_cast<size_t>(source.indicator) / sizeof(nanodbc::string::value_type));
+                break;
+            case Kind::Binary:
+                values[index] = std::vector<uint8_t>(data, data + source.indicator);
+                break;
+            case Kind::BinaryStream:
+            case Kind::CharacterStream:
+                throw std::invalid_argument("Parameter " + std::to_string(index + 1)
+                                            + " is a stream, which cannot be added to a batch");
+            default:
+                break;
+        }
+    }
+    return values;
+}
+
+void ParameterBuffers::reset() {
+    for (const std::unique_ptr<Slot>& target : slots_) {
+        target->kind = Kind::Unset;
+        target->bound_kind = Kind::Unset;
+        target->indicator = SQL_NULL_DATA;
+        target->reader = nullptr;
+    }
+}
+
+void ParameterBuffers::clear() {
+    slots_.clear();
+}
+
+ParameterBuffers::Slot& ParameterBuffers::slot(short index) {
+    if (static_cast<size_t>(index) >= slots_.size()) {
+        // slots are held by pointer, so bound buffers stay in place as the vector grows
+        slots_.resize(static_cast<size_t>(index) + 1);
+    }
+    std::unique_ptr<Slot>& target = slots_[static_cast<size_t>(index)];
+    if (!target) {
+        target = std::make_unique<Slot>();
+    }
+    return *target;
+}
+
+uint8_t* ParameterBuffers::prepare(nanodbc::statement& statement, short index, Kind kind, size_t size) {
+    if (index < 0) {
+        throw nanodbc::index_range_error();
+    }
+    Slot& target = slot(index);
+    std::unique_ptr<uint8_t[]> grown;
+    size_t capacity = target.capacity;
+    if (!target.data || size > capacity) {
+        capacity = std::bit_ceil(std::max(size, MIN_CAPACITY));
+        grown.reset(new uint8_t[capacity]);
+    }
+    if (grown || target.bound_kind != kind || target.bound_capacity != capacity) {
+        // the old buffer is freed only once the driver points at the new one
+        bind(statement, index, target, kind, grown ? grown.get() : target.data.get(), capacity);
+    }
+    if (grown) {
+        target.data = std::move(grown);
+        target.capacity = capacity;
+    }
+    target.kind = kind;
+    target.reader = nullptr;
+    return target.data.get();
+}
+
+void ParameterBuffers::bind(nanodbc::statement& statement, short index, Slot& slot, Kind kind, uint8_t* data,
+                            size_t capacity) {
+    const HSTMT handle = statement.native_statement_handle();
+    if (!slot.described) {
+        SQLSMALLINT nullable = 0;
+        slot.described = SQL_SUCCEEDED(SQLDescribeParam(handle, static_cast<SQLUSMALLINT>(index + 1), &slot.sql_type,
+                                                        &slot.column_size, &slot.decimal_digits, &nullable));
+        if (!slot.described) {
+            // drivers without SQLDescribeParam get a type matching each value
+            slot.sql_type = 0;
+            slot.column_size = 0;
+            slot.decimal_digits = 0;
+        }
+    }
+
+    SQLSMALLINT c_type = SQL_C_CHAR;
+    SQLSMALLINT sql_type = SQL_VARCHAR;
+    SQLULEN column_size = slot.column_size;
+    SQLSMALLINT decimal_digits = slot.decimal_digits;
+    switch (kind) {
+        case Kind::Short:
+            c_type = SQL_C_SSHORT;
+            sql_type = SQL_SMALLINT;
+            break;
+        case Kind::Int:
+            c_type = SQL_C_SLONG;
+            sql_type = SQL_INTEGER;
+            break;
+        case Kind::Long:
+            c_type = SQL_C_SBIGINT;
+            sql_type = SQL_BIGINT;
+            break;
+        case Kind::Float:
+            c_type = SQL_C_FLOAT;
+            sql_type = SQL_REAL;
+            break;
+        case Kind::Double:
+            c_type = SQL_C_DOUBLE;
+            sql_type = SQL_DOUBLE;
+            break;
+        case Kind::Date:
+            c_type = SQL_C_TYPE_DATE;
+            sql_type = SQL_TYPE_DATE;
+            break;
+        case Kind::Time:
+            c_type = SQL_C_TYPE_TIME;
+            sql_type = SQL_TYPE_TIME;
+            break;
+        case Kind::Timestamp:
+            c_type = SQL_C_TYPE_TIMESTAMP;
+            sql_type = SQL_TYPE_TIMESTAMP;
+            if (!slot.described) {
+                column_size = 29;
+                decimal_digits = 9;
+            }
+            break;
+        case Kind::String:
+            c_type = SQL_C_WCHAR;
+            sql_type = SQL_WVARCHAR;
+            // a character column size follows the buffer, so a longer value within it needs no new binding;
+            // other described types (e.g. DECIMAL set from a string) keep their own precision
+            if (!slot.described || is_sized_by_value(slot.sql_type)) {
+                column_size = std::max<SQLULEN>(column_size, capacity / sizeof(nanodbc::string::value_type));
+            }
+            break;
+        case Kind::Binary:
+            c_type = SQL_C_BINARY;
+            sql_type = SQL_VARBINARY;
+            if (!slot.described || is_sized_by_value(slot.sql_type)) {
+                column_size = std::max<SQLULEN>(column_size, capacity);
+            }
+            break;
+        case Kind::BinaryStream:
+            c_type = SQL_C_BINARY;
+            sql_type = SQL_LONGVARBINARY;
+            break;
+        case Kind::CharacterStream:
+            c_type = SQL_C_WCHAR;
+            sql_type = SQL_WLONGVARCHAR;
+            break;
+        default:
+            column_size = std::max<SQLULEN>(column_size, 1);
+            break;
+    }
+    if (slot.described) {
+        sql_type = slot.sql_type;
+    }
+
+    // a stream is bound to a token the driver hands back from SQLParamData instead of data
+    const bool stream = kind == Kind::BinaryStream || kind == Kind::CharacterStream;
+    const SQLPOINTER value = stream ? reinterpret_cast<SQLPOINTER>(static_cast<uintptr_t>(index) + 1) : data;
+    const SQLRETURN rc = SQLBindParameter(handle, static_cast<SQLUSMALLINT>(index + 1), SQL_PARAM_INPUT, c_type, sql_type,
+                                          column_size, decimal_digits, value,
+                                          stream ? 0 : static_cast<SQLLEN>(capacity), &slot.indicator);
+    if (!SQL_SUCCEEDED(rc)) {
+        slot.bound_kind = Kind::Unset;
+        NANODBC_THROW_DATABASE_ERROR(handle, SQL_HANDLE_STMT);
+    }
+    slot.bound_kind = kind;
+    slot.bound_capacity = capacity;
+}
+
+template <class T>
+void ParameterBuffers::set_fixed(nanodbc::statement& statement, short index, Kind kind, const T& value) {
+    uint8_t* buffer = prepare(statement, index, kind, sizeof(T));
+    std::memcpy(buffer, &value, sizeof(T));
+    slot(index).indicator = static_cast<SQLLEN>(sizeof(T));
+}
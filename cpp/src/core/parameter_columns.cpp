@@ -0,0 +1,75 @@
+#include "core/parameter_columns.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+void ParameterColumns::bind_strings(nanodbc::statement& statement, short index, const nanodbc::string::value_type* data,
+                                    size_t length, const int32_t* offsets, const uint8_t* nulls, size_t rows) {
+    // checked before the column is touched, the strings are copied by these offsets
+    for (size_t row = 0; row < rows; ++row) {
+        if (offsets[row] < 0 || offsets[row + 1] < offsets[row]) {
+            throw std::invalid_argument("Offsets of parameter " + std::to_string(index + 1) + " decrease at row "
+                                        + std::to_string(row + 1));
+        }
+    }
+    if (static_cast<size_t>(offsets[rows]) > length) {
+        throw std::invalid_argument("Offsets of parameter " + std::to_string(index + 1) + " end at "
+                                    + std::to_string(offsets[rows]) + ", past the " + std::to_string(length)
+                                    + " code units of data");
+    }
+    Column& column = prepare(index, nulls, rows);
+
+    size_t width = 0;
+    for (size_t row = 0; row < rows; ++row) {
+        width = std::max(width, static_cast<size_t>(offsets[row + 1] - offsets[row]));
+    }
+    // one element per row, wide enough for the longest string and its terminator
+    ++width;
+    column.strings.assign(rows * width, 0);
+    for (size_t row = 0; row < rows; ++row) {
+        if (!column.null_flags || !column.null_flags[row]) {
+            std::copy(data + offsets[row], data + offsets[row + 1], column.strings.data() + row * width);
+        }
+    }
+    statement.bind_strings(index, column.strings.data(), width, rows, column.null_flags.get());
+}
+
+size_t ParameterColumns::bound() const {
+    return static_cast<size_t>(std::count_if(columns_.begin(), columns_.end(), [](const Column& column) {
+        return column.bound;
+    }));
+}
+
+void ParameterColumns::clear() {
+    columns_.clear();
+    rows_ = 0;
+}
+
+ParameterColumns::Column& ParameterColumns::prepare(short index, const uint8_t* nulls, size_t rows) {
+    if (index < 0) {
+        throw std::out_of_range("Parameter index " + std::to_string(index) + " is out of range");
+    }
+    if (rows == 0) {
+        throw std::invalid_argument("Parameter " + std::to_string(index + 1) + " has no rows");
+    }
+    if (rows_ != 0 && rows != rows_) {
+        throw std::invalid_argument("Parameter " + std::to_string(index + 1) + " has " + std::to_string(rows)
+                                    + " rows, the other parameters have " + std::to_string(rows_));
+    }
+    if (static_cast<size_t>(index) >= columns_.size()) {
+        columns_.resize(static_cast<size_t>(index) + 1);
+    }
+    rows_ = rows;
+
+    Column& column = columns_[static_cast<size_t>(index)];
+    column.bound = true;
+    column.strings.clear();
+    column.null_flags.reset();
+    if (nulls) {
+        column.null_flags = std::make_unique<bool[]>(rows);
+        for (size_t row = 0; row < rows; ++row) {
+            column.null_flags[row] = (nulls[row >> 3] >> (row & 7) & 1) != 0;
+        }
+    }
+    return column;
+}
@@ -1,4 +1,11 @@
 #include "core/result_set.hpp"
+#include "core/async_operations.hpp"
+#include "api/api.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <stdexcept>
+#include <utility>
 
 #ifdef _WIN32
 // needs to be included above sql.h for windows
@@ -8,24 +15,503 @@
 #endif
 
 #include <sqlext.h>
+#include <sql.h>
+#include "core/nanodbc_defs.h"
 
 using namespace std;
 
+static int32_t batch_type_of(short c_type) {
+    switch (c_type) {
+        case SQL_C_BIT:
+        case SQL_C_TINYINT:
+        case SQL_C_STINYINT:
+        case SQL_C_UTINYINT:
+        case SQL_C_SHORT:
+        case SQL_C_SSHORT:
+        case SQL_C_USHORT:
+        case SQL_C_LONG:
+        case SQL_C_SLONG:
+            return COLUMN_BATCH_INT32;
+        case SQL_C_ULONG:
+        case SQL_C_SBIGINT:
+        case SQL_C_UBIGINT:
+            return COLUMN_BATCH_INT64;
+        case SQL_C_FLOAT:
+        case SQL_C_DOUBLE:
+            return COLUMN_BATCH_DOUBLE;
+        case SQL_C_BINARY:
+            return COLUMN_BATCH_BINARY;
+        default:
+            return COLUMN_BATCH_STRING;
+    }
+}
+
+static ColumnAccessor accessor_of(short c_type) {
+    switch (c_type) {
+        case SQL_C_CHAR:
+            return ColumnAccessor::Char;
+        case SQL_C_BINARY:
+            return ColumnAccessor::Binary;
+        default:
+            return ColumnAccessor::Native;
+    }
+}
+
+/// Sign and 127-bit magnitude of a decimal while it is being assembled.
+struct DecimalDigits {
+    uint64_t high = 0;
+    uint64_t low = 0;
+    int32_t scale = 0;
+    bool negative = false;
+
+    /// Appends a decimal digit, false if the magnitude would no longer fit.
+    bool push(unsigned digit) {
+        if (high > (static_cast<uint64_t>(INT64_MAX) - 9) / 10) {
+            return false;
+        }
+        // 128-bit multiply by 10 in 32-bit halves, no __int128 on MSVC
+        const uint64_t low_part = (low & 0xFFFFFFFFu) * 10 + digit;
+        const uint64_t high_part = (low >> 32) * 10 + (low_part >> 32);
+        low = high_part << 32 | (low_part & 0xFFFFFFFFu);
+        high = high * 10 + (high_part >> 32);
+        return true;
+    }
+
+    /// Pads with trailing zeros up to the given scale, as far as the magnitude allows.
+    void rescale(int32_t min_scale) {
+        while (scale < min_scale && push(0)) {
+            ++scale;
+        }
+    }
+
+    void store(CDecimal& value) const {
+        uint64_t unscaled_low = low;
+        uint64_t unscaled_high = high;
+        if (negative) {
+            unscaled_low = ~unscaled_low + 1;
+            unscaled_high = ~unscaled_high + (unscaled_low == 0 ? 1 : 0);
+        }
+        value.unscaled_low = unscaled_low;
+        value.unscaled_high = static_cast<int64_t>(unscaled_high);
+        value.scale = scale;
+    }
+
+    /// Parses [sign] digits [. digits] [e [sign] digits], surrounding blanks allowed.
+    template <typename CharT>
+    bool parse(const CharT* text, size_t length) {
+        size_t i = 0;
+        while (i < length && (text[i] == ' ' || text[i] == '\t')) ++i;
+        while (length > i && (text[length - 1] == ' ' || text[length - 1] == '\t')) --length;
+        if (i < length && (text[i] == '-' || text[i] == '+')) {
+            negative = text[i++] == '-';
+        }
+
+        bool digits = false;
+        bool point = false;
+        for (; i < length; ++i) {
+            const CharT c = text[i];
+            if (c >= '0' && c <= '9') {
+                if (!push(static_cast<unsigned>(c - '0'))) return false;
+                digits = true;
+                if (point) ++scale;
+            } else if (c == '.' && !point) {
+                point = true;
+            } else {
+                break;
+            }
+        }
+        if (!digits) {
+            return false;
+        }
+
+        if (i < length && (text[i] == 'e' || text[i] == 'E')) {
+            ++i;
+            bool exponent_negative = false;
+            if (i < length && (text[i] == '-' || text[i] == '+')) {
+                exponent_negative = text[i++] == '-';
+            }
+            int32_t exponent = 0;
+            const size_t exponent_begin = i;
+            for (; i < length && text[i] >= '0' && text[i] <= '9'; ++i) {
+                if (exponent > 100000) return false;
+                exponent = exponent * 10 + static_cast<int32_t>(text[i] - '0');
+            }
+            if (i == exponent_begin) {
+                return false;
+            }
+            scale += exponent_negative ? exponent : -exponent;
+        }
+        return i == length;
+    }
+};
+
 ResultSet::ResultSet(const result& rhs)
         : result(rhs) {
+    describe_columns();
 }
 
-ResultSet::ResultSet(result&& rhs) noexcept
+ResultSet::ResultSet(result&& rhs)
         : result(std::move(rhs)) {
+    describe_columns();
 }
 
 ResultSet::ResultSet(nanodbc::statement&& statement, long rowset_size)
         : result(std::move(statement), rowset_size) {
+    describe_columns();
+}
+
+ResultSet ResultSet::open(const nanodbc::statement& statement, long fetch_size, bool wide_char_fetch) {
+    if (fetch_size > 1) {
+        ResultSet block(nanodbc::statement(statement), fetch_size);
+        if (!block.has_unbound_columns()) {
+            block.bind_decimals();
+            block.wide_char_fetch_ = wide_char_fetch;
+            return block;
+        }
+        // block is released here, before the single-row cursor binds its own buffers
+    }
+    ResultSet single(nanodbc::statement(statement), 1);
+    single.unbind();
+    single.wide_char_fetch_ = wide_char_fetch;
+    return single;
+}
+
+void ResultSet::enable_prefetch(int batch_rows) {
+    if (batch_rows < 1) {
+        throw std::invalid_argument("Prefetch batch size must be positive");
+    }
+    if (row_cache_) {
+        throw std::logic_error("Prefetching cannot be combined with the row cache");
+    }
+    if (prefetcher_) {
+        return;
+    }
+    on_row_changed();
+    prefetched_position_ = result::position();
+    prefetcher_ = std::make_unique<RowPrefetcher>([this](ColumnBatch& batch, int max_rows) {
+        return fill_batch(batch, max_rows);
+    }, batch_rows);
+}
+
+void ResultSet::enable_row_cache(size_t memory_budget) {
+    if (prefetcher_) {
+        throw std::logic_error("The row cache cannot be combined with prefetching");
+    }
+    if (row_cache_) {
+        return;
+    }
+    on_row_changed();
+    std::vector<int32_t> types;
+    types.reserve(descriptors_.size());
+    for (const ColumnDescriptor& column_descriptor : descriptors_) {
+        types.push_back(column_descriptor.batch_type);
+    }
+    row_cache_ = std::make_unique<RowCache>([this](ColumnBatch& batch, int max_rows) {
+        return fill_batch(batch, max_rows);
+    }, types, memory_budget);
+}
+
+void ResultSet::enable_value_arena() {
+    if (!value_arena_) {
+        value_arena_ = std::make_unique<ValueArena>();
+    }
+}
+
+bool ResultSet::next() {
+    on_row_changed();
+    if (row_cache_) {
+        return row_cache_->next();
+    }
+    if (prefetcher_) {
+        return next_prefetched();
+    }
+    const bool had_rows = result::rows() != 0;
+    const bool moved = result::next();
+    follow_rowset(had_rows, rowset_row_ + 1);
+    return moved;
+}
+
+FetchAwaitable ResultSet::fetch_async() {
+    return fetch_async(EventLoop::shared());
+}
+
+FetchAwaitable ResultSet::fetch_async(EventLoop& loop) {
+    return FetchAwaitable(*this, loop);
+}
+
+bool ResultSet::prior() {
+    ensure_scrollable();
+    on_row_changed();
+    if (row_cache_) {
+        return row_cache_->prior();
+    }
+    const bool had_rows = result::rows() != 0;
+    const bool moved = result::prior();
+    follow_rowset(had_rows, rowset_row_ - 1);
+    return moved;
+}
+
+bool ResultSet::first() {
+    ensure_scrollable();
+    on_row_changed();
+    if (row_cache_) {
+        return row_cache_->move_to(0);
+    }
+    rowset_row_ = 0;
+    return result::first();
+}
+
+bool ResultSet::last() {
+    ensure_scrollable();
+    on_row_changed();
+    if (row_cache_) {
+        return row_cache_->last();
+    }
+    rowset_row_ = 0;
+    return result::last();
+}
+
+bool ResultSet::move(long row) {
+    ensure_scrollable();
+    on_row_changed();
+    if (row_cache_) {
+        return row_cache_->absolute(row);
+    }
+    rowset_row_ = 0;
+    return result::move(row);
+}
+
+bool ResultSet::skip(long rows) {
+    ensure_scrollable();
+    on_row_changed();
+    if (row_cache_) {
+        return row_cache_->skip(rows);
+    }
+    const bool had_rows = result::rows() != 0;
+    const bool moved = result::skip(rows);
+    follow_rowset(had_rows, rowset_row_ + rows);
+    return moved;
+}
+
+const ApiString* ResultSet::get_text(short column) {
+    if (column != text_column_) {
+        text_ = static_cast<ApiString>(StringProxy(get<nanodbc::string>(column, {})));
+        // for unbound columns, null indicator is determined by SQLGetData call
+        text_null_ = is_null(column);
+        text_column_ = column;
+    }
+    return text_null_ ? nullptr : &text_;
+}
+
+bool ResultSet::get_bytes(short column, BinaryArray& value) {
+    if (is_buffered()) {
+        const BufferedValue buffered = buffered_value(column);
+        if (!buffered.data) {
+            return false;
+        }
+        if (buffered.type == COLUMN_BATCH_BINARY) {
+            assign_bytes(value, buffered.data, buffered.size);
+        } else {
+            const auto text = static_cast<std::string>(StringProxy(buffered_text(buffered)));
+            assign_bytes(value, reinterpret_cast<const uint8_t*>(text.data()), text.size());
+        }
+        return true;
+    }
+
+    const short c_type = descriptor(column).c_type;
+    if ((c_type == SQL_C_BINARY || c_type == SQL_C_CHAR) && !is_bound(column)) {
+        return read_bytes(column, c_type, value);
+    }
+    if (c_type == SQL_C_BINARY) {
+        const auto bytes = read<std::vector<uint8_t>>(column, {});
+        if (cursor_is_null(column)) {
+            return false;
+        }
+        assign_bytes(value, bytes.data(), bytes.size());
+        return true;
+    }
+
+    const auto text = read<std::string>(column, {});
+    if (cursor_is_null(column)) {
+        return false;
+    }
+    assign_bytes(value, reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    return true;
+}
+
+bool ResultSet::get_decimal(short column, CDecimal& value) {
+    const ColumnDescriptor& column_descriptor = descriptor(column);
+    DecimalDigits digits;
+    switch (column_descriptor.sql_type) {
+        case SQL_DECIMAL:
+        case SQL_NUMERIC:
+            if (!is_buffered() && column_descriptor.accessor == ColumnAccessor::Decimal) {
+                if (cursor_is_null(column)) {
+                    return false;
+                }
+                const std::string text = decimal_text(column);
+                if (!digits.parse(text.data(), text.size())) {
+                    throw nanodbc::type_incompatible_error();
+                }
+                digits.rescale(column_descriptor.scale);
+                digits.store(value);
+                return true;
+            }
+            if (!is_buffered() && !is_bound(column) && !numeric_unsupported_ && read_numeric(column, value)) {
+                return !is_null(column);
+            }
+            if (is_buffered() && column_descriptor.batch_type == COLUMN_BATCH_DOUBLE) {
+                // rows of a single-row cursor are buffered with the double nanodbc reads them as
+                const double number = get<double>(column, 0.0);
+                if (is_null(column)) {
+                    return false;
+                }
+                char buffer[32];
+                const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+                if (ec != std::errc() || !digits.parse(buffer, static_cast<size_t>(end - buffer))) {
+                    throw nanodbc::type_incompatible_error();
+                }
+                digits.rescale(column_descriptor.scale);
+                digits.store(value);
+                return true;
+            }
+            break;
+        case SQL_BIT:
+        case SQL_TINYINT:
+        case SQL_SMALLINT:
+        case SQL_INTEGER:
+        case SQL_BIGINT: {
+            const int64_t number = get<int64_t>(column, 0);
+            if (is_null(column)) {
+                return false;
+            }
+            value.unscaled_low = static_cast<uint64_t>(number);
+            value.unscaled_high = number < 0 ? -1 : 0;
+            value.scale = 0;
+            return true;
+        }
+        default:
+            break;
+    }
+
+    const ApiString* text = get_text(column);
+    // an empty string has no number in it, getBigDecimal reads it as null
+    if (!text || text->empty()) {
+        return false;
+    }
+    if (!digits.parse(text->data(), text->size())) {
+        throw nanodbc::type_incompatible_error();
+    }
+    digits.store(value);
+    return true;
+}
+
+int ResultSet::fetch_batch(ColumnBatch& batch, int max_rows) {
+    if (is_buffered()) {
+        throw std::logic_error("Batch reads are not available while rows are buffered");
+    }
+    on_row_changed();
+    return fill_batch(batch, max_rows);
+}
+
+int ResultSet::fill_batch(ColumnBatch& batch, int max_rows) {
+    // also runs on the prefetch worker, so only the cursor, its rowset row and the direct indicators are touched
+    const short column_count = columns();
+    batch.reset(column_count, max_rows);
+    for (short column = 0; column < column_count; ++column) {
+        batch.columns[column].reset(column_batch_type(column), max_rows);
+    }
+
+    int32_t rows = 0;
+    while (rows < max_rows) {
+        reset_direct_nulls();
+        const bool had_rows = result::rows() != 0;
+        const bool moved = result::next();
+        follow_rowset(had_rows, rowset_row_ + 1);
+        if (!moved) {
+            break;
+        }
+        for (short column = 0; column < column_count; ++column) {
+            copy_to_batch(batch.columns[column], column, rows);
+        }
+        batch.row_count = ++rows;
+    }
+    return rows;
+}
+
+void ResultSet::pack_row(RowLayout& layout) const {
+    if (layout.pending && packed_layout_ == &layout) {
+        return;
+    }
+    packed_layout_ = &layout;
+    layout.begin_row();
+    for (short column = 0; column < layout.column_count; ++column) {
+        switch (layout.types[column]) {
+            case COLUMN_BATCH_INT32: {
+                const int32_t value = get<int32_t>(column, 0);
+                if (!is_null(column)) {
+                    layout.append(&value, sizeof(value));
+                    continue;
+                }
+                break;
+            }
+            case COLUMN_BATCH_INT64: {
+                const int64_t value = get<int64_t>(column, 0);
+                if (!is_null(column)) {
+                    layout.append(&value, sizeof(value));
+                    continue;
+                }
+                break;
+            }
+            case COLUMN_BATCH_DOUBLE: {
+                const double value = get<double>(column, 0.0);
+                if (!is_null(column)) {
+                    layout.append(&value, sizeof(value));
+                    continue;
+                }
+                break;
+            }
+            case COLUMN_BATCH_BINARY: {
+                const auto value = get<std::vector<uint8_t>>(column, {});
+                if (!is_null(column)) {
+                    layout.append_prefixed(value.data(), value.size());
+                    continue;
+                }
+                break;
+            }
+            default: {
+                const auto value = static_cast<ApiString>(StringProxy(get<nanodbc::string>(column, {})));
+                if (!is_null(column)) {
+                    layout.append_prefixed(value.data(), value.size() * sizeof(ApiChar));
+                    continue;
+                }
+                break;
+            }
+        }
+        layout.set_null(column);
+    }
+}
+
+short ResultSet::find_column(nanodbc::string const& column_name) const {
+    if (!name_index_built_) {
+        name_index_.build(*this);
+        name_index_built_ = true;
+    }
+    const short column = name_index_.find(column_name);
+    if (column < 0) {
+        throw nanodbc::index_range_error();
+    }
+    return column;
 }
 
 void ResultSet::set_alias_column_name(nanodbc::string const &alias_column_name, short column) {
     if (column >= 0 && column < columns()) {
         aliases.insert(alias_column_name, column);
+        if (!name_index_built_) {
+            name_index_.build(*this);
+            name_index_built_ = true;
+        }
+        name_index_.insert(alias_column_name, column, true);
     }
 }
 
@@ -36,12 +522,528 @@ nanodbc::string ResultSet::map_column_name(nanodbc::string const &column_name, s
     return column_name;
 }
 
-bool ResultSet::is_string_or_binary(short column) const {
-    auto datatype = column_c_datatype(column);
-    return datatype == SQL_C_CHAR || datatype == SQL_C_BINARY;
+void ResultSet::describe_columns() {
+    const short count = columns();
+    descriptors_.clear();
+    descriptors_.reserve(count);
+    for (short column = 0; column < count; ++column) {
+        ColumnDescriptor descriptor;
+        descriptor.c_type = static_cast<short>(column_c_datatype(column));
+        descriptor.batch_type = batch_type_of(descriptor.c_type);
+        descriptor.accessor = accessor_of(descriptor.c_type);
+
+        SQLSMALLINT sql_type = 0;
+        SQLULEN size = 0;
+        SQLSMALLINT scale = 0;
+        SQLSMALLINT nullable = SQL_NULLABLE_UNKNOWN;
+        const RETCODE rc = NANODBC_FUNC(SQLDescribeCol)(
+            native_statement_handle(),
+            static_cast<SQLUSMALLINT>(column + 1),
+            nullptr,
+            0,
+            nullptr,
+            &sql_type,
+            &size,
+            &scale,
+            &nullable);
+        if (SQL_SUCCEEDED(rc)) {
+            descriptor.sql_type = sql_type;
+            descriptor.size = static_cast<unsigned long>(size);
+            descriptor.scale = scale;
+            descriptor.nullable = nullable;
+        } else {
+            descriptor.sql_type = static_cast<short>(column_datatype(column));
+        }
+        descriptors_.push_back(descriptor);
+    }
+}
+
+void ResultSet::on_row_changed() {
+    // while prefetching the direct indicators belong to the worker
+    if (!prefetcher_) {
+        reset_direct_nulls();
+    }
+    text_column_ = -1;
+    text_null_ = false;
+    text_.clear();
+    packed_layout_ = nullptr;
+    if (value_arena_) {
+        value_arena_->reset();
+    }
 }
 
-bool ResultSet::is_string_or_binary(const nanodbc::string& column_name) const {
-    auto datatype = column_c_datatype(column_name);
-    return datatype == SQL_C_CHAR || datatype == SQL_C_BINARY;
-}
\ No newline at end of file
+void ResultSet::reset_direct_nulls() {
+    if (!direct_nulls_.empty()) {
+        std::fill(direct_nulls_.begin(), direct_nulls_.end(), -1);
+    }
+}
+
+void ResultSet::ensure_scrollable() const {
+    if (prefetcher_) {
+        throw std::logic_error("The cursor is forward-only while prefetching");
+    }
+}
+
+bool ResultSet::next_prefetched() {
+    if (prefetched_ && prefetched_row_ + 1 < prefetched_->row_count) {
+        ++prefetched_row_;
+        ++prefetched_position_;
+        return true;
+    }
+    prefetched_ = nullptr;
+    prefetched_row_ = -1;
+    // rethrows a fetch error of the worker
+    const ColumnBatch* batch = prefetcher_->next_batch();
+    if (!batch) {
+        return false;
+    }
+    prefetched_ = batch;
+    prefetched_row_ = 0;
+    ++prefetched_position_;
+    return true;
+}
+
+BufferedValue ResultSet::buffered_value(short column) const {
+    descriptor(column);
+    if (row_cache_) {
+        return row_cache_->value(column);
+    }
+    if (!prefetched_) {
+        throw std::logic_error("No current row");
+    }
+
+    const ColumnBatch::Column& values = prefetched_->columns[column];
+    const auto row = static_cast<size_t>(prefetched_row_);
+    BufferedValue value;
+    value.type = values.type;
+    if ((values.nulls[row >> 3] >> (row & 7) & 1) != 0) {
+        return value;
+    }
+    switch (values.type) {
+        case COLUMN_BATCH_INT32:
+            value.size = sizeof(int32_t);
+            value.data = values.values + row * value.size;
+            break;
+        case COLUMN_BATCH_INT64:
+            value.size = sizeof(int64_t);
+            value.data = values.values + row * value.size;
+            break;
+        case COLUMN_BATCH_DOUBLE:
+            value.size = sizeof(double);
+            value.data = values.values + row * value.size;
+            break;
+        default:
+            value.data = values.values + values.offsets[row];
+            value.size = static_cast<size_t>(values.offsets[row + 1] - values.offsets[row]);
+            break;
+    }
+    return value;
+}
+
+ApiString ResultSet::buffered_text(const BufferedValue& value) {
+    switch (value.type) {
+        case COLUMN_BATCH_INT32:
+        case COLUMN_BATCH_INT64:
+        case COLUMN_BATCH_DOUBLE: {
+            char buffer[32];
+            std::to_chars_result converted{};
+            if (value.type == COLUMN_BATCH_INT32) {
+                converted = std::to_chars(buffer, buffer + sizeof(buffer), buffered_fixed<int32_t>(value));
+            } else if (value.type == COLUMN_BATCH_INT64) {
+                converted = std::to_chars(buffer, buffer + sizeof(buffer), buffered_fixed<int64_t>(value));
+            } else {
+                converted = std::to_chars(buffer, buffer + sizeof(buffer), buffered_fixed<double>(value));
+            }
+            return ApiString(buffer, converted.ptr);
+        }
+        case COLUMN_BATCH_BINARY: {
+            const std::string bytes(reinterpret_cast<const char*>(value.data), value.size);
+            return static_cast<ApiString>(StringProxy(bytes));
+        }
+        default: {
+            // packed rows are unaligned, so the text is copied bytewise
+            ApiString text(value.size / sizeof(ApiChar), ApiChar());
+            if (!text.empty()) {
+                std::memcpy(text.data(), value.data, text.size() * sizeof(ApiChar));
+            }
+            return text;
+        }
+    }
+}
+
+std::vector<uint8_t> ResultSet::buffered_bytes(const BufferedValue& value) {
+    if (value.type != COLUMN_BATCH_BINARY) {
+        throw nanodbc::type_incompatible_error();
+    }
+    return std::vector<uint8_t>(value.data, value.data + value.size);
+}
+
+nanodbc::timestamp ResultSet::buffered_timestamp(short column, const BufferedValue& value) const {
+    if (value.type != COLUMN_BATCH_STRING) {
+        throw nanodbc::type_incompatible_error();
+    }
+
+    // date and time columns are buffered as text: digit groups in order, the fraction after '.'
+    const ApiString text = buffered_text(value);
+    int32_t fields[6] = {};
+    int32_t fraction = 0;
+    size_t field_count = 0;
+    size_t i = 0;
+    while (i < text.size() && field_count < 6) {
+        if (text[i] < '0' || text[i] > '9') {
+            ++i;
+            continue;
+        }
+        int32_t number = 0;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+            number = number * 10 + static_cast<int32_t>(text[i] - '0');
+        }
+        fields[field_count++] = number;
+    }
+    if (i < text.size() && text[i] == '.') {
+        int32_t scale = 1000000000;
+        for (++i; i < text.size() && text[i] >= '0' && text[i] <= '9' && scale > 1; ++i) {
+            scale /= 10;
+            fraction += static_cast<int32_t>(text[i] - '0') * scale;
+        }
+    }
+    if (field_count < 3) {
+        throw nanodbc::type_incompatible_error();
+    }
+
+    nanodbc::timestamp timestamp{};
+    const short sql_type = descriptor(column).sql_type;
+    if (sql_type == SQL_TYPE_TIME || sql_type == SQL_TIME) {
+        timestamp.hour = static_cast<std::int16_t>(fields[0]);
+        timestamp.min = static_cast<std::int16_t>(fields[1]);
+        timestamp.sec = static_cast<std::int16_t>(fields[2]);
+        timestamp.fract = fraction;
+        return timestamp;
+    }
+    timestamp.year = static_cast<std::int16_t>(fields[0]);
+    timestamp.month = static_cast<std::int16_t>(fields[1]);
+    timestamp.day = static_cast<std::int16_t>(fields[2]);
+    timestamp.hour = static_cast<std::int16_t>(fields[3]);
+    timestamp.min = static_cast<std::int16_t>(fields[4]);
+    timestamp.sec = static_cast<std::int16_t>(fields[5]);
+    timestamp.fract = fraction;
+    return timestamp;
+}
+
+bool ResultSet::read_wide_text(short column, ApiString& value) const {
+    static_assert(sizeof(ApiChar) == sizeof(SQLWCHAR), "ApiChar must match SQLWCHAR");
+    static constexpr size_t INITIAL_CHARS = 256;
+
+    if (direct_nulls_.empty()) {
+        direct_nulls_.assign(columns(), -1);
+    }
+
+    // read directly into the string storage, growing it while the driver reports truncation
+    size_t length = 0;
+    value.resize(INITIAL_CHARS);
+    while (true) {
+        const size_t room = value.size() - length;
+        SQLLEN indicator = 0;
+        const RETCODE rc = SQLGetData(
+            native_statement_handle(),
+            static_cast<SQLUSMALLINT>(column + 1),
+            SQL_C_WCHAR,
+            value.data() + length,
+            static_cast<SQLLEN>(room * sizeof(ApiChar)),
+            &indicator);
+        if (rc == SQL_NO_DATA) {
+            break;
+        }
+        if (!SQL_SUCCEEDED(rc)) {
+            NANODBC_THROW_DATABASE_ERROR(native_statement_handle(), SQL_HANDLE_STMT);
+        }
+        if (indicator == SQL_NULL_DATA) {
+            direct_nulls_[column] = 1;
+            value.clear();
+            return false;
+        }
+        if (rc == SQL_SUCCESS) {
+            length += static_cast<size_t>(indicator) / sizeof(ApiChar);
+            break;
+        }
+
+        // truncated: room - 1 characters were written followed by the terminator
+        length += room - 1;
+        size_t required = value.size() * 2;
+        if (indicator != SQL_NO_TOTAL) {
+            required = std::max(required, length + static_cast<size_t>(indicator) / sizeof(ApiChar) - (room - 1) + 1);
+        }
+        value.resize(required);
+    }
+    value.resize(length);
+    direct_nulls_[column] = 0;
+    return true;
+}
+
+bool ResultSet::read_bytes(short column, short c_type, BinaryArray& value) const {
+    static constexpr size_t PROBE_SIZE = 256;
+
+    if (direct_nulls_.empty()) {
+        direct_nulls_.assign(columns(), -1);
+    }
+
+    // character data is followed by a terminator, which takes one byte of every buffer
+    const size_t terminator = c_type == SQL_C_CHAR ? 1 : 0;
+    const auto get_data = [&](void* target, size_t capacity, SQLLEN& indicator) {
+        const RETCODE rc = SQLGetData(
+            native_statement_handle(),
+            static_cast<SQLUSMALLINT>(column + 1),
+            c_type,
+            target,
+            static_cast<SQLLEN>(capacity),
+            &indicator);
+        if (rc != SQL_NO_DATA && !SQL_SUCCEEDED(rc)) {
+            NANODBC_THROW_DATABASE_ERROR(native_statement_handle(), SQL_HANDLE_STMT);
+        }
+        return rc;
+    };
+
+    // short values fit the probe; a longer one reports its length, which sizes the array
+    uint8_t probe[PROBE_SIZE];
+    SQLLEN indicator = 0;
+    RETCODE rc = get_data(probe, PROBE_SIZE, indicator);
+    if (rc == SQL_NO_DATA) {
+        assign_bytes(value, nullptr, 0);
+        direct_nulls_[column] = 0;
+        return true;
+    }
+    if (indicator == SQL_NULL_DATA) {
+        direct_nulls_[column] = 1;
+        return false;
+    }
+    const auto fits = [terminator](SQLLEN indicator, size_t room) {
+        return indicator != SQL_NO_TOTAL && static_cast<size_t>(indicator) + terminator <= room;
+    };
+    if (fits(indicator, PROBE_SIZE)) {
+        assign_bytes(value, probe, static_cast<size_t>(indicator));
+        direct_nulls_[column] = 0;
+        return true;
+    }
+
+    size_t length = PROBE_SIZE - terminator;
+    size_t capacity = indicator == SQL_NO_TOTAL ? PROBE_SIZE * 2 : static_cast<size_t>(indicator) + terminator;
+    int8_t* data = allocate_bytes(capacity);
+    std::memcpy(data, probe, length);
+    try {
+        while (true) {
+            const size_t room = capacity - length;
+            rc = get_data(data + length, room, indicator);
+            if (rc == SQL_NO_DATA) {
+                break;
+            }
+            if (fits(indicator, room)) {
+                length += static_cast<size_t>(indicator);
+                break;
+            }
+
+            // the length was not known or has changed: keep what was written and grow
+            length += room - terminator;
+            size_t required = capacity * 2;
+            if (indicator != SQL_NO_TOTAL) {
+                required = std::max(required, length + static_cast<size_t>(indicator) - (room - terminator) + terminator);
+            }
+            int8_t* grown = allocate_bytes(required);
+            std::memcpy(grown, data, length);
+            release_bytes(std::exchange(data, grown));
+            capacity = required;
+        }
+    } catch (...) {
+        release_bytes(data);
+        throw;
+    }
+
+    release_bytes(value.data);
+    value.data = data;
+    value.length = static_cast<int32_t>(length);
+    direct_nulls_[column] = 0;
+    return true;
+}
+
+int8_t* ResultSet::allocate_bytes(size_t size) const {
+    return value_arena_ ? static_cast<int8_t*>(value_arena_->allocate(size, 1)) : new int8_t[size];
+}
+
+void ResultSet::release_bytes(int8_t* data) const {
+    // arena memory goes with the row
+    if (!value_arena_) {
+        delete[] data;
+    }
+}
+
+void ResultSet::assign_bytes(BinaryArray& value, const uint8_t* data, size_t size) const {
+    release_bytes(value.data);
+    value.data = nullptr;
+    value.length = static_cast<int32_t>(size);
+    if (size > 0) {
+        value.data = allocate_bytes(size);
+        std::memcpy(value.data, data, size);
+    }
+}
+
+bool ResultSet::read_numeric(short column, CDecimal& value) const {
+    const ColumnDescriptor& column_descriptor = descriptor(column);
+    const HSTMT statement = native_statement_handle();
+    const auto record = static_cast<SQLSMALLINT>(column + 1);
+
+    if (direct_nulls_.empty()) {
+        direct_nulls_.assign(columns(), -1);
+    }
+
+    // the default scale of SQL_C_NUMERIC is 0, so precision and scale go into the ARD record
+    // and SQLGetData is told to use it; setting the type resets both, so it comes first
+    SQLHDESC row_descriptor = nullptr;
+    RETCODE rc = SQLGetStmtAttr(statement, SQL_ATTR_APP_ROW_DESC, &row_descriptor, 0, nullptr);
+    if (SQL_SUCCEEDED(rc)) {
+        rc = SQLSetDescField(row_descriptor, record, SQL_DESC_TYPE, reinterpret_cast<SQLPOINTER>(static_cast<SQLLEN>(SQL_C_NUMERIC)), 0);
+    }
+    if (SQL_SUCCEEDED(rc)) {
+        rc = SQLSetDescField(row_descriptor, record, SQL_DESC_PRECISION, reinterpret_cast<SQLPOINTER>(static_cast<SQLLEN>(column_descriptor.size)), 0);
+    }
+    if (SQL_SUCCEEDED(rc)) {
+        rc = SQLSetDescField(row_descriptor, record, SQL_DESC_SCALE, reinterpret_cast<SQLPOINTER>(static_cast<SQLLEN>(column_descriptor.scale)), 0);
+    }
+
+    SQL_NUMERIC_STRUCT numeric{};
+    SQLLEN indicator = 0;
+    if (SQL_SUCCEEDED(rc)) {
+        rc = SQLGetData(statement, static_cast<SQLUSMALLINT>(record), SQL_ARD_TYPE, &numeric, sizeof(numeric), &indicator);
+    }
+    if (!SQL_SUCCEEDED(rc)) {
+        numeric_unsupported_ = true;
+        return false;
+    }
+    if (indicator == SQL_NULL_DATA) {
+        direct_nulls_[column] = 1;
+        return true;
+    }
+
+    // val holds the magnitude little-endian, sign is 1 for positive values
+    DecimalDigits digits;
+    for (int i = 7; i >= 0; --i) {
+        digits.low = digits.low << 8 | numeric.val[i];
+        digits.high = digits.high << 8 | numeric.val[i + 8];
+    }
+    digits.negative = numeric.sign == 0;
+    digits.scale = numeric.scale;
+    digits.store(value);
+    direct_nulls_[column] = 0;
+    return true;
+}
+
+bool ResultSet::has_unbound_columns() const {
+    for (short column = 0; column < columns(); ++column) {
+        if (!is_bound(column)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResultSet::bind_decimals() {
+    // nanodbc binds DECIMAL and NUMERIC as SQL_C_DOUBLE, which loses digits; the rowset is
+    // not fetched yet, so rebinding them as text here applies from the first block on
+    const auto rows = static_cast<size_t>(rowset_size());
+    for (ColumnDescriptor& column_descriptor : descriptors_) {
+        if (column_descriptor.sql_type != SQL_DECIMAL && column_descriptor.sql_type != SQL_NUMERIC) {
+            continue;
+        }
+        const auto column = static_cast<short>(&column_descriptor - descriptors_.data());
+        BoundDecimal bound;
+        bound.column = column;
+        bound.text.resize(rows * BoundDecimal::WIDTH);
+        bound.lengths.resize(rows);
+        static_assert(sizeof(std::intptr_t) == sizeof(SQLLEN), "BoundDecimal lengths must match SQLLEN");
+        const RETCODE rc = SQLBindCol(
+            native_statement_handle(),
+            static_cast<SQLUSMALLINT>(column + 1),
+            SQL_C_CHAR,
+            bound.text.data(),
+            static_cast<SQLLEN>(BoundDecimal::WIDTH),
+            reinterpret_cast<SQLLEN*>(bound.lengths.data()));
+        if (!SQL_SUCCEEDED(rc)) {
+            NANODBC_THROW_DATABASE_ERROR(native_statement_handle(), SQL_HANDLE_STMT);
+        }
+        column_descriptor.c_type = SQL_C_CHAR;
+        column_descriptor.batch_type = COLUMN_BATCH_STRING;
+        column_descriptor.accessor = ColumnAccessor::Decimal;
+        bound_decimals_.push_back(std::move(bound));
+    }
+}
+
+const BoundDecimal& ResultSet::bound_decimal(short column) const {
+    for (const BoundDecimal& bound : bound_decimals_) {
+        if (bound.column == column) {
+            return bound;
+        }
+    }
+    throw nanodbc::index_range_error();
+}
+
+bool ResultSet::decimal_is_null(short column) const {
+    return bound_decimal(column).lengths[rowset_row_] == SQL_NULL_DATA;
+}
+
+std::string ResultSet::decimal_text(short column) const {
+    const BoundDecimal& bound = bound_decimal(column);
+    const auto length = static_cast<SQLLEN>(bound.lengths[rowset_row_]);
+    if (length == SQL_NULL_DATA) {
+        throw nanodbc::null_access_error();
+    }
+    // SQL_NO_TOTAL or a truncated value cannot be a number that fits CDecimal
+    if (length < 0 || length >= static_cast<SQLLEN>(BoundDecimal::WIDTH)) {
+        throw nanodbc::type_incompatible_error();
+    }
+    return std::string(bound.text.data() + static_cast<size_t>(rowset_row_) * BoundDecimal::WIDTH,
+                       static_cast<size_t>(length));
+}
+
+void ResultSet::follow_rowset(bool had_rows, long row) {
+    // nanodbc keeps its row of the rowset private: it stays in the rowset while the rowset
+    // holds rows and the target is inside it, otherwise a new rowset is read from its start
+    rowset_row_ = had_rows && row >= 0 && row < rowset_size() ? row : 0;
+}
+
+void ResultSet::copy_to_batch(ColumnBatch::Column& target, short column, int32_t row) const {
+    // for unbound columns, null indicator is determined by SQLGetData call, so the null check follows the read
+    switch (target.type) {
+        case COLUMN_BATCH_INT32: {
+            const int32_t value = read<int32_t>(column, 0);
+            target.put_fixed(row, &value, sizeof(value));
+            break;
+        }
+        case COLUMN_BATCH_INT64: {
+            const int64_t value = read<int64_t>(column, 0);
+            target.put_fixed(row, &value, sizeof(value));
+            break;
+        }
+        case COLUMN_BATCH_DOUBLE: {
+            const double value = read<double>(column, 0.0);
+            target.put_fixed(row, &value, sizeof(value));
+            break;
+        }
+        case COLUMN_BATCH_BINARY: {
+            const auto value = read<std::vector<uint8_t>>(column, {});
+            if (!cursor_is_null(column)) {
+                target.put_variable(row, value.data(), value.size());
+                return;
+            }
+            break;
+        }
+        default: {
+            const auto value = static_cast<ApiString>(StringProxy(read<nanodbc::string>(column, {})));
+            if (!cursor_is_null(column)) {
+                target.put_variable(row, value.data(), value.size() * sizeof(ApiChar));
+                return;
+            }
+            break;
+        }
+    }
+    if (cursor_is_null(column)) {
+        target.set_null(row);
+    }
+}
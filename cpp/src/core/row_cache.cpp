@@ -0,0 +1,296 @@
+#include "core/row_cache.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/// \brief Temporary file holding spilled rows, mapped into memory for reading and writing.
+///
+/// The file grows geometrically and is remapped on growth, so pointers into it stay
+/// valid until the next append. It is removed when closed, also if the process dies.
+class SpillFile {
+public:
+    SpillFile() {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+#ifdef _WIN32
+        wchar_t path[MAX_PATH];
+        if (GetTempFileNameW(directory.c_str(), L"ndb", 0, path) == 0) {
+            throw_last_error("Cannot create row cache file");
+        }
+        file_ = CreateFileW(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw_last_error("Cannot open row cache file");
+        }
+#else
+        std::string path = (directory / "nanodbc4j-rows-XXXXXX").string();
+        fd_ = mkstemp(path.data());
+        if (fd_ < 0) {
+            throw_last_error("Cannot create row cache file");
+        }
+        // the open descriptor keeps the data, the name is not needed
+        unlink(path.c_str());
+#endif
+    }
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    ~SpillFile() {
+        unmap();
+#ifdef _WIN32
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+#else
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    /// Appends the bytes and returns their offset in the file.
+    uint64_t append(const uint8_t* data, size_t length) {
+        if (size_ + length > capacity_) {
+            grow(std::max<uint64_t>({size_ + length, capacity_ * 2, INITIAL_CAPACITY}));
+        }
+        const uint64_t offset = size_;
+        std::memcpy(view_ + offset, data, length);
+        size_ += length;
+        return offset;
+    }
+
+    const uint8_t* at(uint64_t offset) const {
+        return view_ + offset;
+    }
+
+    uint64_t size() const {
+        return size_;
+    }
+
+private:
+    static constexpr uint64_t INITIAL_CAPACITY = 4 << 20;
+
+    [[noreturn]] static void throw_last_error(const char* message) {
+#ifdef _WIN32
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), message);
+#else
+        throw std::system_error(errno, std::generic_category(), message);
+#endif
+    }
+
+    void grow(uint64_t capacity) {
+        unmap();
+#ifdef _WIN32
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READWRITE,
+                                      static_cast<DWORD>(capacity >> 32), static_cast<DWORD>(capacity), nullptr);
+        if (!mapping_) {
+            throw_last_error("Cannot extend row cache file");
+        }
+        view_ = static_cast<uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        if (!view_) {
+            throw_last_error("Cannot map row cache file");
+        }
+#else
+        if (ftruncate(fd_, static_cast<off_t>(capacity)) != 0) {
+            throw_last_error("Cannot extend row cache file");
+        }
+        void* view = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (view == MAP_FAILED) {
+            throw_last_error("Cannot map row cache file");
+        }
+        view_ = static_cast<uint8_t*>(view);
+#endif
+        capacity_ = capacity;
+    }
+
+    void unmap() {
+        if (!view_) {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(view_);
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        munmap(view_, capacity_);
+#endif
+        view_ = nullptr;
+    }
+
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    uint8_t* view_ = nullptr;
+    uint64_t size_ = 0;
+    uint64_t capacity_ = 0;
+};
+
+RowCache::RowCache(FetchFunction fetch, const std::vector<int32_t>& column_types, size_t memory_budget)
+        : fetch_(std::move(fetch)), memory_budget_(memory_budget) {
+    layout_.set_types(column_types.data(), static_cast<int32_t>(column_types.size()));
+    values_.resize(column_types.size());
+}
+
+// out of line, SpillFile is complete here
+RowCache::~RowCache() = default;
+
+bool RowCache::move_to(int64_t index) {
+    if (index < 0) {
+        current_ = -1;
+        return false;
+    }
+    fetch_until(index);
+    if (index >= static_cast<int64_t>(entries_.size())) {
+        current_ = static_cast<int64_t>(entries_.size());
+        return false;
+    }
+    current_ = index;
+    decode(entries_[static_cast<size_t>(index)]);
+    return true;
+}
+
+bool RowCache::last() {
+    fetch_until(INT64_MAX);
+    return move_to(static_cast<int64_t>(entries_.size()) - 1);
+}
+
+bool RowCache::absolute(int64_t row) {
+    if (row > 0) {
+        return move_to(row - 1);
+    }
+    if (row == 0) {
+        return move_to(-1);
+    }
+    fetch_until(INT64_MAX);
+    return move_to(static_cast<int64_t>(entries_.size()) + row);
+}
+
+const BufferedValue& RowCache::value(short column) const {
+    if (!on_row()) {
+        throw std::logic_error("No current row");
+    }
+    return values_.at(static_cast<size_t>(column));
+}
+
+uint64_t RowCache::spilled_bytes() const {
+    return spill_ ? spill_->size() : 0;
+}
+
+void RowCache::fetch_until(int64_t index) {
+    while (!exhausted_ && static_cast<int64_t>(entries_.size()) <= index) {
+        const int rows = fetch_(batch_, FETCH_ROWS);
+        if (rows == 0) {
+            exhausted_ = true;
+            break;
+        }
+        for (int32_t row = 0; row < rows; ++row) {
+            pack(row);
+            store(layout_.row, static_cast<size_t>(layout_.length));
+        }
+    }
+}
+
+void RowCache::pack(int32_t row) {
+    layout_.begin_row();
+    for (int32_t column = 0; column < batch_.column_count; ++column) {
+        const ColumnBatch::Column& values = batch_.columns[column];
+        if ((values.nulls[row >> 3] >> (row & 7) & 1) != 0) {
+            layout_.set_null(column);
+            continue;
+        }
+        switch (values.type) {
+            case COLUMN_BATCH_INT32:
+                layout_.append(values.values + static_cast<size_t>(row) * sizeof(int32_t), sizeof(int32_t));
+                break;
+            case COLUMN_BATCH_INT64:
+                layout_.append(values.values + static_cast<size_t>(row) * sizeof(int64_t), sizeof(int64_t));
+                break;
+            case COLUMN_BATCH_DOUBLE:
+                layout_.append(values.values + static_cast<size_t>(row) * sizeof(double), sizeof(double));
+                break;
+            default:
+                layout_.append_prefixed(values.values + values.offsets[row], values.offsets[row + 1] - values.offsets[row]);
+                break;
+        }
+    }
+}
+
+void RowCache::store(const uint8_t* row, size_t length) {
+    if (block_used_ + length > block_capacity_ && memory_used_ < memory_budget_) {
+        // a budget smaller than a block, or its remainder, still holds rows
+        const size_t block_size = std::max(std::min(BLOCK_SIZE, memory_budget_ - memory_used_), length);
+        if (memory_used_ + block_size <= memory_budget_) {
+            blocks_.push_back(std::make_unique<uint8_t[]>(block_size));
+            memory_used_ += block_size;
+            block_used_ = 0;
+            block_capacity_ = block_size;
+        } else {
+            // the budget is spent, later rows go to disk
+            memory_used_ = memory_budget_;
+        }
+    }
+
+    if (block_used_ + length <= block_capacity_) {
+        std::memcpy(blocks_.back().get() + block_used_, row, length);
+        entries_.push_back({block_used_, static_cast<uint32_t>(length), static_cast<int32_t>(blocks_.size() - 1)});
+        block_used_ += length;
+        return;
+    }
+
+    if (!spill_) {
+        spill_ = std::make_unique<SpillFile>();
+    }
+    const uint64_t offset = spill_->append(row, length);
+    entries_.push_back({offset, static_cast<uint32_t>(length), -1});
+}
+
+void RowCache::decode(const Entry& entry) {
+    const uint8_t* row = entry.block >= 0 ? blocks_[static_cast<size_t>(entry.block)].get() + entry.offset : spill_->at(entry.offset);
+    const uint8_t* cursor = row + (static_cast<size_t>(layout_.column_count) + 7) / 8;
+    for (int32_t column = 0; column < layout_.column_count; ++column) {
+        BufferedValue& value = values_[static_cast<size_t>(column)];
+        value.type = layout_.types[column];
+        if ((row[column >> 3] >> (column & 7) & 1) != 0) {
+            value.data = nullptr;
+            value.size = 0;
+            continue;
+        }
+        switch (value.type) {
+            case COLUMN_BATCH_INT32:
+                value.size = sizeof(int32_t);
+                break;
+            case COLUMN_BATCH_INT64:
+                value.size = sizeof(int64_t);
+                break;
+            case COLUMN_BATCH_DOUBLE:
+                value.size = sizeof(double);
+                break;
+            default: {
+                int32_t length = 0;
+                std::memcpy(&length, cursor, sizeof(length));
+                cursor += sizeof(length);
+                value.size = static_cast<size_t>(length);
+                break;
+            }
+        }
+        value.data = cursor;
+        cursor += value.size;
+    }
+}
@@ -0,0 +1,83 @@
+#include "core/row_prefetcher.hpp"
+#include <utility>
+
+RowPrefetcher::RowPrefetcher(FetchFunction fetch, int batch_rows)
+        : fetch_(std::move(fetch)), batch_rows_(batch_rows) {
+    worker_ = std::thread(&RowPrefetcher::run, this);
+}
+
+RowPrefetcher::~RowPrefetcher() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    changed_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+const ColumnBatch* RowPrefetcher::next_batch() {
+    std::unique_lock lock(mutex_);
+    if (consumed_slot_ >= 0) {
+        states_[consumed_slot_] = SlotState::Free;
+        consumed_slot_ = -1;
+        changed_.notify_all();
+    }
+
+    // both sides walk the slots in the same order, so the next slot is the oldest batch
+    changed_.wait(lock, [this] { return states_[next_slot_] == SlotState::Ready || finished_; });
+    if (states_[next_slot_] == SlotState::Ready) {
+        states_[next_slot_] = SlotState::Consumed;
+        consumed_slot_ = next_slot_;
+        next_slot_ ^= 1;
+        return &batches_[consumed_slot_];
+    }
+
+    if (error_) {
+        std::exception_ptr error = std::exchange(error_, nullptr);
+        std::rethrow_exception(error);
+    }
+    return nullptr;
+}
+
+std::unique_lock<std::mutex> RowPrefetcher::lock_cursor() {
+    return std::unique_lock(cursor_mutex_);
+}
+
+void RowPrefetcher::run() {
+    int slot = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            changed_.wait(lock, [this, slot] { return stop_ || states_[slot] == SlotState::Free; });
+            if (stop_) {
+                return;
+            }
+        }
+
+        int rows = 0;
+        std::exception_ptr error;
+        try {
+            std::lock_guard cursor(cursor_mutex_);
+            rows = fetch_(batches_[slot], batch_rows_);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard lock(mutex_);
+        if (error || rows == 0) {
+            // the rows copied before the failure are handed out ahead of the error
+            if (error && batches_[slot].row_count > 0) {
+                states_[slot] = SlotState::Ready;
+            }
+            error_ = error;
+            finished_ = true;
+            changed_.notify_all();
+            return;
+        }
+        states_[slot] = SlotState::Ready;
+        slot ^= 1;
+        changed_.notify_all();
+    }
+}
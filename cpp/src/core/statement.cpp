@@ -0,0 +1,191 @@
+#include "core/statement.hpp"
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+// needs to be included above sql.h for windows
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#include <sqlext.h>
+#include "core/nanodbc_defs.h"
+
+namespace {
+    /// Points the statement at the row status array of execute_batch, until destroyed.
+    class ParameterArray {
+    public:
+        ParameterArray(HSTMT handle, SQLUSMALLINT* status)
+            : handle_(handle) {
+            SQLSetStmtAttr(handle_, SQL_ATTR_PARAM_STATUS_PTR, status, 0);
+        }
+
+        ParameterArray(const ParameterArray&) = delete;
+        ParameterArray& operator=(const ParameterArray&) = delete;
+
+        ~ParameterArray() {
+            SQLSetStmtAttr(handle_, SQL_ATTR_PARAM_STATUS_PTR, nullptr, 0);
+            SQLSetStmtAttr(handle_, SQL_ATTR_PARAMSET_SIZE, reinterpret_cast<SQLPOINTER>(1), 0);
+        }
+
+    private:
+        HSTMT handle_;
+    };
+
+    /// Returns true if the driver reports the row count of each row of a parameter array.
+    bool has_row_counts(SQLHDBC connection) {
+        SQLUINTEGER counts = SQL_PARC_NO_BATCH;
+        const SQLRETURN rc = SQLGetInfo(connection, SQL_PARAM_ARRAY_ROW_COUNTS, &counts, sizeof(counts), nullptr);
+        return SQL_SUCCEEDED(rc) && counts == SQL_PARC_BATCH;
+    }
+}
+
+Statement::Statement(Connection& conn)
+    : statement(conn)
+    , wide_char_fetch_(conn.get_wide_char_fetch()) {
+}
+
+bool Statement::get_wide_char_fetch() const {
+    return wide_char_fetch_;
+}
+
+void Statement::prepare(const nanodbc::string& query, long timeout) {
+    clear_batch();
+    // bindings outlive SQLPrepare, and the parameters of the new SQL differ
+    reset_parameters();
+    parameters_.clear();
+    statement::prepare(query, timeout);
+}
+
+void Statement::execute_once(long timeout) {
+    if (!parameters_.has_streams()) {
+        just_execute(1, timeout);
+        return;
+    }
+
+    const HSTMT handle = native_statement_handle();
+    this->timeout(timeout);
+    SQLSetStmtAttr(handle, SQL_ATTR_PARAMSET_SIZE, reinterpret_cast<SQLPOINTER>(1), 0);
+    SQLRETURN rc = SQLExecute(handle);
+    try {
+        while (rc == SQL_NEED_DATA) {
+            SQLPOINTER token = nullptr;
+            rc = SQLParamData(handle, &token);
+            if (rc == SQL_NEED_DATA) {
+                parameters_.put_stream(*this, token);
+            }
+        }
+    } catch (...) {
+        // leaves the data-at-execution state, so the statement can be executed again
+        SQLCancel(handle);
+        throw;
+    }
+    if (!SQL_SUCCEEDED(rc) && rc != SQL_NO_DATA) {
+        NANODBC_THROW_DATABASE_ERROR(handle, SQL_HANDLE_STMT);
+    }
+}
+
+void Statement::add_batch() {
+    // a row missing values would leave its parameters NULL without telling anyone
+    batch_.add(parameters_.values(static_cast<size_t>(parameters())));
+}
+
+void Statement::bind_string_column(short index, const nanodbc::string::value_type* data, size_t length,
+                                   const int32_t* offsets, const uint8_t* nulls, size_t rows) {
+    columns_.bind_strings(*this, index, data, length, offsets, nulls, rows);
+}
+
+void Statement::execute_batch(long timeout, std::vector<int>& row_counts) {
+    const bool columns = columns_.rows() != 0;
+    if (columns && batch_.rows() != 0) {
+        clear_batch();
+        throw std::logic_error("Rows added to the batch cannot be executed together with parameter columns");
+    }
+    if (columns && columns_.bound() != static_cast<size_t>(parameters())) {
+        const std::string message = "Only " + std::to_string(columns_.bound()) + " of "
+                                    + std::to_string(parameters()) + " parameters are bound as columns";
+        clear_batch();
+        throw std::logic_error(message);
+    }
+    const size_t rows = columns ? columns_.rows() : batch_.rows();
+    row_counts.assign(rows, BATCH_EXECUTE_FAILED);
+    if (rows == 0) {
+        return;
+    }
+
+    // rows the driver does not report on keep this status
+    std::vector<SQLUSMALLINT> status(rows, SQL_PARAM_DIAG_UNAVAILABLE);
+    const HSTMT handle = native_statement_handle();
+    std::exception_ptr failure;
+    {
+        ParameterArray array(handle, status.data());
+        try {
+            if (!columns) {
+                batch_.bind(*this);
+            }
+            just_execute(static_cast<long>(rows), timeout);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+
+        const auto succeeded = [&failure](SQLUSMALLINT row_status) {
+            return row_status == SQL_PARAM_SUCCESS || row_status == SQL_PARAM_SUCCESS_WITH_INFO
+                || (row_status == SQL_PARAM_DIAG_UNAVAILABLE && !failure);
+        };
+        for (size_t row = 0; row < rows; ++row) {
+            row_counts[row] = succeeded(status[row]) ? BATCH_SUCCESS_NO_INFO : BATCH_EXECUTE_FAILED;
+        }
+        if (!failure && rows == 1) {
+            const long affected = affected_rows();
+            if (affected >= 0) {
+                row_counts[0] = static_cast<int>(affected);
+            }
+        } else if (!failure && has_row_counts(connection().native_dbc_handle())) {
+            // one result per row, most drivers give only the total for the whole array
+            SQLRETURN rc = SQL_SUCCESS;
+            for (size_t row = 0; row < rows && SQL_SUCCEEDED(rc); ++row) {
+                SQLLEN affected = -1;
+                if (row_counts[row] != BATCH_EXECUTE_FAILED && SQL_SUCCEEDED(SQLRowCount(handle, &affected))
+                    && affected >= 0) {
+                    row_counts[row] = static_cast<int>(affected);
+                }
+                rc = SQLMoreResults(handle);
+            }
+        }
+    }
+
+    reset_parameters();
+    batch_.clear();
+    columns_.clear();
+    parameters_.reset();
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void Statement::clear_batch() {
+    if (columns_.rows() != 0) {
+        // the parameters still point at the caller's arrays
+        reset_parameters();
+        parameters_.reset();
+    }
+    batch_.clear();
+    columns_.clear();
+}
+
+void Statement::attach_cache(std::weak_ptr<StatementCache> cache, StatementCache::Key key) {
+    cache_ = std::move(cache);
+    cache_key_ = std::move(key);
+}
+
+void Statement::recycle() {
+    // the last user may have left results unread
+    if (!SQL_SUCCEEDED(SQLFreeStmt(native_statement_handle(), SQL_CLOSE))) {
+        NANODBC_THROW_DATABASE_ERROR(native_statement_handle(), SQL_HANDLE_STMT);
+    }
+    clear_batch();
+    reset_parameters();
+    parameters_.reset();
+}
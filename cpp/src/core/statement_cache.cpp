@@ -0,0 +1,121 @@
+#include "core/statement_cache.hpp"
+#include <iterator>
+#include <utility>
+#include "core/statement.hpp"
+
+size_t StatementCache::KeyHash::operator()(const Key& key) const {
+    return std::hash<nanodbc::string>()(key.sql) ^ static_cast<size_t>(key.wide_char_fetch);
+}
+
+StatementCache::StatementCache(size_t capacity)
+        : capacity_(capacity) {
+}
+
+// out of line, Statement is complete here
+StatementCache::~StatementCache() = default;
+
+std::unique_ptr<Statement> StatementCache::borrow(const Key& key) {
+    std::lock_guard lock(mutex_);
+    const auto found = index_.find(key);
+    if (found == index_.end()) {
+        return nullptr;
+    }
+    const Entries::iterator entry = found->second;
+    index_.erase(found);
+    std::unique_ptr<Statement> statement = std::move(entry->statement);
+    entries_.erase(entry);
+    return statement;
+}
+
+void StatementCache::adopt(Statement& statement, const Key& key) {
+    statement.attach_cache(weak_from_this(), key);
+}
+
+void StatementCache::give_back(std::unique_ptr<Statement> statement) {
+    statement->recycle();
+
+    Entries evicted;
+    {
+        std::lock_guard lock(mutex_);
+        Key key = statement->cache_key();
+        entries_.push_front({std::move(key), std::move(statement)});
+        index_.emplace(entries_.front().key, entries_.begin());
+        trim(evicted);
+    }
+    evict(evicted);
+}
+
+void StatementCache::release(Statement* statement) {
+    std::unique_ptr<Statement> owned(statement);
+    if (const std::shared_ptr<StatementCache> cache = statement->cache()) {
+        cache->give_back(std::move(owned));
+        return;
+    }
+    owned->close();
+}
+
+void StatementCache::set_capacity(size_t capacity) {
+    Entries evicted;
+    {
+        std::lock_guard lock(mutex_);
+        capacity_ = capacity;
+        trim(evicted);
+    }
+    evict(evicted);
+}
+
+size_t StatementCache::capacity() const {
+    std::lock_guard lock(mutex_);
+    return capacity_;
+}
+
+size_t StatementCache::size() const {
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+void StatementCache::set_eviction_callback(EvictionCallback callback) {
+    std::lock_guard lock(mutex_);
+    eviction_callback_ = std::move(callback);
+}
+
+void StatementCache::clear() {
+    Entries cleared;
+    {
+        std::lock_guard lock(mutex_);
+        index_.clear();
+        cleared.swap(entries_);
+    }
+}
+
+void StatementCache::trim(Entries& evicted) {
+    while (entries_.size() > capacity_) {
+        const Entries::iterator oldest = std::prev(entries_.end());
+        auto [first, last] = index_.equal_range(oldest->key);
+        for (; first != last; ++first) {
+            if (first->second == oldest) {
+                index_.erase(first);
+                break;
+            }
+        }
+        evicted.splice(evicted.end(), entries_, oldest);
+    }
+}
+
+void StatementCache::evict(Entries& evicted) {
+    if (evicted.empty()) {
+        return;
+    }
+    EvictionCallback callback;
+    {
+        std::lock_guard lock(mutex_);
+        callback = eviction_callback_;
+    }
+    // called unlocked, so the callback may use the cache
+    for (const Entry& entry : evicted) {
+        if (callback) {
+            callback(entry.key.sql);
+        }
+    }
+    evicted.clear();
+}
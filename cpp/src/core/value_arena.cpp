@@ -0,0 +1,28 @@
+#include "core/value_arena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+void* ValueArena::allocate(size_t size, size_t alignment) {
+    for (; current_ < blocks_.size(); ++current_, used_ = 0) {
+        Block& block = blocks_[current_];
+        const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+        const size_t offset = ((base + used_ + alignment - 1) & ~(alignment - 1)) - base;
+        if (offset + size <= block.size) {
+            used_ = offset + size;
+            return block.data.get() + offset;
+        }
+    }
+
+    // blocks come from operator new, which aligns them for any fundamental type
+    const size_t block_size = std::max(BLOCK_SIZE, size);
+    blocks_.push_back({std::make_unique_for_overwrite<std::byte[]>(block_size), block_size});
+    current_ = blocks_.size() - 1;
+    used_ = size;
+    return blocks_.back().data.get();
+}
+
+void ValueArena::reset() {
+    std::erase_if(blocks_, [](const Block& block) { return block.size > BLOCK_SIZE; });
+    current_ = 0;
+    used_ = 0;
+}
@@ -0,0 +1,56 @@
+#include "core/worker_pool.hpp"
+#include <algorithm>
+#include <utility>
+
+WorkerPool::WorkerPool(unsigned threads) {
+    threads = std::max(threads, 1u);
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers_.emplace_back([this] {
+            run();
+        });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    queued_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    queued_.notify_one();
+}
+
+WorkerPool& WorkerPool::shared() {
+    // the workers mostly wait on the network, so there are more of them than cores
+    static WorkerPool pool(std::clamp(std::thread::hardware_concurrency() * 2, 4u, 32u));
+    return pool;
+}
+
+void WorkerPool::run() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex_);
+            queued_.wait(lock, [this] {
+                return stop_ || !tasks_.empty();
+            });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
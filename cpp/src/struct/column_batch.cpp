@@ -0,0 +1,112 @@
+#include "struct/column_batch.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+ColumnBatch::Column::~Column() {
+    std::free(nulls);
+    std::free(values);
+    std::free(offsets);
+    nulls = nullptr;
+    values = nullptr;
+    offsets = nullptr;
+    data_length = 0;
+    data_capacity = 0;
+}
+
+bool ColumnBatch::Column::is_variable_width() const {
+    return type == COLUMN_BATCH_STRING || type == COLUMN_BATCH_BINARY;
+}
+
+void ColumnBatch::Column::grow_rows(int32_t rows) {
+    auto* grown_nulls = static_cast<uint8_t*>(std::realloc(nulls, (static_cast<size_t>(rows) + 7) / 8));
+    if (!grown_nulls) {
+        throw std::bad_alloc();
+    }
+    nulls = grown_nulls;
+
+    auto* grown_offsets = static_cast<int32_t*>(std::realloc(offsets, (static_cast<size_t>(rows) + 1) * sizeof(int32_t)));
+    if (!grown_offsets) {
+        throw std::bad_alloc();
+    }
+    offsets = grown_offsets;
+}
+
+void ColumnBatch::Column::reset(int32_t column_type, int32_t rows) {
+    type = column_type;
+    data_length = 0;
+    std::memset(nulls, 0, (static_cast<size_t>(rows) + 7) / 8);
+    offsets[0] = 0;
+    if (!is_variable_width()) {
+        const size_t width = type == COLUMN_BATCH_INT32 ? sizeof(int32_t) : sizeof(int64_t);
+        reserve(static_cast<size_t>(rows) * width);
+    }
+}
+
+void ColumnBatch::Column::set_null(int32_t row) {
+    nulls[row >> 3] |= static_cast<uint8_t>(1u << (row & 7));
+    if (is_variable_width()) {
+        offsets[row + 1] = data_length;
+    }
+}
+
+void ColumnBatch::Column::put_fixed(int32_t row, const void* value, size_t size) {
+    std::memcpy(values + static_cast<size_t>(row) * size, value, size);
+}
+
+void ColumnBatch::Column::put_variable(int32_t row, const void* data, size_t size) {
+    reserve(static_cast<size_t>(data_length) + size);
+    if (size > 0) {
+        std::memcpy(values + data_length, data, size);
+    }
+    data_length += static_cast<int32_t>(size);
+    offsets[row + 1] = data_length;
+}
+
+void ColumnBatch::Column::reserve(size_t bytes) {
+    if (bytes <= static_cast<size_t>(data_capacity)) {
+        return;
+    }
+    if (bytes > INT32_MAX) {
+        throw std::length_error("Column batch buffer exceeds 2 GB");
+    }
+    // geometric growth keeps the number of reallocations logarithmic in the batch size
+    const size_t capacity = std::min<size_t>(std::max(bytes, static_cast<size_t>(data_capacity) * 2), INT32_MAX);
+    auto* grown = static_cast<uint8_t*>(std::realloc(values, capacity));
+    if (!grown) {
+        throw std::bad_alloc();
+    }
+    values = grown;
+    data_capacity = static_cast<int32_t>(capacity);
+}
+
+ColumnBatch::~ColumnBatch() {
+    delete[] columns;
+    columns = nullptr;
+    column_count = 0;
+    row_count = 0;
+    row_capacity = 0;
+}
+
+void ColumnBatch::reset(int32_t columns_count, int32_t rows) {
+    if (columns_count != column_count) {
+        delete[] columns;
+        columns = nullptr;
+        column_count = 0;
+        row_capacity = 0;
+        if (columns_count > 0) {
+            columns = new Column[columns_count];
+        }
+        column_count = columns_count;
+    }
+    if (rows > row_capacity) {
+        for (int32_t i = 0; i < column_count; ++i) {
+            columns[i].grow_rows(rows);
+        }
+        row_capacity = rows;
+    }
+    row_count = 0;
+}
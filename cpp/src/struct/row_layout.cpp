@@ -0,0 +1,76 @@
+#include "struct/row_layout.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+RowLayout::~RowLayout() {
+    delete[] types;
+    std::free(row);
+    types = nullptr;
+    row = nullptr;
+    column_count = 0;
+    length = 0;
+    capacity = 0;
+    pending = 0;
+}
+
+void RowLayout::set_types(const int32_t* column_types, int32_t columns_count) {
+    delete[] types;
+    types = nullptr;
+    column_count = 0;
+    if (columns_count > 0) {
+        types = new int32_t[columns_count];
+        std::memcpy(types, column_types, static_cast<size_t>(columns_count) * sizeof(int32_t));
+    }
+    column_count = columns_count;
+    length = 0;
+    pending = 0;
+}
+
+void RowLayout::begin_row() {
+    const size_t bitmap = (static_cast<size_t>(column_count) + 7) / 8;
+    reserve(bitmap);
+    std::memset(row, 0, bitmap);
+    length = static_cast<int32_t>(bitmap);
+    pending = 0;
+}
+
+void RowLayout::set_null(int32_t column) {
+    row[column >> 3] |= static_cast<uint8_t>(1u << (column & 7));
+}
+
+void RowLayout::append(const void* value, size_t size) {
+    reserve(static_cast<size_t>(length) + size);
+    if (size > 0) {
+        std::memcpy(row + length, value, size);
+    }
+    length += static_cast<int32_t>(size);
+}
+
+void RowLayout::append_prefixed(const void* data, size_t size) {
+    if (size > INT32_MAX) {
+        throw std::length_error("Packed row value exceeds 2 GB");
+    }
+    const auto prefix = static_cast<int32_t>(size);
+    append(&prefix, sizeof(prefix));
+    append(data, size);
+}
+
+void RowLayout::reserve(size_t bytes) {
+    if (bytes <= static_cast<size_t>(capacity)) {
+        return;
+    }
+    if (bytes > INT32_MAX) {
+        throw std::length_error("Packed row exceeds 2 GB");
+    }
+    const size_t grown_capacity = std::min<size_t>(std::max(bytes, static_cast<size_t>(capacity) * 2), INT32_MAX);
+    auto* grown = static_cast<uint8_t*>(std::realloc(row, grown_capacity));
+    if (!grown) {
+        throw std::bad_alloc();
+    }
+    row = grown;
+    capacity = static_cast<int32_t>(grown_capacity);
+}
@@ -2,10 +2,11 @@
 #include <vector>
 #include <algorithm>
 #include <exception>
+#include <memory>
+#include <version>
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 #include <fmt/xchar.h>
-#include <utf8.h>
 
 #ifdef _WIN32
 #define NOMINMAX
@@ -14,6 +15,7 @@
 #endif
 
 #include "utils/logger.hpp"
+#include "utils/utf_transcoder.hpp"
 
 namespace {
 
@@ -29,31 +31,22 @@ class StringOverflowException : public std::exception {
     }
 };
 
-} // namespace
-
-namespace utils::unicode {
-
-    // Code point limits
-    inline constexpr char32_t MAX_CODEPOINT        = 0x10FFFF;
-    inline constexpr char32_t BMP_MAX              = 0xFFFF;
-    inline constexpr char32_t SURROGATE_MIN        = 0xD800;
-    inline constexpr char32_t SURROGATE_MAX        = 0xDFFF;
-    inline constexpr char32_t REPLACEMENT_CHAR     = 0xFFFD;
-    inline constexpr char32_t ASTRAL_PLANE_START   = 0x10000;
-
-    // Surrogate encoding specifics
-    inline constexpr char16_t HIGH_SURROGATE_MIN   = 0xD800;
-    inline constexpr char16_t HIGH_SURROGATE_MAX   = 0xDBFF;
-    inline constexpr char16_t LOW_SURROGATE_MIN    = 0xDC00;
-    inline constexpr char16_t LOW_SURROGATE_MAX    = 0xDFFF;
-
-    inline constexpr char32_t SURROGATE_OFFSET     = ASTRAL_PLANE_START;  // 0x10000
-    inline constexpr char32_t HIGH_SURROGATE_BASE  = HIGH_SURROGATE_MIN;  // 0xD800
-    inline constexpr char32_t LOW_SURROGATE_BASE   = LOW_SURROGATE_MIN;   // 0xDC00
-    inline constexpr int      SURROGATE_SHIFT_BITS = 10;
-    inline constexpr char32_t SURROGATE_MASK       = 0x3FF;  // = 0b11'1111'1111
+/// Builds a string from a transcoder that writes at most max_length code units and returns the count written.
+/// The worst-case buffer is left uninitialized instead of being zero-filled first.
+template <class String, class Transcode>
+String transcode(size_t max_length, Transcode&& write) {
+    using CharT = typename String::value_type;
+#ifdef __cpp_lib_string_resize_and_overwrite
+    String result;
+    result.resize_and_overwrite(max_length, [&](CharT* data, size_t) { return write(data); });
+    return result;
+#else
+    const auto buffer = std::make_unique_for_overwrite<CharT[]>(max_length);
+    return String(buffer.get(), write(buffer.get()));
+#endif
+}
 
-}  // namespace utils::unicode
+} // namespace
 
 std::string utils::to_string(const std::string& str) {
     return str;
@@ -64,33 +57,29 @@ std::string utils::to_string(const std::wstring& str) {
     // Windows: wstring is UTF-16
     static_assert(sizeof(wchar_t) == sizeof(char16_t), "wchar_t must be 16-bit on Windows");
     static_assert(alignof(wchar_t) == alignof(char16_t), "alignment mismatch");
-    std::string result;
-    result.reserve(str.size() * 2);
-    utf8::unchecked::utf16to8(str.begin(), str.end(), std::back_inserter(result));
-    return result;
+    return transcode<std::string>(str.size() * 3, [&](char* data) {
+        return utf::utf16_to_utf8(reinterpret_cast<const char16_t*>(str.data()), str.size(), data);
+    });
 #else
     // Linux/macOS: wstring is UTF-32
     static_assert(sizeof(wchar_t) == sizeof(char32_t), "wchar_t must be 32-bit on this platform");
     static_assert(alignof(wchar_t) == alignof(char32_t), "alignment mismatch");
-    std::string result;
-    result.reserve(str.size() * 4);
-    utf8::unchecked::utf32to8(str.begin(), str.end(), std::back_inserter(result));
-    return result;
+    return transcode<std::string>(str.size() * 4, [&](char* data) {
+        return utf::utf32_to_utf8(reinterpret_cast<const char32_t*>(str.data()), str.size(), data);
+    });
 #endif
 }
 
 std::string utils::to_string(const std::u16string& str) {
-    std::string result;
-    result.reserve(str.size() * 3);
-    utf8::unchecked::utf16to8(str.begin(), str.end(), std::back_inserter(result));
-    return result;
+    return transcode<std::string>(str.size() * 3, [&](char* data) {
+        return utf::utf16_to_utf8(str.data(), str.size(), data);
+    });
 }
 
 std::string utils::to_string(const std::u32string& str) {
-    std::string result;
-    result.reserve(str.size() * 4);
-    utf8::unchecked::utf32to8(str.begin(), str.end(), std::back_inserter(result));
-    return result;
+    return transcode<std::string>(str.size() * 4, [&](char* data) {
+        return utf::utf32_to_utf8(str.data(), str.size(), data);
+    });
 }
 
 std::wstring utils::to_wstring(const std::u16string& str) {
@@ -134,27 +123,20 @@ std::wstring utils::to_wstring(const std::string& str) {
     LOG_TRACE("str={}", !str.empty() ? str : "(empty)");
     if (str.empty()) return {};
 
-    //Replaces all invalid sequences
-    std::string cleaned;
-    cleaned.reserve(str.size());
-    utf8::unchecked::replace_invalid(str.begin(), str.end(), std::back_inserter(cleaned));
-
 #ifdef _WIN32
     // Windows: wstring is UTF-16
     static_assert(sizeof(wchar_t) == sizeof(char16_t), "wchar_t must be 16-bit on Windows");
     static_assert(alignof(wchar_t) == alignof(char16_t), "alignment mismatch");
-    std::wstring result;
-    result.reserve(cleaned.size());
-    utf8::unchecked::utf8to16(cleaned.begin(), cleaned.end(), std::back_inserter(result));
-    return result;
+    return transcode<std::wstring>(str.size(), [&](wchar_t* data) {
+        return utf::utf8_to_utf16(str.data(), str.size(), reinterpret_cast<char16_t*>(data));
+    });
 #else
     // Linux/macOS: wstring is UTF-32
     static_assert(sizeof(wchar_t) == sizeof(char32_t), "wchar_t must be 32-bit on this platform");
     static_assert(alignof(wchar_t) == alignof(char32_t), "alignment mismatch");
-    std::wstring result;
-    result.reserve(cleaned.size());
-    utf8::unchecked::utf8to32(cleaned.begin(), cleaned.end(), std::back_inserter(result));
-    return result;
+    return transcode<std::wstring>(str.size(), [&](wchar_t* data) {
+        return utf::utf8_to_utf32(str.data(), str.size(), reinterpret_cast<char32_t*>(data));
+    });
 #endif
 }
 
@@ -164,15 +146,10 @@ std::wstring utils::to_wstring(const std::wstring& str) {
 
 std::u16string utils::to_u16string(const std::string& str) {
     LOG_TRACE("input string length = {}", str.length());
-    //Replaces all invalid sequences
-    std::string cleaned;
-    cleaned.reserve(str.size());
-    utf8::unchecked::replace_invalid(str.begin(), str.end(), std::back_inserter(cleaned));
-
-    std::u16string result;
-    result.reserve(cleaned.size());
-    utf8::unchecked::utf8to16(cleaned.begin(), cleaned.end(), std::back_inserter(result));
-    return result;
+    // Ill-formed sequences become U+FFFD, a UTF-8 string never needs more code units than bytes
+    return transcode<std::u16string>(str.size(), [&](char16_t* data) {
+        return utf::utf8_to_utf16(str.data(), str.size(), data);
+    });
 }
 
 std::u16string utils::to_u16string(const std::u32string& str) {
@@ -0,0 +1,330 @@
+#include "utils/utf_transcoder.hpp"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define UTF_TRANSCODER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define UTF_TARGET_AVX2
+#else
+#define UTF_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace utils::unicode;
+using utils::utf::SimdLevel;
+
+namespace {
+
+    // Kernels copy a prefix of pure ASCII in whole blocks and return its length.
+    // They stop at the first block holding anything else and leave it to the scalar decoder.
+    using WidenAscii = size_t (*)(const char* src, size_t length, char16_t* dst);
+    using NarrowAscii = size_t (*)(const char16_t* src, size_t length, char* dst);
+
+    struct Kernels {
+        SimdLevel level;
+        WidenAscii widen_ascii;
+        NarrowAscii narrow_ascii;
+    };
+
+    constexpr uint64_t ASCII_HIGH_BITS = 0x8080808080808080ULL;
+
+#ifndef UTF_TRANSCODER_X86
+    size_t widen_ascii_scalar(const char* src, size_t length, char16_t* dst) {
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            uint64_t block;
+            std::memcpy(&block, src + i, sizeof(block));
+            if (block & ASCII_HIGH_BITS) break;
+            for (size_t k = 0; k < 8; ++k) {
+                dst[i + k] = static_cast<unsigned char>(src[i + k]);
+            }
+        }
+        return i;
+    }
+
+    size_t narrow_ascii_scalar(const char16_t* src, size_t length, char* dst) {
+        size_t i = 0;
+        for (; i + 4 <= length; i += 4) {
+            uint64_t block;
+            std::memcpy(&block, src + i, sizeof(block));
+            if (block & 0xFF80FF80FF80FF80ULL) break;
+            for (size_t k = 0; k < 4; ++k) {
+                dst[i + k] = static_cast<char>(src[i + k]);
+            }
+        }
+        return i;
+    }
+#else
+    size_t widen_ascii_sse2(const char* src, size_t length, char16_t* dst) {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            if (_mm_movemask_epi8(bytes) != 0) break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(bytes, zero));
+        }
+        return i;
+    }
+
+    size_t narrow_ascii_sse2(const char16_t* src, size_t length, char* dst) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i non_ascii = _mm_set1_epi16(static_cast<short>(0xFF80));
+        size_t i = 0;
+        for (; i + 16 <= length; i += 16) {
+            const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+            const __m128i high_bits = _mm_and_si128(_mm_or_si128(lo, hi), non_ascii);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high_bits, zero)) != 0xFFFF) break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+        }
+        return i;
+    }
+
+    UTF_TARGET_AVX2 size_t widen_ascii_avx2(const char* src, size_t length, char16_t* dst) {
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            if (_mm256_movemask_epi8(bytes) != 0) break;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+        }
+        return i + widen_ascii_sse2(src + i, length - i, dst + i);
+    }
+
+    UTF_TARGET_AVX2 size_t narrow_ascii_avx2(const char16_t* src, size_t length, char* dst) {
+        const __m256i non_ascii = _mm256_set1_epi16(static_cast<short>(0xFF80));
+        size_t i = 0;
+        for (; i + 32 <= length; i += 32) {
+            const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16));
+            if (!_mm256_testz_si256(_mm256_or_si256(lo, hi), non_ascii)) break;
+            // packus works per 128-bit lane, the permute restores the order of the quadwords
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+        }
+        return i + narrow_ascii_sse2(src + i, length - i, dst + i);
+    }
+
+    bool cpu_supports_avx2() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0
+            && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(info, 7, 0);
+        return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    Kernels select_kernels() {
+#ifdef UTF_TRANSCODER_X86
+        if (cpu_supports_avx2()) {
+            return {SimdLevel::AVX2, widen_ascii_avx2, narrow_ascii_avx2};
+        }
+        // SSE2 is part of the x86-64 baseline
+        return {SimdLevel::SSE2, widen_ascii_sse2, narrow_ascii_sse2};
+#else
+        return {SimdLevel::Scalar, widen_ascii_scalar, narrow_ascii_scalar};
+#endif
+    }
+
+    const Kernels& kernels() {
+        static const Kernels selected = select_kernels();
+        return selected;
+    }
+
+    size_t widen_ascii_utf32(const char* src, size_t length, char32_t* dst) {
+        size_t i = 0;
+        for (; i + 8 <= length; i += 8) {
+            uint64_t block;
+            std::memcpy(&block, src + i, sizeof(block));
+            if (block & ASCII_HIGH_BITS) break;
+            for (size_t k = 0; k < 8; ++k) {
+                dst[i + k] = static_cast<unsigned char>(src[i + k]);
+            }
+        }
+        return i;
+    }
+
+    /// Decodes the sequence whose non-ASCII lead byte is at s[i] and advances i past it.
+    /// An ill-formed sequence yields U+FFFD and consumes its maximal subpart, as Unicode recommends.
+    char32_t decode_utf8(const unsigned char* s, size_t length, size_t& i) {
+        const unsigned char lead = s[i++];
+        unsigned char lower = 0x80;
+        unsigned char upper = 0xBF;
+        int trailing;
+        char32_t code_point;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            trailing = 1;
+            code_point = lead & 0x1F;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            trailing = 2;
+            code_point = lead & 0x0F;
+            if (lead == 0xE0) lower = 0xA0;      // overlong
+            else if (lead == 0xED) upper = 0x9F; // surrogates
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            trailing = 3;
+            code_point = lead & 0x07;
+            if (lead == 0xF0) lower = 0x90;      // overlong
+            else if (lead == 0xF4) upper = 0x8F; // above U+10FFFF
+        } else {
+            return REPLACEMENT_CHAR;
+        }
+
+        for (; trailing > 0; --trailing) {
+            if (i >= length || s[i] < lower || s[i] > upper) {
+                return REPLACEMENT_CHAR;
+            }
+            code_point = code_point << 6 | (s[i] & 0x3F);
+            lower = 0x80;
+            upper = 0xBF;
+            ++i;
+        }
+        return code_point;
+    }
+
+    size_t put_code_point(char32_t code_point, char16_t* dst) {
+        if (code_point <= BMP_MAX) {
+            dst[0] = static_cast<char16_t>(code_point);
+            return 1;
+        }
+        const char32_t offset = code_point - SURROGATE_OFFSET;
+        dst[0] = static_cast<char16_t>((offset >> SURROGATE_SHIFT_BITS) + HIGH_SURROGATE_BASE);
+        dst[1] = static_cast<char16_t>((offset & SURROGATE_MASK) + LOW_SURROGATE_BASE);
+        return 2;
+    }
+
+    size_t put_code_point(char32_t code_point, char32_t* dst) {
+        dst[0] = code_point;
+        return 1;
+    }
+
+    size_t put_utf8(char32_t code_point, char* dst) {
+        if (code_point < 0x80) {
+            dst[0] = static_cast<char>(code_point);
+            return 1;
+        }
+        if (code_point < 0x800) {
+            dst[0] = static_cast<char>(0xC0 | code_point >> 6);
+            dst[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+            return 2;
+        }
+        if (code_point <= BMP_MAX) {
+            dst[0] = static_cast<char>(0xE0 | code_point >> 12);
+            dst[1] = static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+            dst[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+            return 3;
+        }
+        dst[0] = static_cast<char>(0xF0 | code_point >> 18);
+        dst[1] = static_cast<char>(0x80 | (code_point >> 12 & 0x3F));
+        dst[2] = static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+        dst[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 4;
+    }
+
+    template <typename CharT, typename Widen>
+    size_t decode(const char* src, size_t length, CharT* dst, Widen widen_ascii) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(src);
+        size_t i = 0;
+        size_t out = 0;
+        while (i < length) {
+            const size_t run = widen_ascii(src + i, length - i, dst + out);
+            i += run;
+            out += run;
+            // The scalar decoder takes over the rejected block and hands back
+            // at the next ASCII byte that follows a multibyte sequence.
+            bool multibyte = false;
+            while (i < length) {
+                if (bytes[i] < 0x80) {
+                    if (multibyte) break;
+                    dst[out++] = bytes[i++];
+                } else {
+                    out += put_code_point(decode_utf8(bytes, length, i), dst + out);
+                    multibyte = true;
+                }
+            }
+        }
+        return out;
+    }
+
+} // namespace
+
+utils::utf::SimdLevel utils::utf::simd_level() {
+    return kernels().level;
+}
+
+size_t utils::utf::utf8_to_utf16(const char* src, size_t length, char16_t* dst) {
+    return decode(src, length, dst, kernels().widen_ascii);
+}
+
+size_t utils::utf::utf8_to_utf32(const char* src, size_t length, char32_t* dst) {
+    return decode(src, length, dst, widen_ascii_utf32);
+}
+
+size_t utils::utf::utf16_to_utf8(const char16_t* src, size_t length, char* dst) {
+    const NarrowAscii narrow_ascii = kernels().narrow_ascii;
+    size_t i = 0;
+    size_t out = 0;
+    while (i < length) {
+        const size_t run = narrow_ascii(src + i, length - i, dst + out);
+        i += run;
+        out += run;
+        bool multibyte = false;
+        while (i < length) {
+            char32_t code_point = src[i];
+            if (code_point < 0x80) {
+                if (multibyte) break;
+                dst[out++] = static_cast<char>(code_point);
+                ++i;
+                continue;
+            }
+            multibyte = true;
+            ++i;
+            if (code_point >= HIGH_SURROGATE_MIN && code_point <= HIGH_SURROGATE_MAX
+                && i < length && src[i] >= LOW_SURROGATE_MIN && src[i] <= LOW_SURROGATE_MAX) {
+                const char32_t high = code_point - HIGH_SURROGATE_BASE;
+                const char32_t low = src[i++] - LOW_SURROGATE_BASE;
+                code_point = (high << SURROGATE_SHIFT_BITS | low) + SURROGATE_OFFSET;
+            } else if (code_point >= SURROGATE_MIN && code_point <= SURROGATE_MAX) {
+                code_point = REPLACEMENT_CHAR;
+            }
+            out += put_utf8(code_point, dst + out);
+        }
+    }
+    return out;
+}
+
+size_t utils::utf::utf32_to_utf8(const char32_t* src, size_t length, char* dst) {
+    size_t out = 0;
+    for (size_t i = 0; i < length; ++i) {
+        char32_t code_point = src[i];
+        if (code_point > MAX_CODEPOINT || (code_point >= SURROGATE_MIN && code_point <= SURROGATE_MAX)) {
+            code_point = REPLACEMENT_CHAR;
+        }
+        out += put_utf8(code_point, dst + out);
+    }
+    return out;
+}
+
+size_t utils::utf::utf8_complete_length(const char* src, size_t length) {
+    // a sequence is at most 4 bytes, so its lead byte is among the last 3 if it is cut short
+    for (size_t back = 1; back <= 3 && back <= length; ++back) {
+        const auto byte = static_cast<unsigned char>(src[length - back]);
+        if ((byte & 0xC0) == 0x80) {
+            continue;
+        }
+        const size_t needed = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+        return needed > back ? length - back : length;
+    }
+    return length;
+}
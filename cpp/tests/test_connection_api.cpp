@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include <string>
+#include <vector>
 #include "api/connection.h"
 #include "api/result.h"
+#include "api/statement.h"
+#include "api/odbc.h"
 #include "core/database_metadata.hpp"
 #include "core/isolation_level.hpp"
 #include <../tests/test_utils.hpp>
@@ -134,4 +137,203 @@ TEST(ConnectionAPITest, ExecuteSimpleQuery) {
     assert_no_error(error);
     disconnect(conn, &error);
     assert_no_error(error);
-}
\ No newline at end of file
+}
+
+// Test: character data read as SQL_C_WCHAR
+TEST(ConnectionAPITest, WideCharFetch) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+
+    EXPECT_FALSE(get_wide_char_fetch(conn, &error));
+    set_wide_char_fetch(conn, true, &error);
+    assert_no_error(error);
+    EXPECT_TRUE(get_wide_char_fetch(conn, &error));
+
+    const ApiString create = ODBC_TEXT("CREATE TABLE words (word VARCHAR(600));");
+    auto* res = execute_request(conn, create.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+
+    // longer than the first SQLGetData chunk, so truncation handling is exercised
+    const ApiString long_word(500, ODBC_TEXT('x'));
+    const ApiString insert = ODBC_TEXT("INSERT INTO words VALUES ('été'), (NULL), ('") + long_word + ODBC_TEXT("');");
+    res = execute_request(conn, insert.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    assert_no_error(error);
+
+    const ApiString select = ODBC_TEXT("SELECT word FROM words;");
+    res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    assert_no_error(error);
+
+    ASSERT_TRUE(next_result(res, &error));
+    const ApiChar* word = get_string_value_by_index(res, 0, &error);
+    ASSERT_NE(word, nullptr);
+    EXPECT_EQ(ApiString(word), ODBC_TEXT("été"));
+    EXPECT_FALSE(was_null_by_index(res, 0, &error));
+    std_free(const_cast<ApiChar*>(word));
+
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_EQ(get_string_value_by_index(res, 0, &error), nullptr);
+    EXPECT_TRUE(was_null_by_index(res, 0, &error));
+
+    ASSERT_TRUE(next_result(res, &error));
+    word = get_string_value_by_index(res, 0, &error);
+    ASSERT_NE(word, nullptr);
+    EXPECT_EQ(ApiString(word), long_word);
+    std_free(const_cast<ApiChar*>(word));
+    assert_no_error(error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+// Test: prepared statements are reused from the cache and evicted least recently used first
+TEST(ConnectionAPITest, StatementCache) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+
+    std::vector<ApiString> evicted;
+    set_statement_eviction_callback(conn, [](const ApiChar* sql, void* context) {
+        static_cast<std::vector<ApiString>*>(context)->emplace_back(sql);
+    }, &evicted, &error);
+    assert_no_error(error);
+    EXPECT_EQ(get_statement_cache_size(conn, &error), 0);
+    set_statement_cache_size(conn, 1, &error);
+    assert_no_error(error);
+    EXPECT_EQ(get_statement_cache_size(conn, &error), 1);
+
+    const ApiString select_one = ODBC_TEXT("SELECT 1;");
+    const ApiString select_two = ODBC_TEXT("SELECT 2;");
+    Statement* first = create_prepared_statement(conn, select_one.c_str(), &error);
+    ASSERT_NE(first, nullptr);
+    auto* res = execute(first, 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(next_result(res, &error));
+    close_result(res, &error);
+    close_statement(first, &error);
+    assert_no_error(error);
+
+    // the idle statement is handed out again, already prepared
+    Statement* again = create_prepared_statement(conn, select_one.c_str(), &error);
+    EXPECT_EQ(again, first);
+    Statement* second = create_prepared_statement(conn, select_two.c_str(), &error);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(second, first);
+    res = execute(second, 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 2);
+    close_result(res, &error);
+
+    // giving back two statements to a cache of one evicts the older
+    close_statement(again, &error);
+    close_statement(second, &error);
+    assert_no_error(error);
+    ASSERT_EQ(evicted.size(), 1u);
+    EXPECT_EQ(evicted[0], select_one);
+
+    // execute_request reuses the cached statement and gives it back on close
+    res = execute_request(conn, select_two.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 2);
+    close_result(res, &error);
+    assert_no_error(error);
+    EXPECT_EQ(create_prepared_statement(conn, select_two.c_str(), &error), second);
+    close_statement(second, &error);
+
+    set_statement_cache_size(conn, 0, &error);
+    assert_no_error(error);
+    EXPECT_EQ(evicted.size(), 1u);
+    disconnect(conn, &error);
+    assert_no_error(error);
+}
+
+// Test: pooled connections are reused with their session reset and borrowing waits up to the timeout
+TEST(ConnectionAPITest, ConnectionPool) {
+    NativeError error;
+    const ApiString conn_str = get_connection_string();
+    PoolSettings settings;
+    settings.max_size = 1;
+    settings.borrow_timeout_ms = 50;
+
+    Connection* conn = pool_borrow(conn_str.c_str(), 10, &settings, &error);
+    assert_no_error(error);
+    ASSERT_NE(conn, nullptr);
+    const ApiString create_sql = ODBC_TEXT("CREATE TABLE pooled (id INTEGER);");
+    auto* res = execute_request(conn, create_sql.c_str(), 10, &error);
+    assert_no_error(error);
+    close_result(res, &error);
+
+    // the only connection is borrowed
+    const ApiString same_source = conn_str + ODBC_TEXT(" ;");
+    EXPECT_EQ(pool_borrow(same_source.c_str(), 10, &settings, &error), nullptr);
+    assert_has_error(error);
+
+    set_auto_commit_transaction(conn, false, &error);
+    const ApiString insert_sql = ODBC_TEXT("INSERT INTO pooled (id) VALUES (1);");
+    res = execute_request(conn, insert_sql.c_str(), 10, &error);
+    assert_no_error(error);
+    close_result(res, &error);
+    pool_return(conn, &error);
+    assert_no_error(error);
+
+    // the same in-memory database comes back, without the uncommitted row
+    Connection* again = pool_borrow(same_source.c_str(), 10, &settings, &error);
+    assert_no_error(error);
+    ASSERT_EQ(again, conn);
+    EXPECT_TRUE(get_auto_commit_transaction(again, &error));
+    const ApiString count_sql = ODBC_TEXT("SELECT COUNT(*) FROM pooled;");
+    res = execute_request(again, count_sql.c_str(), 10, &error);
+    assert_no_error(error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 0);
+    close_result(res, &error);
+
+    // the session settings of the borrower are undone
+    const int default_level = get_transaction_isolation_level(again, &error);
+    assert_no_error(error);
+    const ApiChar* default_catalog = get_catalog_name(again, &error);
+    const ApiString catalog = default_catalog ? default_catalog : ApiString();
+    std_free(const_cast<ApiChar*>(default_catalog));
+    DatabaseMetaData metadata(*again);
+    const int supported_levels = metadata.supportsTransactionIsolationLevel();
+    for (const int level : {IsolationLevel::READ_UNCOMMITTED, IsolationLevel::READ_COMMITTED,
+                            IsolationLevel::REPEATABLE_READ, IsolationLevel::SERIALIZABLE}) {
+        if (level != default_level && (supported_levels & level)) {
+            set_transaction_isolation_level(again, level, &error);
+            assert_no_error(error);
+            break;
+        }
+    }
+    // drivers without catalogs reject the change, which leaves nothing to undo
+    const ApiString other_catalog = ODBC_TEXT("temp");
+    set_catalog_name(again, other_catalog.c_str(), &error);
+    pool_return(again, &error);
+    assert_no_error(error);
+    again = pool_borrow(conn_str.c_str(), 10, &settings, &error);
+    assert_no_error(error);
+    ASSERT_NE(again, nullptr);
+    EXPECT_EQ(get_transaction_isolation_level(again, &error), default_level);
+    const ApiChar* restored_catalog = get_catalog_name(again, &error);
+    EXPECT_EQ(restored_catalog ? ApiString(restored_catalog) : ApiString(), catalog);
+    std_free(const_cast<ApiChar*>(restored_catalog));
+
+    // a connection closed for good frees its place in the pool
+    disconnect(again, &error);
+    assert_no_error(error);
+    conn = pool_borrow(conn_str.c_str(), 10, &settings, &error);
+    assert_no_error(error);
+    ASSERT_NE(conn, nullptr);
+    pool_return(conn, &error);
+    assert_no_error(error);
+
+    settings.min_size = 2;
+    EXPECT_EQ(pool_borrow(conn_str.c_str(), 10, &settings, &error), nullptr);
+    assert_has_error(error);
+}
@@ -39,7 +39,7 @@ static void setup_test_table(Connection* conn, NativeError& error) {
     assert_no_error(error);
 
     // Insert data
-    nanodbc::statement* stmt = create_statement(conn, &error);
+    Statement* stmt = create_statement(conn, &error);
     ASSERT_NE(stmt, nullptr);
     const ApiString insert = ODBC_TEXT("INSERT INTO test_data VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);");
     prepare_statement(stmt, insert.c_str(), &error);
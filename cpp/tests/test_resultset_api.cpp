@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include "api/connection.h"
 #include "api/statement.h"
 #include "api/result.h"
+#include "api/odbc.h"
+#include "core/row_cache.hpp"
+#include "core/row_prefetcher.hpp"
 #include "struct/error_info.h"
 #include "struct/binary_array.h"
 #include <../tests/test_utils.hpp>
@@ -38,7 +44,7 @@ static void setup_test_table(Connection* conn, NativeError& error) {
     assert_no_error(error);
 
     // Insert data
-    nanodbc::statement* stmt = create_statement(conn, &error);
+    Statement* stmt = create_statement(conn, &error);
     ASSERT_NE(stmt, nullptr);
     const ApiString insert = ODBC_TEXT("INSERT INTO test_data VALUES (1, ?, ?, ?, ?, ?, ?, ?, ?);");
     prepare_statement(stmt, insert.c_str(), &error);
@@ -187,3 +193,860 @@ TEST(ResultSetAPITest, NullAndBinaryHandling) {
     disconnect(conn, &error);
     assert_no_error(error);
 }
+
+// Helper function: fill a table with `rows` rows, every third label is NULL
+static void setup_numbers_table(Connection* conn, NativeError& error, int rows) {
+    const ApiString create = ODBC_TEXT("CREATE TABLE numbers (id INTEGER, label VARCHAR(20), amount DOUBLE);");
+    auto* res = execute_request(conn, create.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    assert_no_error(error);
+
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert = ODBC_TEXT("INSERT INTO numbers VALUES (?, ?, ?);");
+    prepare_statement(stmt, insert.c_str(), &error);
+    assert_no_error(error);
+
+    for (int i = 0; i < rows; ++i) {
+        set_int_value(stmt, 0, i, &error);
+        const ApiString label = ODBC_TEXT("row") + static_cast<ApiString>(StringProxy(std::to_string(i)));
+        set_string_value(stmt, 1, i % 3 == 0 ? nullptr : label.c_str(), &error);
+        set_double_value(stmt, 2, i * 0.5, &error);
+        res = execute(stmt, 10, &error);
+        ASSERT_NE(res, nullptr);
+        close_result(res, &error);
+        assert_no_error(error);
+    }
+    close_statement(stmt, &error);
+    assert_no_error(error);
+}
+
+TEST(ResultSetAPITest, BlockFetchWithFetchSize) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 10);
+
+    const ApiString select = ODBC_TEXT("SELECT id, label, amount FROM numbers ORDER BY id;");
+    auto* res = execute_request_with_fetch_size(conn, select.c_str(), 10, 4, &error);
+    ASSERT_NE(res, nullptr);
+    assert_no_error(error);
+
+    int rows = 0;
+    while (next_result(res, &error)) {
+        assert_no_error(error);
+        EXPECT_EQ(get_int_value_by_index(res, 0, &error), rows);
+        EXPECT_DOUBLE_EQ(get_double_value_by_index(res, 2, &error), rows * 0.5);
+
+        const ApiChar* label = get_string_value_by_index(res, 1, &error);
+        assert_no_error(error);
+        if (rows % 3 == 0) {
+            EXPECT_EQ(label, nullptr);
+            EXPECT_TRUE(was_null_by_index(res, 1, &error));
+        } else {
+            ASSERT_NE(label, nullptr);
+            EXPECT_EQ(ApiString(label), ODBC_TEXT("row") + static_cast<ApiString>(StringProxy(std::to_string(rows))));
+            std_free(const_cast<ApiChar*>(label));
+        }
+        ++rows;
+    }
+    assert_no_error(error);
+    EXPECT_EQ(rows, 10);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+    assert_no_error(error);
+}
+
+TEST(ResultSetAPITest, FetchBatchColumnar) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 10);
+
+    const ApiString select = ODBC_TEXT("SELECT id, label, amount FROM numbers ORDER BY id;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    assert_no_error(error);
+
+    ColumnBatch* batch = create_column_batch(&error);
+    ASSERT_NE(batch, nullptr);
+
+    int total = 0;
+    for (const int expected : {4, 4, 2, 0}) {
+        const int rows = fetch_batch(res, 4, batch, &error);
+        assert_no_error(error);
+        ASSERT_EQ(rows, expected);
+        ASSERT_EQ(batch->row_count, expected);
+        ASSERT_EQ(batch->column_count, 3);
+
+        const auto& ids = batch->columns[0];
+        const auto& labels = batch->columns[1];
+        const auto& amounts = batch->columns[2];
+        ASSERT_EQ(ids.type, COLUMN_BATCH_INT32);
+        ASSERT_EQ(labels.type, COLUMN_BATCH_STRING);
+        ASSERT_EQ(amounts.type, COLUMN_BATCH_DOUBLE);
+
+        for (int row = 0; row < rows; ++row, ++total) {
+            EXPECT_EQ(reinterpret_cast<const int32_t*>(ids.values)[row], total);
+            EXPECT_DOUBLE_EQ(reinterpret_cast<const double*>(amounts.values)[row], total * 0.5);
+
+            const bool label_null = labels.nulls[row / 8] & (1 << (row % 8));
+            EXPECT_EQ(label_null, total % 3 == 0);
+            const auto* begin = reinterpret_cast<const ApiChar*>(labels.values + labels.offsets[row]);
+            const auto* end = reinterpret_cast<const ApiChar*>(labels.values + labels.offsets[row + 1]);
+            if (!label_null) {
+                EXPECT_EQ(ApiString(begin, end), ODBC_TEXT("row") + static_cast<ApiString>(StringProxy(std::to_string(total))));
+            } else {
+                EXPECT_EQ(begin, end);
+            }
+        }
+    }
+    EXPECT_EQ(total, 10);
+
+    EXPECT_EQ(fetch_batch(res, 0, batch, &error), -1);
+    assert_has_error(error);
+
+    delete_column_batch(batch);
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+TEST(ResultSetAPITest, ExportArrowStream) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 10);
+
+    const ApiString select = ODBC_TEXT("SELECT id, label, amount FROM numbers ORDER BY id;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    assert_no_error(error);
+
+    ArrowArrayStream stream{};
+    export_arrow_stream(res, 4, &stream, &error);
+    assert_no_error(error);
+    ASSERT_NE(stream.release, nullptr);
+
+    ArrowSchema schema{};
+    ASSERT_EQ(stream.get_schema(&stream, &schema), 0);
+    EXPECT_STREQ(schema.format, "+s");
+    ASSERT_EQ(schema.n_children, 3);
+    EXPECT_STREQ(schema.children[0]->format, "i");
+    EXPECT_STREQ(schema.children[1]->format, "u");
+    EXPECT_STREQ(schema.children[2]->format, "g");
+    EXPECT_STREQ(schema.children[1]->name, "label");
+    schema.release(&schema);
+    EXPECT_EQ(schema.release, nullptr);
+
+    int total = 0;
+    while (true) {
+        ArrowArray array{};
+        ASSERT_EQ(stream.get_next(&stream, &array), 0);
+        if (!array.release) {
+            break;
+        }
+        ASSERT_EQ(array.n_children, 3);
+        const ArrowArray* ids = array.children[0];
+        const ArrowArray* labels = array.children[1];
+        const ArrowArray* amounts = array.children[2];
+        ASSERT_EQ(labels->n_buffers, 3);
+
+        const auto* id_values = static_cast<const int32_t*>(ids->buffers[1]);
+        const auto* amount_values = static_cast<const double*>(amounts->buffers[1]);
+        const auto* validity = static_cast<const uint8_t*>(labels->buffers[0]);
+        const auto* offsets = static_cast<const int32_t*>(labels->buffers[1]);
+        const auto* text = static_cast<const char*>(labels->buffers[2]);
+        ASSERT_NE(validity, nullptr);
+        for (int64_t row = 0; row < array.length; ++row, ++total) {
+            EXPECT_EQ(id_values[row], total);
+            EXPECT_DOUBLE_EQ(amount_values[row], total * 0.5);
+            const bool valid = validity[row / 8] & (1 << (row % 8));
+            EXPECT_EQ(valid, total % 3 != 0);
+            if (valid) {
+                EXPECT_EQ(std::string(text + offsets[row], text + offsets[row + 1]), "row" + std::to_string(total));
+            }
+        }
+        array.release(&array);
+    }
+    EXPECT_EQ(total, 10);
+
+    stream.release(&stream);
+    EXPECT_EQ(stream.release, nullptr);
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+TEST(ResultSetAPITest, ReadRowPacked) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 4);
+
+    const ApiString select = ODBC_TEXT("SELECT id, label, amount FROM numbers ORDER BY id;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    assert_no_error(error);
+
+    RowLayout* layout = create_row_layout(res, &error);
+    ASSERT_NE(layout, nullptr);
+    ASSERT_EQ(layout->column_count, 3);
+    EXPECT_EQ(layout->types[0], COLUMN_BATCH_INT32);
+    EXPECT_EQ(layout->types[1], COLUMN_BATCH_STRING);
+    EXPECT_EQ(layout->types[2], COLUMN_BATCH_DOUBLE);
+
+    int id = 0;
+    while (next_result(res, &error)) {
+        // a too small buffer reports the required size and keeps the row for the retry
+        uint8_t small[2];
+        const int required = read_row(res, small, sizeof(small), layout, &error);
+        assert_no_error(error);
+        ASSERT_GT(required, static_cast<int>(sizeof(small)));
+
+        std::vector<uint8_t> buffer(required);
+        ASSERT_EQ(read_row(res, buffer.data(), required, layout, &error), required);
+        assert_no_error(error);
+
+        const uint8_t nulls = buffer[0];
+        size_t pos = 1;
+        int32_t id_value;
+        std::memcpy(&id_value, &buffer[pos], sizeof(id_value));
+        pos += sizeof(id_value);
+        EXPECT_EQ(id_value, id);
+        EXPECT_FALSE(nulls & 1);
+
+        EXPECT_EQ(static_cast<bool>(nulls & 2), id % 3 == 0);
+        if (!(nulls & 2)) {
+            int32_t bytes;
+            std::memcpy(&bytes, &buffer[pos], sizeof(bytes));
+            pos += sizeof(bytes);
+            ApiString label(bytes / sizeof(ApiChar), 0);
+            std::memcpy(label.data(), &buffer[pos], bytes);
+            pos += bytes;
+            EXPECT_EQ(label, ODBC_TEXT("row") + static_cast<ApiString>(StringProxy(std::to_string(id))));
+        }
+
+        double amount;
+        std::memcpy(&amount, &buffer[pos], sizeof(amount));
+        pos += sizeof(amount);
+        EXPECT_DOUBLE_EQ(amount, id * 0.5);
+        EXPECT_EQ(pos, static_cast<size_t>(required));
+        ++id;
+    }
+    EXPECT_EQ(id, 4);
+    close_result(res, &error);
+
+    // a row left pending is dropped once the cursor moves on
+    res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(next_result(res, &error));
+    uint8_t small[2];
+    ASSERT_GT(read_row(res, small, sizeof(small), layout, &error), static_cast<int>(sizeof(small)));
+    ASSERT_TRUE(next_result(res, &error));
+    std::vector<uint8_t> buffer(256);
+    ASSERT_GT(read_row(res, buffer.data(), static_cast<int>(buffer.size()), layout, &error), 0);
+    assert_no_error(error);
+    int32_t id_value;
+    std::memcpy(&id_value, &buffer[1], sizeof(id_value));
+    EXPECT_EQ(id_value, 1);
+
+    delete_row_layout(layout);
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+TEST(ResultSetAPITest, ColumnDescriptors) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 1);
+
+    const ApiString select = ODBC_TEXT("SELECT id, label, amount FROM numbers;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    assert_no_error(error);
+
+    EXPECT_EQ(res->descriptor(0).accessor, ColumnAccessor::Native);
+    EXPECT_EQ(res->descriptor(0).batch_type, COLUMN_BATCH_INT32);
+    EXPECT_EQ(res->descriptor(2).batch_type, COLUMN_BATCH_DOUBLE);
+    EXPECT_GT(res->descriptor(1).size, 0u);
+    EXPECT_THROW(res->descriptor(3), nanodbc::index_range_error);
+
+    ASSERT_TRUE(next_result(res, &error));
+    const ApiString id = ODBC_TEXT("id");
+    EXPECT_EQ(get_int_value_by_name(res, id.c_str(), &error), 0);
+    assert_no_error(error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+TEST(ResultSetAPITest, FindColumnCaseInsensitiveAndAlias) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 2);
+
+    const ApiString select = ODBC_TEXT("SELECT id, label, amount, id AS Label FROM numbers ORDER BY id;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    assert_no_error(error);
+
+    EXPECT_EQ(find_column_by_name(res, ODBC_TEXT("ID"), &error), 0);
+    EXPECT_EQ(find_column_by_name(res, ODBC_TEXT("Amount"), &error), 2);
+    // the leftmost of two equally named columns wins
+    EXPECT_EQ(find_column_by_name(res, ODBC_TEXT("LABEL"), &error), 1);
+    assert_no_error(error);
+
+    find_column_by_name(res, ODBC_TEXT("missing"), &error);
+    assert_has_error(error);
+
+    set_alias_column_name(res, ODBC_TEXT("TOTAL"), 2, &error);
+    assert_no_error(error);
+    EXPECT_EQ(find_column_by_name(res, ODBC_TEXT("total"), &error), 2);
+    EXPECT_EQ(find_column_by_name(res, ODBC_TEXT("amount"), &error), 2);
+    assert_no_error(error);
+
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_DOUBLE_EQ(get_double_value_by_name(res, ODBC_TEXT("Total"), &error), 0.0);
+    assert_no_error(error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+TEST(ResultSetAPITest, GetStringIntoBuffer) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 12);
+
+    const ApiString select = ODBC_TEXT("SELECT label FROM numbers WHERE id IN (0, 11) ORDER BY id;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    assert_no_error(error);
+
+    ApiChar buffer[16];
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_EQ(get_string_into_by_index(res, 0, buffer, 16, &error), -1);
+    assert_no_error(error);
+
+    ASSERT_TRUE(next_result(res, &error));
+    // too small: the required length is reported and the value is kept for the retry
+    EXPECT_EQ(get_string_into_by_index(res, 0, buffer, 2, &error), 5);
+    assert_no_error(error);
+    EXPECT_EQ(get_string_into_by_index(res, 0, buffer, 16, &error), 5);
+    assert_no_error(error);
+    EXPECT_EQ(ApiString(buffer), ODBC_TEXT("row11"));
+
+    // an error is told apart from NULL
+    EXPECT_EQ(get_string_into_by_index(nullptr, 0, buffer, 16, &error), -2);
+    assert_has_error(error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+// Test: decimals are returned as unscaled value and scale
+TEST(ResultSetAPITest, GetDecimal) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+
+    const ApiString create = ODBC_TEXT("CREATE TABLE prices (id INTEGER, price DECIMAL(18,4));");
+    auto* res = execute_request(conn, create.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    const ApiString insert = ODBC_TEXT("INSERT INTO prices VALUES (1, 1234.5678), (2, -0.25), (3, NULL);");
+    res = execute_request(conn, insert.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    assert_no_error(error);
+
+    // the scale depends on whether the driver returns SQL_C_NUMERIC, compare at the column scale
+    const auto at_scale_4 = [](const CDecimal& value) {
+        auto unscaled = static_cast<int64_t>(value.unscaled_low);
+        for (int32_t scale = value.scale; scale < 4; ++scale) {
+            unscaled *= 10;
+        }
+        return unscaled;
+    };
+
+    const ApiString select = ODBC_TEXT("SELECT id, price FROM prices ORDER BY id;");
+    res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+
+    CDecimal value;
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_TRUE(get_decimal_by_index(res, 0, &value, &error));
+    EXPECT_EQ(value.unscaled_low, 1u);
+    EXPECT_EQ(value.unscaled_high, 0);
+    EXPECT_EQ(value.scale, 0);
+    EXPECT_TRUE(get_decimal_by_index(res, 1, &value, &error));
+    assert_no_error(error);
+    EXPECT_EQ(value.unscaled_high, 0);
+    EXPECT_EQ(at_scale_4(value), 12345678);
+
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_TRUE(get_decimal_by_index(res, 1, &value, &error));
+    assert_no_error(error);
+    EXPECT_EQ(value.unscaled_high, -1);
+    EXPECT_EQ(at_scale_4(value), -2500);
+
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_FALSE(get_decimal_by_index(res, 1, &value, &error));
+    assert_no_error(error);
+    EXPECT_TRUE(was_null_by_index(res, 1, &error));
+    close_result(res, &error);
+
+    // digits a double cannot hold survive a block fetch too, which keeps its rowset
+    const ApiString create_large = ODBC_TEXT("CREATE TABLE totals (id INTEGER, total DECIMAL(18,0));");
+    res = execute_request(conn, create_large.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    const ApiString insert_large = ODBC_TEXT("INSERT INTO totals VALUES (0, 123456789012345670), (1, 123456789012345671), "
+                                             "(2, NULL), (3, 123456789012345673), (4, 123456789012345674), (5, 123456789012345675);");
+    res = execute_request(conn, insert_large.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    const ApiString select_large = ODBC_TEXT("SELECT id, total FROM totals ORDER BY id;");
+    res = execute_request_with_fetch_size(conn, select_large.c_str(), 10, 4, &error);
+    ASSERT_NE(res, nullptr);
+    EXPECT_EQ(res->rowset_size(), 4);
+    EXPECT_EQ(res->descriptor(1).accessor, ColumnAccessor::Decimal);
+    int row = 0;
+    while (next_result(res, &error)) {
+        EXPECT_EQ(get_int_value_by_index(res, 0, &error), row);
+        if (row == 2) {
+            EXPECT_FALSE(get_decimal_by_index(res, 1, &value, &error));
+            EXPECT_TRUE(was_null_by_index(res, 1, &error));
+        } else {
+            EXPECT_TRUE(get_decimal_by_index(res, 1, &value, &error));
+            EXPECT_EQ(value.unscaled_low, 123456789012345670u + row);
+            EXPECT_EQ(value.scale, 0);
+        }
+        assert_no_error(error);
+        ++row;
+    }
+    EXPECT_EQ(row, 6);
+    close_result(res, &error);
+
+    // an empty string reads as no value, not as a malformed number
+    const ApiString select_empty = ODBC_TEXT("SELECT '';");
+    res = execute_request(conn, select_empty.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_FALSE(get_decimal_by_index(res, 0, &value, &error));
+    assert_no_error(error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+// Test: value and null indicator are returned by a single call
+TEST(ResultSetAPITest, NullableGetters) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 3);
+
+    const ApiString select = ODBC_TEXT("SELECT id, CASE WHEN id = 0 THEN NULL ELSE id END, amount FROM numbers ORDER BY id;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+
+    bool is_null = false;
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_EQ(get_int_value_nullable_by_index(res, 0, &is_null, &error), 0);
+    EXPECT_FALSE(is_null);
+    EXPECT_EQ(get_long_value_nullable_by_index(res, 1, &is_null, &error), 0);
+    EXPECT_TRUE(is_null);
+    assert_no_error(error);
+
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_EQ(get_long_value_nullable_by_index(res, 1, &is_null, &error), 1);
+    EXPECT_FALSE(is_null);
+    EXPECT_DOUBLE_EQ(get_double_value_nullable_by_index(res, 2, &is_null, &error), 0.5);
+    EXPECT_FALSE(is_null);
+    // the indicator is optional
+    EXPECT_EQ(get_short_value_nullable_by_index(res, 0, nullptr, &error), 1);
+    assert_no_error(error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+// Test: rows read ahead on a background thread across several blocks
+TEST(ResultSetAPITest, PrefetchRows) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 10);
+
+    const ApiString select = ODBC_TEXT("SELECT id, label, amount FROM numbers ORDER BY id;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    enable_prefetch(res, 4, &error);
+    assert_no_error(error);
+
+    int rows = 0;
+    while (next_result(res, &error)) {
+        assert_no_error(error);
+        EXPECT_EQ(get_int_value_by_index(res, 0, &error), rows);
+        EXPECT_DOUBLE_EQ(get_double_value_by_index(res, 2, &error), rows * 0.5);
+        EXPECT_EQ(get_row_position_result(res, &error), rows + 1);
+
+        const ApiChar* label = get_string_value_by_index(res, 1, &error);
+        assert_no_error(error);
+        if (rows % 3 == 0) {
+            EXPECT_EQ(label, nullptr);
+            EXPECT_TRUE(was_null_by_index(res, 1, &error));
+        } else {
+            ASSERT_NE(label, nullptr);
+            EXPECT_EQ(ApiString(label), ODBC_TEXT("row") + static_cast<ApiString>(StringProxy(std::to_string(rows))));
+            std_free(const_cast<ApiChar*>(label));
+        }
+        ++rows;
+    }
+    assert_no_error(error);
+    EXPECT_EQ(rows, 10);
+    EXPECT_FALSE(next_result(res, &error));
+    assert_no_error(error);
+
+    // the cursor is forward-only while prefetching
+    NativeError scroll_error;
+    EXPECT_FALSE(previous_result(res, &scroll_error));
+    assert_has_error(scroll_error);
+
+    NativeError invalid_error;
+    enable_prefetch(res, 0, &invalid_error);
+    assert_has_error(invalid_error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+// Test: rows fetched ahead before a failure are handed out before the error
+TEST(ResultSetAPITest, PrefetchPartialBatchBeforeError) {
+    int fetched = 0;
+    RowPrefetcher prefetcher([&fetched](ColumnBatch& batch, int max_rows) {
+        batch.reset(1, max_rows);
+        batch.columns[0].reset(COLUMN_BATCH_INT32, max_rows);
+        int rows = 0;
+        for (; rows < max_rows; ++rows, ++fetched) {
+            if (fetched == 6) {
+                throw std::runtime_error("connection lost");
+            }
+            batch.columns[0].put_fixed(rows, &fetched, sizeof(fetched));
+            batch.row_count = rows + 1;
+        }
+        return rows;
+    }, 4);
+
+    const ColumnBatch* batch = prefetcher.next_batch();
+    ASSERT_NE(batch, nullptr);
+    EXPECT_EQ(batch->row_count, 4);
+    batch = prefetcher.next_batch();
+    ASSERT_NE(batch, nullptr);
+    EXPECT_EQ(batch->row_count, 2);
+    EXPECT_THROW(prefetcher.next_batch(), std::runtime_error);
+}
+
+// Test: scrolling back and forth over a forward-only cursor through the row cache
+TEST(ResultSetAPITest, RowCacheScrolling) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 200);
+
+    const ApiString select = ODBC_TEXT("SELECT id, label, amount FROM numbers ORDER BY id;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    // a budget of 0 keeps every row in the spill file
+    enable_row_cache(res, 0, &error);
+    assert_no_error(error);
+
+    ASSERT_TRUE(next_result(res, &error));
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 1);
+    ASSERT_TRUE(previous_result(res, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 0);
+    EXPECT_TRUE(was_null_by_index(res, 1, &error));
+    EXPECT_FALSE(previous_result(res, &error));
+
+    ASSERT_TRUE(last_result(res, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 199);
+    EXPECT_EQ(get_row_position_result(res, &error), 200);
+    EXPECT_FALSE(next_result(res, &error));
+
+    ASSERT_TRUE(absolute_result(res, 101, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 100);
+    EXPECT_DOUBLE_EQ(get_double_value_by_index(res, 2, &error), 50.0);
+    const ApiChar* label = get_string_value_by_index(res, 1, &error);
+    ASSERT_NE(label, nullptr);
+    EXPECT_EQ(ApiString(label), ODBC_TEXT("row100"));
+    std_free(const_cast<ApiChar*>(label));
+
+    ASSERT_TRUE(relative_result(res, -3, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 97);
+    ASSERT_TRUE(relative_result(res, 2, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 99);
+    EXPECT_FALSE(relative_result(res, 200, &error));
+    assert_no_error(error);
+
+    ASSERT_TRUE(first_result(res, &error));
+    EXPECT_EQ(get_int_value_by_index(res, 0, &error), 0);
+    assert_no_error(error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+// Test: a memory budget smaller than an arena block still keeps rows in memory
+TEST(ResultSetAPITest, RowCacheSmallBudget) {
+    const auto fetch_from = [](int& fetched) {
+        return [&fetched](ColumnBatch& batch, int max_rows) {
+            batch.reset(1, max_rows);
+            batch.columns[0].reset(COLUMN_BATCH_INT32, max_rows);
+            int rows = 0;
+            for (; rows < max_rows && fetched < 1000; ++rows, ++fetched) {
+                batch.columns[0].put_fixed(rows, &fetched, sizeof(fetched));
+            }
+            batch.row_count = rows;
+            return rows;
+        };
+    };
+    int spilled_rows = 0;
+    int cached_rows = 0;
+    RowCache spilled(fetch_from(spilled_rows), {COLUMN_BATCH_INT32}, 0);
+    RowCache cached(fetch_from(cached_rows), {COLUMN_BATCH_INT32}, 4096);
+    ASSERT_TRUE(spilled.last());
+    ASSERT_TRUE(cached.last());
+    EXPECT_EQ(cached.size(), 1000u);
+    EXPECT_GT(cached.spilled_bytes(), 0u);
+    EXPECT_LT(cached.spilled_bytes(), spilled.spilled_bytes());
+
+    ASSERT_TRUE(cached.absolute(1));
+    int32_t first = -1;
+    std::memcpy(&first, cached.value(0).data, sizeof(first));
+    EXPECT_EQ(first, 0);
+}
+
+// Test: values of every row come from the arena and are not freed by the caller
+TEST(ResultSetAPITest, ValueArenaValues) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    setup_numbers_table(conn, error, 50);
+
+    const ApiString select = ODBC_TEXT("SELECT id, label, amount FROM numbers ORDER BY id;");
+    auto* res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    enable_value_arena(res, &error);
+    assert_no_error(error);
+
+    int rows = 0;
+    while (next_result(res, &error)) {
+        const ApiChar* label = get_string_value_by_index(res, 1, &error);
+        const BinaryArray* bytes = get_bytes_array_by_index(res, 1, &error);
+        assert_no_error(error);
+        if (rows % 3 == 0) {
+            EXPECT_EQ(label, nullptr);
+            EXPECT_EQ(bytes, nullptr);
+        } else {
+            const std::string expected = "row" + std::to_string(rows);
+            ASSERT_NE(label, nullptr);
+            EXPECT_EQ(ApiString(label), static_cast<ApiString>(StringProxy(expected)));
+            ASSERT_NE(bytes, nullptr);
+            EXPECT_EQ(std::string(reinterpret_cast<const char*>(bytes->data), bytes->length), expected);
+        }
+        ++rows;
+    }
+    EXPECT_EQ(rows, 50);
+    assert_no_error(error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+// Test: a large BLOB read through small buffered reads and large direct reads
+TEST(ResultSetAPITest, BinaryStreamChunks) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+
+    const ApiString create = ODBC_TEXT("CREATE TABLE blobs (data BLOB);");
+    auto* res = execute_request(conn, create.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+
+    std::vector<uint8_t> expected(100000);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        expected[i] = static_cast<uint8_t>(i * 7 + i / 251);
+    }
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert = ODBC_TEXT("INSERT INTO blobs VALUES (?);");
+    prepare_statement(stmt, insert.c_str(), &error);
+    BinaryArray value(expected);
+    set_binary_array_value(stmt, 0, &value, &error);
+    res = execute(stmt, 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    close_statement(stmt, &error);
+    assert_no_error(error);
+
+    const ApiString select = ODBC_TEXT("SELECT data FROM blobs;");
+    res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(next_result(res, &error));
+    ChunkedBinaryStream* stream = get_binary_stream_by_index(res, 0, &error);
+    ASSERT_NE(stream, nullptr);
+
+    std::vector<uint8_t> actual(expected.size() + 16);
+    size_t total = 0;
+    int requested = 100;
+    while (true) {
+        const int read = read_binary_stream(stream, actual.data(), static_cast<int>(total), requested, &error);
+        assert_no_error(error);
+        if (read < 0) {
+            break;
+        }
+        total += static_cast<size_t>(read);
+        // alternate small reads through the chunk and large reads into the buffer
+        requested = requested == 100 ? 30000 : 100;
+        requested = std::min<int>(requested, static_cast<int>(actual.size() - total));
+    }
+    actual.resize(total);
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(read_binary_stream(stream, actual.data(), 0, 10, &error), -1);
+
+    close_binary_stream(stream);
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+// Test: bytes of binary, character and numeric columns, and NULL in each
+TEST(ResultSetAPITest, BytesArrayByColumnType) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+
+    const ApiString create = ODBC_TEXT("CREATE TABLE mixed (data BLOB, label VARCHAR(20), amount INTEGER);");
+    auto* res = execute_request(conn, create.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+
+    // longer than the first read, so the array is sized from the reported length
+    std::vector<uint8_t> expected(1000);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        expected[i] = static_cast<uint8_t>(i * 13);
+    }
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert = ODBC_TEXT("INSERT INTO mixed VALUES (?, 'text', 42), (NULL, NULL, NULL);");
+    prepare_statement(stmt, insert.c_str(), &error);
+    BinaryArray value(expected);
+    set_binary_array_value(stmt, 0, &value, &error);
+    res = execute(stmt, 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    close_statement(stmt, &error);
+    assert_no_error(error);
+
+    const ApiString select = ODBC_TEXT("SELECT data, label, amount FROM mixed;");
+    res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(next_result(res, &error));
+
+    BinaryArray* data = get_bytes_array_by_index(res, 0, &error);
+    assert_no_error(error);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data->to_vector(), expected);
+    EXPECT_FALSE(was_null_by_index(res, 0, &error));
+    delete_binary_array(data);
+
+    BinaryArray* label = get_bytes_array_by_index(res, 1, &error);
+    assert_no_error(error);
+    ASSERT_NE(label, nullptr);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(label->data), label->length), "text");
+    delete_binary_array(label);
+
+    BinaryArray* amount = get_bytes_array_by_index(res, 2, &error);
+    assert_no_error(error);
+    ASSERT_NE(amount, nullptr);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(amount->data), amount->length), "42");
+    delete_binary_array(amount);
+
+    ASSERT_TRUE(next_result(res, &error));
+    for (int column = 0; column < 3; ++column) {
+        EXPECT_EQ(get_bytes_array_by_index(res, column, &error), nullptr);
+        assert_no_error(error);
+        EXPECT_TRUE(was_null_by_index(res, column, &error));
+    }
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
+
+// Test: long multibyte text read through small buffered reads and large direct reads
+TEST(ResultSetAPITest, CharacterStreamChunks) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+
+    const ApiString create = ODBC_TEXT("CREATE TABLE texts (data TEXT);");
+    auto* res = execute_request(conn, create.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+
+    // 2, 3 and 4 byte sequences in UTF-8, so chunk boundaries fall inside them
+    std::u16string expected;
+    while (expected.size() < 50000) {
+        expected += u"\u043F\u0440\u0438\u0432\u0435\u0442 \u20AC\U0001F600 ";
+    }
+    const ApiString text(expected.begin(), expected.end());
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert = ODBC_TEXT("INSERT INTO texts VALUES (?), (NULL);");
+    prepare_statement(stmt, insert.c_str(), &error);
+    set_string_value(stmt, 0, text.c_str(), &error);
+    res = execute(stmt, 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    close_statement(stmt, &error);
+    assert_no_error(error);
+
+    const ApiString select = ODBC_TEXT("SELECT data FROM texts;");
+    res = execute_request(conn, select.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(next_result(res, &error));
+    ChunkedCharacterStream* stream = get_character_stream_by_index(res, 0, &error);
+    assert_no_error(error);
+    ASSERT_NE(stream, nullptr);
+
+    std::vector<ApiChar> actual(expected.size() + 16);
+    size_t total = 0;
+    int requested = 7;
+    while (true) {
+        const int read = read_character_stream(stream, actual.data(), static_cast<int>(total), requested, &error);
+        assert_no_error(error);
+        if (read < 0) {
+            break;
+        }
+        total += static_cast<size_t>(read);
+        // alternate small reads through the chunk and large reads into the buffer
+        requested = requested == 7 ? 20000 : 7;
+        requested = std::min<int>(requested, static_cast<int>(actual.size() - total));
+    }
+    EXPECT_EQ(ApiString(actual.data(), total), text);
+    EXPECT_EQ(read_character_stream(stream, actual.data(), 0, 10, &error), -1);
+    close_character_stream(stream);
+
+    ASSERT_TRUE(next_result(res, &error));
+    EXPECT_EQ(get_character_stream_by_index(res, 0, &error), nullptr);
+    assert_no_error(error);
+
+    close_result(res, &error);
+    disconnect(conn, &error);
+}
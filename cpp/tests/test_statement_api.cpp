@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <string>
 #include <vector>
 #include "api/connection.h"
@@ -25,7 +28,7 @@ TEST(StatementAPITest, PrepareAndExecuteSimpleQuery) {
     assert_no_error(error);
 
     // Prepare INSERT
-    nanodbc::statement* stmt = create_statement(conn, &error);
+    Statement* stmt = create_statement(conn, &error);
     ASSERT_NE(stmt, nullptr);
     assert_no_error(error);
 
@@ -77,7 +80,7 @@ TEST(StatementAPITest, SetNumericParameterTypes) {
     close_result(res, &error);
     assert_no_error(error);
 
-    nanodbc::statement* stmt = create_statement(conn, &error);
+    Statement* stmt = create_statement(conn, &error);
     ASSERT_NE(stmt, nullptr);
     const ApiString insert_sql = ODBC_TEXT("INSERT INTO nums VALUES (?, ?, ?, ?, ?);");
     prepare_statement(stmt, insert_sql.c_str(), &error);
@@ -114,7 +117,7 @@ TEST(StatementAPITest, SetDateTimeAndBool) {
     close_result(res, &error);
     assert_no_error(error);
 
-    nanodbc::statement* stmt = create_statement(conn, &error);
+    Statement* stmt = create_statement(conn, &error);
     ASSERT_NE(stmt, nullptr);
     const ApiString insert_sql = ODBC_TEXT("INSERT INTO events VALUES (?, ?, ?, ?);");
     prepare_statement(stmt, insert_sql.c_str(), &error);
@@ -156,7 +159,7 @@ TEST(StatementAPITest, SetBinaryData) {
     close_result(res, &error);
     assert_no_error(error);
 
-    nanodbc::statement* stmt = create_statement(conn, &error);
+    Statement* stmt = create_statement(conn, &error);
     ASSERT_NE(stmt, nullptr);
     const ApiString insert_sql = ODBC_TEXT("INSERT INTO blobs VALUES (?);");
     prepare_statement(stmt, insert_sql.c_str(), &error);
@@ -184,7 +187,7 @@ TEST(StatementAPITest, ExecuteWithTimeout) {
     ASSERT_NE(conn, nullptr);
     assert_no_error(error);
 
-    nanodbc::statement* stmt = create_statement(conn, &error);
+    Statement* stmt = create_statement(conn, &error);
     ASSERT_NE(stmt, nullptr);
     const ApiString sql = ODBC_TEXT("SELECT 1;");
     prepare_statement(stmt, sql.c_str(), &error);
@@ -200,4 +203,491 @@ TEST(StatementAPITest, ExecuteWithTimeout) {
     close_statement(stmt, &error);
     disconnect(conn, &error);
     assert_no_error(error);
-}
\ No newline at end of file
+}
+// Test: rows added to a batch are inserted by one execution with a parameter array
+TEST(StatementAPITest, ExecuteBatch) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    assert_no_error(error);
+
+    const ApiString create_sql = ODBC_TEXT("CREATE TABLE users (id INTEGER, name VARCHAR(50));");
+    auto* res = execute_request(conn, create_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    assert_no_error(error);
+
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert_sql = ODBC_TEXT("INSERT INTO users (id, name) VALUES (?, ?);");
+    prepare_statement(stmt, insert_sql.c_str(), &error);
+    assert_no_error(error);
+
+    constexpr int rows = 100;
+    for (int i = 0; i < rows; ++i) {
+        set_int_value(stmt, 0, i, &error);
+        const ApiString name = ODBC_TEXT("user") + static_cast<ApiString>(StringProxy(std::to_string(i)));
+        set_string_value(stmt, 1, i % 10 == 0 ? nullptr : name.c_str(), &error);
+        add_batch(stmt, &error);
+        assert_no_error(error);
+    }
+
+    std::vector<int> counts(rows, 0);
+    EXPECT_EQ(execute_batch(stmt, 10, counts.data(), rows, &error), rows);
+    assert_no_error(error);
+    for (const int count : counts) {
+        EXPECT_TRUE(count == 1 || count == -2);
+    }
+    // the batch is empty afterwards
+    EXPECT_EQ(execute_batch(stmt, 10, counts.data(), rows, &error), 0);
+    assert_no_error(error);
+
+    const ApiString select_sql = ODBC_TEXT("SELECT COUNT(*), COUNT(name), SUM(id) FROM users;");
+    res = execute_request(conn, select_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(res->next());
+    EXPECT_EQ(res->get<int>(0), rows);
+    EXPECT_EQ(res->get<int>(1), rows - rows / 10);
+    EXPECT_EQ(res->get<int>(2), rows * (rows - 1) / 2);
+    close_result(res, &error);
+    assert_no_error(error);
+
+    // a row missing a value is rejected
+    set_int_value(stmt, 0, 1, &error);
+    add_batch(stmt, &error);
+    assert_has_error(error);
+
+    // a parameter changing its type is rejected without affecting the batch
+    set_string_value(stmt, 1, nullptr, &error);
+    add_batch(stmt, &error);
+    assert_no_error(error);
+    set_double_value(stmt, 0, 1.5, &error);
+    add_batch(stmt, &error);
+    assert_has_error(error);
+    clear_batch(stmt, &error);
+    assert_no_error(error);
+    EXPECT_EQ(execute_batch(stmt, 10, nullptr, 0, &error), 0);
+
+    close_statement(stmt, &error);
+    disconnect(conn, &error);
+    assert_no_error(error);
+}
+
+// Test: execute_batch runs parameter columns bound as typed arrays with null bitmaps
+TEST(StatementAPITest, ExecuteBatchWithColumns) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    assert_no_error(error);
+
+    const ApiString create_sql = ODBC_TEXT("CREATE TABLE readings (id INTEGER, total BIGINT, value DOUBLE, name VARCHAR(50));");
+    auto* res = execute_request(conn, create_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    assert_no_error(error);
+
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert_sql = ODBC_TEXT("INSERT INTO readings (id, total, value, name) VALUES (?, ?, ?, ?);");
+    prepare_statement(stmt, insert_sql.c_str(), &error);
+    assert_no_error(error);
+
+    constexpr int rows = 1000;
+    std::vector<int32_t> ids(rows);
+    std::vector<int64_t> totals(rows);
+    std::vector<double> values(rows);
+    std::vector<uint8_t> nulls((rows + 7) / 8, 0);
+    ApiString names;
+    std::vector<int32_t> offsets{0};
+    for (int i = 0; i < rows; ++i) {
+        ids[i] = i;
+        totals[i] = static_cast<int64_t>(i) << 32;
+        values[i] = i * 0.5;
+        if (i % 10 == 0) {
+            nulls[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+        } else {
+            names += ODBC_TEXT("name") + static_cast<ApiString>(StringProxy(std::to_string(i)));
+        }
+        offsets.push_back(static_cast<int32_t>(names.size()));
+    }
+
+    set_int_column(stmt, 0, ids.data(), nullptr, rows, &error);
+    assert_no_error(error);
+    set_long_column(stmt, 1, totals.data(), nulls.data(), rows, &error);
+    assert_no_error(error);
+    // every column must have the same number of rows
+    set_double_column(stmt, 2, values.data(), nullptr, rows - 1, &error);
+    assert_has_error(error);
+    set_double_column(stmt, 2, values.data(), nullptr, rows, &error);
+    assert_no_error(error);
+    const int length = static_cast<int>(names.size());
+    // offsets past the data or going backwards are rejected
+    set_string_column(stmt, 3, names.c_str(), length - 1, offsets.data(), nulls.data(), rows, &error);
+    assert_has_error(error);
+    std::swap(offsets[1], offsets[2]);
+    set_string_column(stmt, 3, names.c_str(), length, offsets.data(), nulls.data(), rows, &error);
+    assert_has_error(error);
+    std::swap(offsets[1], offsets[2]);
+    set_string_column(stmt, 3, names.c_str(), length, offsets.data(), nulls.data(), rows, &error);
+    assert_no_error(error);
+
+    std::vector<int> counts(rows, 0);
+    EXPECT_EQ(execute_batch(stmt, 10, counts.data(), rows, &error), rows);
+    assert_no_error(error);
+
+    const ApiString select_sql = ODBC_TEXT("SELECT COUNT(*), COUNT(total), COUNT(name), SUM(id), SUM(value), MAX(name) FROM readings;");
+    res = execute_request(conn, select_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(res->next());
+    EXPECT_EQ(res->get<int>(0), rows);
+    EXPECT_EQ(res->get<int>(1), rows - rows / 10);
+    EXPECT_EQ(res->get<int>(2), rows - rows / 10);
+    EXPECT_EQ(res->get<int>(3), rows * (rows - 1) / 2);
+    EXPECT_DOUBLE_EQ(res->get<double>(4), rows * (rows - 1) / 4.0);
+    EXPECT_EQ(res->get<nanodbc::string>(5), NANODBC_TEXT("name999"));
+    close_result(res, &error);
+    assert_no_error(error);
+
+    // a parameter left unbound is rejected
+    set_int_column(stmt, 0, ids.data(), nullptr, rows, &error);
+    assert_no_error(error);
+    EXPECT_EQ(execute_batch(stmt, 10, nullptr, 0, &error), -1);
+    assert_has_error(error);
+
+    close_statement(stmt, &error);
+    disconnect(conn, &error);
+    assert_no_error(error);
+}
+
+// Test: re-executing with new values overwrites the bound parameter buffers, including NULL and longer strings
+TEST(StatementAPITest, ReexecuteWithNewValues) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    assert_no_error(error);
+
+    const ApiString create_sql = ODBC_TEXT("CREATE TABLE notes (id INTEGER, note VARCHAR(200), data BLOB);");
+    auto* res = execute_request(conn, create_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    assert_no_error(error);
+
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert_sql = ODBC_TEXT("INSERT INTO notes (id, note, data) VALUES (?, ?, ?);");
+    prepare_statement(stmt, insert_sql.c_str(), &error);
+    assert_no_error(error);
+
+    const std::vector<ApiString> notes = {ODBC_TEXT("short"), ApiString(150, ODBC_TEXT('n')), ODBC_TEXT(""), ODBC_TEXT("x")};
+    for (int i = 0; i < 5; ++i) {
+        set_int_value(stmt, 0, i, &error);
+        set_string_value(stmt, 1, i < 4 ? notes[i].c_str() : nullptr, &error);
+        const std::vector<uint8_t> bytes(static_cast<size_t>(i) * 20, static_cast<uint8_t>(i));
+        BinaryArray data(bytes.data(), static_cast<int32_t>(bytes.size()));
+        set_binary_array_value(stmt, 2, i % 2 == 0 ? &data : nullptr, &error);
+        assert_no_error(error);
+        res = execute(stmt, 10, &error);
+        ASSERT_NE(res, nullptr);
+        close_result(res, &error);
+        assert_no_error(error);
+    }
+    close_statement(stmt, &error);
+
+    const ApiString select_sql = ODBC_TEXT("SELECT id, note, LENGTH(data) FROM notes ORDER BY id;");
+    res = execute_request(conn, select_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(res->next());
+        EXPECT_EQ(res->get<int>(0), i);
+        if (i < 4) {
+            EXPECT_EQ(res->get<nanodbc::string>(1), notes[i]);
+        } else {
+            EXPECT_TRUE(res->is_null(1));
+        }
+        if (i % 2 == 0) {
+            EXPECT_EQ(res->get<int>(2), i * 20);
+        } else {
+            EXPECT_TRUE(res->is_null(2));
+        }
+    }
+    close_result(res, &error);
+    disconnect(conn, &error);
+    assert_no_error(error);
+}
+
+// Test: a DECIMAL parameter set from a string keeps its value across re-executions with longer strings
+TEST(StatementAPITest, DecimalParameterFromString) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    assert_no_error(error);
+
+    const ApiString create_sql = ODBC_TEXT("CREATE TABLE prices (amount DECIMAL(10, 2));");
+    auto* res = execute_request(conn, create_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    assert_no_error(error);
+
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert_sql = ODBC_TEXT("INSERT INTO prices (amount) VALUES (?);");
+    prepare_statement(stmt, insert_sql.c_str(), &error);
+    assert_no_error(error);
+    const std::vector<ApiString> amounts = {ODBC_TEXT("1.5"), ODBC_TEXT("12345678.25")};
+    for (const auto& amount : amounts) {
+        set_string_value(stmt, 0, amount.c_str(), &error);
+        res = execute(stmt, 10, &error);
+        ASSERT_NE(res, nullptr);
+        close_result(res, &error);
+        assert_no_error(error);
+    }
+    close_statement(stmt, &error);
+
+    const ApiString select_sql = ODBC_TEXT("SELECT amount FROM prices ORDER BY amount;");
+    res = execute_request(conn, select_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(res->next());
+    EXPECT_DOUBLE_EQ(res->get<double>(0), 1.5);
+    ASSERT_TRUE(res->next());
+    EXPECT_DOUBLE_EQ(res->get<double>(0), 12345678.25);
+    close_result(res, &error);
+    disconnect(conn, &error);
+    assert_no_error(error);
+}
+
+// Test: stream parameters are sent in chunks while executing, and send NULL once read
+TEST(StatementAPITest, StreamParameters) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    assert_no_error(error);
+
+    const ApiString create_sql = ODBC_TEXT("CREATE TABLE files (id INTEGER, body TEXT, data BLOB);");
+    auto* res = execute_request(conn, create_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    assert_no_error(error);
+
+    struct Source {
+        size_t size;
+        size_t position = 0;
+        int calls = 0;
+    };
+    // fills each chunk with the low byte of the position, larger than the 64 KiB chunks
+    const BinaryStreamReader read_bytes = [](void* context, uint8_t* buffer, int length) {
+        auto* source = static_cast<Source*>(context);
+        ++source->calls;
+        const size_t count = std::min(source->size - source->position, static_cast<size_t>(length));
+        for (size_t i = 0; i < count; ++i) {
+            buffer[i] = static_cast<uint8_t>(source->position + i);
+        }
+        source->position += count;
+        return static_cast<int>(count);
+    };
+    const CharacterStreamReader read_chars = [](void* context, ApiChar* buffer, int length) {
+        auto* source = static_cast<Source*>(context);
+        ++source->calls;
+        const size_t count = std::min(source->size - source->position, static_cast<size_t>(length));
+        std::fill_n(buffer, count, static_cast<ApiChar>('a' + source->calls % 26));
+        source->position += count;
+        return static_cast<int>(count);
+    };
+
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert_sql = ODBC_TEXT("INSERT INTO files (id, body, data) VALUES (?, ?, ?);");
+    prepare_statement(stmt, insert_sql.c_str(), &error);
+    assert_no_error(error);
+
+    Source bytes{200000};
+    Source chars{100000};
+    set_int_value(stmt, 0, 1, &error);
+    set_character_stream_value(stmt, 1, read_chars, &chars, static_cast<long long>(chars.size), &error);
+    set_binary_stream_value(stmt, 2, read_bytes, &bytes, -1, &error);
+    assert_no_error(error);
+    res = execute(stmt, 10, &error);
+    assert_no_error(error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+    EXPECT_EQ(bytes.position, bytes.size);
+    EXPECT_GT(bytes.calls, 2);
+    EXPECT_EQ(chars.position, chars.size);
+
+    // the streams were read by the first execution
+    set_int_value(stmt, 0, 2, &error);
+    res = execute(stmt, 10, &error);
+    assert_no_error(error);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+
+    // a stream cannot become a batch row
+    Source empty{0};
+    set_binary_stream_value(stmt, 2, read_bytes, &empty, 0, &error);
+    add_batch(stmt, &error);
+    assert_has_error(error);
+    close_statement(stmt, &error);
+    assert_no_error(error);
+
+    const ApiString select_sql = ODBC_TEXT("SELECT id, LENGTH(body), LENGTH(data), HEX(SUBSTR(data, 70001, 1)) FROM files ORDER BY id;");
+    res = execute_request(conn, select_sql.c_str(), 10, &error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(res->next());
+    EXPECT_EQ(res->get<int>(1), 100000);
+    EXPECT_EQ(res->get<int>(2), 200000);
+    EXPECT_EQ(res->get<nanodbc::string>(3), ODBC_TEXT("70"));
+    ASSERT_TRUE(res->next());
+    EXPECT_TRUE(res->is_null(1));
+    EXPECT_TRUE(res->is_null(2));
+    close_result(res, &error);
+    disconnect(conn, &error);
+    assert_no_error(error);
+}
+
+// Test: executions started asynchronously finish in the background and hand over their results
+TEST(StatementAPITest, ExecuteAsync) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    assert_no_error(error);
+
+    const ApiString create_sql = ODBC_TEXT("CREATE TABLE jobs (id INTEGER);");
+    AsyncExecution* execution = execute_request_async(conn, create_sql.c_str(), 10, &error);
+    ASSERT_NE(execution, nullptr);
+    EXPECT_EQ(wait_for_execution(execution, 10000, &error), 1);
+    EXPECT_EQ(poll_execution(execution, &error), 1);
+    assert_no_error(error);
+    close_execution(execution, &error);
+    assert_no_error(error);
+
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert_sql = ODBC_TEXT("INSERT INTO jobs (id) VALUES (?);");
+    prepare_statement(stmt, insert_sql.c_str(), &error);
+    for (int i = 0; i < 3; ++i) {
+        set_int_value(stmt, 0, i, &error);
+        execution = execute_async(stmt, 10, &error);
+        ASSERT_NE(execution, nullptr);
+        while (poll_execution(execution, &error) == 0) {
+            wait_for_execution(execution, 1, &error);
+        }
+        assert_no_error(error);
+        close_execution(execution, &error);
+    }
+    close_statement(stmt, &error);
+    assert_no_error(error);
+
+    const ApiString select_sql = ODBC_TEXT("SELECT COUNT(*) FROM jobs;");
+    execution = execute_request_async(conn, select_sql.c_str(), 10, &error);
+    ASSERT_NE(execution, nullptr);
+    ASSERT_EQ(wait_for_execution(execution, 10000, &error), 1);
+    // cancelling a finished execution leaves its results alone
+    cancel_execution(execution, &error);
+    ResultSet* res = execution_result(execution, 1, &error);
+    assert_no_error(error);
+    ASSERT_NE(res, nullptr);
+    ASSERT_TRUE(res->next());
+    EXPECT_EQ(res->get<int>(0), 3);
+    close_result(res, &error);
+    close_execution(execution, &error);
+
+    const ApiString broken_sql = ODBC_TEXT("SELECT * FROM missing_table;");
+    execution = execute_request_async(conn, broken_sql.c_str(), 10, &error);
+    if (execution) {
+        wait_for_execution(execution, 10000, &error);
+        EXPECT_EQ(execution_result(execution, 1, &error), nullptr);
+        assert_has_error(error);
+        close_execution(execution, &error);
+    } else {
+        // the driver rejected the SQL while preparing it
+        assert_has_error(error);
+    }
+    disconnect(conn, &error);
+    assert_no_error(error);
+}
+
+// Test: executions and fetches started with a callback report their outcome from the event loop
+TEST(StatementAPITest, ExecuteWithCallback) {
+    NativeError error;
+    Connection* conn = create_in_memory_db(error);
+    ASSERT_NE(conn, nullptr);
+    assert_no_error(error);
+
+    struct Outcome {
+        std::promise<ResultSet*> result;
+        std::string message;
+    };
+    const ExecutionCallback on_executed = [](void* context, ResultSet* result, const char* error_message) {
+        auto* outcome = static_cast<Outcome*>(context);
+        if (error_message) {
+            outcome->message = error_message;
+        }
+        outcome->result.set_value(result);
+    };
+    const auto await_result = [](Outcome& outcome) {
+        std::future<ResultSet*> future = outcome.result.get_future();
+        EXPECT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        return future.get();
+    };
+
+    const ApiString create_sql = ODBC_TEXT("CREATE TABLE events (id INTEGER);");
+    Outcome created;
+    execute_request_with_callback(conn, create_sql.c_str(), 10, 1, on_executed, &created, &error);
+    assert_no_error(error);
+    ResultSet* res = await_result(created);
+    ASSERT_NE(res, nullptr);
+    close_result(res, &error);
+
+    Statement* stmt = create_statement(conn, &error);
+    ASSERT_NE(stmt, nullptr);
+    const ApiString insert_sql = ODBC_TEXT("INSERT INTO events (id) VALUES (?);");
+    prepare_statement(stmt, insert_sql.c_str(), &error);
+    for (int i = 1; i <= 2; ++i) {
+        set_int_value(stmt, 0, i, &error);
+        Outcome inserted;
+        execute_with_callback(stmt, 10, 1, on_executed, &inserted, &error);
+        assert_no_error(error);
+        res = await_result(inserted);
+        ASSERT_NE(res, nullptr);
+        close_result(res, &error);
+    }
+    close_statement(stmt, &error);
+
+    const ApiString select_sql = ODBC_TEXT("SELECT id FROM events ORDER BY id;");
+    Outcome selected;
+    execute_request_with_callback(conn, select_sql.c_str(), 10, 10, on_executed, &selected, &error);
+    res = await_result(selected);
+    ASSERT_NE(res, nullptr);
+
+    const FetchCallback on_fetched = [](void* context, int has_row, const char*) {
+        static_cast<std::promise<int>*>(context)->set_value(has_row);
+    };
+    std::vector<int> ids;
+    for (;;) {
+        std::promise<int> fetched;
+        std::future<int> has_row = fetched.get_future();
+        next_with_callback(res, on_fetched, &fetched, &error);
+        assert_no_error(error);
+        ASSERT_EQ(has_row.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        const int row = has_row.get();
+        ASSERT_GE(row, 0);
+        if (row == 0) {
+            break;
+        }
+        ids.push_back(res->get<int>(0));
+    }
+    EXPECT_EQ(ids, (std::vector<int>{1, 2}));
+    close_result(res, &error);
+
+    const ApiString broken_sql = ODBC_TEXT("SELECT * FROM missing_table;");
+    Outcome failed;
+    execute_request_with_callback(conn, broken_sql.c_str(), 10, 1, on_executed, &failed, &error);
+    assert_no_error(error);
+    EXPECT_EQ(await_result(failed), nullptr);
+    EXPECT_FALSE(failed.message.empty());
+
+    execute_request_with_callback(conn, select_sql.c_str(), 10, 1, nullptr, nullptr, &error);
+    assert_has_error(error);
+
+    disconnect(conn, &error);
+    assert_no_error(error);
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "utils/string_utils.hpp"
+#include "utils/utf_transcoder.hpp"
+
+// Test: round trip of ASCII longer than a vector block, mixed with multibyte text
+TEST(StringUtilsTest, Utf8Utf16RoundTrip) {
+    const std::string ascii(100, 'x');
+    const std::string text = ascii + "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 " + ascii + "\xF0\x9F\x98\x80" + ascii;
+    const std::u16string expected = std::u16string(100, u'x') + u"\u043F\u0440\u0438\u0432\u0435\u0442 "
+        + std::u16string(100, u'x') + u"\U0001F600" + std::u16string(100, u'x');
+
+    const std::u16string wide = utils::to_u16string(text);
+    EXPECT_EQ(wide, expected);
+    EXPECT_EQ(utils::to_string(wide), text);
+    EXPECT_EQ(utils::to_wstring(text), utils::to_wstring(expected));
+}
+
+// Test: ill-formed input is replaced with U+FFFD, one per maximal subpart
+TEST(StringUtilsTest, InvalidSequencesAreReplaced) {
+    // stray continuation, overlong, encoded surrogate, truncated 4-byte sequence
+    const std::string text = "a\x80" "b\xC0\xAF" "c\xED\xA0\x80" "d\xF0\x9F";
+    EXPECT_EQ(utils::to_u16string(text), u"a\uFFFDb\uFFFD\uFFFDc\uFFFD\uFFFD\uFFFDd\uFFFD");
+
+    const std::u16string lone_surrogates = {u'a', 0xD800, u'b', 0xDC00};
+    EXPECT_EQ(utils::to_string(lone_surrogates), "a\xEF\xBF\xBD" "b\xEF\xBF\xBD");
+}
+
+// Test: a sequence cut at the end is left out of the complete prefix
+TEST(StringUtilsTest, Utf8CompleteLength) {
+    const std::string text = "a\xD0\xBF\xE2\x82\xAC\xF0\x9F\x98\x80";
+    EXPECT_EQ(utils::utf::utf8_complete_length(text.data(), text.size()), text.size());
+    EXPECT_EQ(utils::utf::utf8_complete_length(text.data(), 2), 1u);
+    EXPECT_EQ(utils::utf::utf8_complete_length(text.data(), 5), 3u);
+    EXPECT_EQ(utils::utf::utf8_complete_length(text.data(), 9), 6u);
+    EXPECT_EQ(utils::utf::utf8_complete_length(text.data(), 0), 0u);
+}
+
+// Test: the kernel level matches the build target
+TEST(StringUtilsTest, SimdLevelDetected) {
+#if defined(__x86_64__) || defined(_M_X64)
+    EXPECT_NE(utils::utf::simd_level(), utils::utf::SimdLevel::Scalar);
+#else
+    EXPECT_EQ(utils::utf::simd_level(), utils::utf::SimdLevel::Scalar);
+#endif
+}
@@ -4,7 +4,9 @@ import com.sun.jna.Library;
 import com.sun.jna.Native;
 import com.sun.jna.Pointer;
 import io.github.nanodbc4j.internal.cstruct.NativeError;
+import io.github.nanodbc4j.internal.cstruct.PoolSettings;
 import io.github.nanodbc4j.internal.pointer.ConnectionPtr;
+import io.github.nanodbc4j.internal.pointer.ExecutionPtr;
 import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
 import io.github.nanodbc4j.internal.pointer.StatementPtr;
 
@@ -46,6 +48,25 @@ public interface ConnectionApi extends Library {
      */
     ConnectionPtr connection_with_user_pass_timeout(String dsn, String user, String pass, long timeout, NativeError error);
 
+    /**
+     * Takes a connection from the native pool for the connection string, connecting only if none is idle.
+     *
+     * @param connection_string connection string (UTF-16LE encoded)
+     * @param timeout connection timeout in seconds
+     * @param settings pool settings, replacing earlier ones; null for the defaults
+     * @param error error information output
+     * @return pointer to connection object, to be given back with pool_return
+     */
+    ConnectionPtr pool_borrow(String connection_string, long timeout, PoolSettings settings, NativeError error);
+
+    /**
+     * Gives a borrowed connection back to its pool, rolling back its open transaction.
+     *
+     * @param connection connection pointer, not to be used afterwards
+     * @param error error information output
+     */
+    void pool_return(ConnectionPtr connection, NativeError error);
+
     /**
      * Checks if connection is active.
      *
@@ -125,6 +146,24 @@ public interface ConnectionApi extends Library {
      */
     byte get_auto_commit_transaction(ConnectionPtr conn, NativeError error);
 
+    /**
+     * Enables/disables reading character data as SQL_C_WCHAR.
+     *
+     * @param conn connection pointer
+     * @param enabled wide fetch flag (1-enabled, 0-disabled)
+     * @param error error information output
+     */
+    void set_wide_char_fetch(ConnectionPtr conn, byte enabled, NativeError error);
+
+    /**
+     * Gets wide character fetch status.
+     *
+     * @param conn connection pointer
+     * @param error error information output
+     * @return wide fetch status (1-enabled, 0-disabled)
+     */
+    byte get_wide_char_fetch(ConnectionPtr conn, NativeError error);
+
     /**
      * Executes SQL query and returns result set.
      *
@@ -136,6 +175,29 @@ public interface ConnectionApi extends Library {
      */
     ResultSetPtr execute_request(ConnectionPtr conn, String sql, int timeout, NativeError error);
 
+    /**
+     * Executes SQL query and returns result set fetched in blocks of rows.
+     *
+     * @param conn connection pointer
+     * @param sql SQL query string
+     * @param timeout query timeout in seconds
+     * @param fetch_size number of rows fetched per round trip
+     * @param error error information output
+     * @return pointer to result set
+     */
+    ResultSetPtr execute_request_with_fetch_size(ConnectionPtr conn, String sql, int timeout, int fetch_size, NativeError error);
+
+    /**
+     * Starts executing SQL query on a new statement without waiting for it.
+     *
+     * @param conn connection pointer
+     * @param sql SQL query string
+     * @param timeout query timeout in seconds
+     * @param error error information output
+     * @return execution pointer
+     */
+    ExecutionPtr execute_request_async(ConnectionPtr conn, String sql, int timeout, NativeError error);
+
     /**
      * Creates prepared statement.
      *
@@ -145,6 +207,34 @@ public interface ConnectionApi extends Library {
      */
     StatementPtr create_statement(ConnectionPtr conn, NativeError error);
 
+    /**
+     * Creates statement prepared for the SQL, reusing an idle one from the statement cache.
+     *
+     * @param conn connection pointer
+     * @param sql SQL statement to prepare
+     * @param error error information output
+     * @return pointer to statement object
+     */
+    StatementPtr create_prepared_statement(ConnectionPtr conn, String sql, NativeError error);
+
+    /**
+     * Sets the number of idle prepared statements kept for reuse, 0 disables the cache.
+     *
+     * @param conn connection pointer
+     * @param size number of idle statements kept
+     * @param error error information output
+     */
+    void set_statement_cache_size(ConnectionPtr conn, int size, NativeError error);
+
+    /**
+     * Gets the number of idle prepared statements kept for reuse.
+     *
+     * @param conn connection pointer
+     * @param error error information output
+     * @return statement cache size, 0 if disabled
+     */
+    int get_statement_cache_size(ConnectionPtr conn, NativeError error);
+
     /**
      * Closes database connection.
      *
@@ -3,14 +3,21 @@ package io.github.nanodbc4j.internal.binding;
 import com.sun.jna.Library;
 import com.sun.jna.Native;
 import com.sun.jna.Pointer;
+import com.sun.jna.ptr.ByteByReference;
 import io.github.nanodbc4j.internal.cstruct.BinaryArray;
+import io.github.nanodbc4j.internal.cstruct.ColumnBatch;
 import io.github.nanodbc4j.internal.cstruct.DateStruct;
+import io.github.nanodbc4j.internal.cstruct.DecimalStruct;
 import io.github.nanodbc4j.internal.cstruct.NativeError;
+import io.github.nanodbc4j.internal.cstruct.RowLayout;
 import io.github.nanodbc4j.internal.cstruct.TimeStruct;
 import io.github.nanodbc4j.internal.cstruct.TimestampStruct;
 import io.github.nanodbc4j.internal.pointer.BinaryStreamPtr;
+import io.github.nanodbc4j.internal.pointer.CharacterStreamPtr;
 import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
 
+import java.nio.ByteBuffer;
+
 /**
  * JNA interface for ODBC result set operations.
  * Maps to native ODBC result set data retrieval functions.
@@ -36,6 +43,56 @@ public interface ResultApi extends Library {
      */
     byte next_result(ResultSetPtr results, NativeError error);
 
+    /**
+     * Creates an empty column batch.
+     *
+     * @param error error information output
+     * @return column batch structure
+     */
+    ColumnBatch create_column_batch(NativeError error);
+
+    /**
+     * Fetches up to max_rows rows into column batch buffers.
+     *
+     * @param results result set pointer
+     * @param max_rows maximum number of rows
+     * @param batch column batch to fill
+     * @param error error information output
+     * @return number of rows fetched, 0 at end, -1 on error
+     */
+    int fetch_batch(ResultSetPtr results, int max_rows, ColumnBatch batch, NativeError error);
+
+    /**
+     * Creates a row layout for read_row.
+     *
+     * @param results result set pointer
+     * @param error error information output
+     * @return row layout structure
+     */
+    RowLayout create_row_layout(ResultSetPtr results, NativeError error);
+
+    /**
+     * Packs the current row into a buffer.
+     *
+     * @param results result set pointer
+     * @param buffer direct destination buffer
+     * @param capacity buffer size in bytes
+     * @param layout row layout of the result set
+     * @param error error information output
+     * @return packed row size, larger than capacity if the row has to be read again into a bigger buffer, -1 on error
+     */
+    int read_row(ResultSetPtr results, ByteBuffer buffer, int capacity, RowLayout layout, NativeError error);
+
+    /**
+     * Exports remaining rows as an Arrow C stream.
+     *
+     * @param results result set pointer, must stay open until the stream is released
+     * @param batch_size maximum number of rows per record batch
+     * @param stream ArrowArrayStream structure address
+     * @param error error information output
+     */
+    void export_arrow_stream(ResultSetPtr results, int batch_size, Pointer stream, NativeError error);
+
     /**
      * Moves to previous result set row.
      *
@@ -73,6 +130,16 @@ public interface ResultApi extends Library {
      */
     byte absolute_result(ResultSetPtr results, int row, NativeError error);
 
+    /**
+     * Moves the given number of rows from the current row.
+     *
+     * @param results result set pointer
+     * @param rows rows to move, negative to move back
+     * @param error error information output
+     * @return 1 if the cursor is on a row
+     */
+    byte relative_result(ResultSetPtr results, int rows, NativeError error);
+
     /**
      * Gets current row position.
      *
@@ -91,6 +158,33 @@ public interface ResultApi extends Library {
      */
     int affected_rows_result(ResultSetPtr results, NativeError error);
 
+    /**
+     * Starts fetching rows ahead on a background thread. The cursor becomes forward-only.
+     *
+     * @param results result set pointer
+     * @param batch_rows number of rows fetched ahead per block
+     * @param error error information output
+     */
+    void enable_prefetch(ResultSetPtr results, int batch_rows, NativeError error);
+
+    /**
+     * Caches rows on the client so the result set can scroll over forward-only cursors.
+     *
+     * @param results result set pointer
+     * @param memory_budget bytes of rows kept in memory before spilling to a temporary file
+     * @param error error information output
+     */
+    void enable_row_cache(ResultSetPtr results, long memory_budget, NativeError error);
+
+    /**
+     * Allocates strings, dates, times, timestamps and byte arrays of the current row from
+     * an arena owned by the result set. They stay valid until the cursor moves and must not be freed.
+     *
+     * @param results result set pointer
+     * @param error error information output
+     */
+    void enable_value_arena(ResultSetPtr results, NativeError error);
+
     /**
      * Gets integer value by column index.
      *
@@ -151,6 +245,72 @@ public interface ResultApi extends Library {
      */
     short get_short_value_by_index(ResultSetPtr results, int index, NativeError error);
 
+    /**
+     * Gets integer value and its null indicator by column index in one call.
+     *
+     * @param results result set pointer
+     * @param index column index (0-based)
+     * @param is_null receives non-zero if the value is NULL
+     * @param error error information output
+     * @return integer value, 0 if NULL
+     */
+    int get_int_value_nullable_by_index(ResultSetPtr results, int index, ByteByReference is_null, NativeError error);
+
+    /**
+     * Gets long value and its null indicator by column index in one call.
+     *
+     * @param results result set pointer
+     * @param index column index (0-based)
+     * @param is_null receives non-zero if the value is NULL
+     * @param error error information output
+     * @return long value, 0 if NULL
+     */
+    long get_long_value_nullable_by_index(ResultSetPtr results, int index, ByteByReference is_null, NativeError error);
+
+    /**
+     * Gets double value and its null indicator by column index in one call.
+     *
+     * @param results result set pointer
+     * @param index column index (0-based)
+     * @param is_null receives non-zero if the value is NULL
+     * @param error error information output
+     * @return double value, 0 if NULL
+     */
+    double get_double_value_nullable_by_index(ResultSetPtr results, int index, ByteByReference is_null, NativeError error);
+
+    /**
+     * Gets boolean value and its null indicator by column index in one call.
+     *
+     * @param results result set pointer
+     * @param index column index (0-based)
+     * @param is_null receives non-zero if the value is NULL
+     * @param error error information output
+     * @return boolean value, 0 if NULL
+     */
+    byte get_bool_value_nullable_by_index(ResultSetPtr results, int index, ByteByReference is_null, NativeError error);
+
+    /**
+     * Gets float value and its null indicator by column index in one call.
+     *
+     * @param results result set pointer
+     * @param index column index (0-based)
+     * @param is_null receives non-zero if the value is NULL
+     * @param error error information output
+     * @return float value, 0 if NULL
+     */
+    float get_float_value_nullable_by_index(ResultSetPtr results, int index, ByteByReference is_null, NativeError error);
+
+    /**
+     * Gets short value and its null indicator by column index in one call.
+     *
+     * @param results result set pointer
+     * @param index column index (0-based)
+     * @param is_null receives non-zero if the value is NULL
+     * @param error error information output
+     * @return short value, 0 if NULL
+     */
+    short get_short_value_nullable_by_index(ResultSetPtr results, int index, ByteByReference is_null, NativeError error);
+
     /**
      * Gets string value by column index.
      *
@@ -161,6 +321,29 @@ public interface ResultApi extends Library {
      */
     Pointer get_string_value_by_index(ResultSetPtr results, int index, NativeError error);
 
+    /**
+     * Copies string value by column index into a buffer.
+     *
+     * @param results result set pointer
+     * @param index column index (0-based)
+     * @param buffer destination buffer
+     * @param capacity buffer size in characters
+     * @param error error information output
+     * @return value length in characters, larger than capacity if the call has to be repeated with a bigger buffer, -1 if NULL, -2 on error
+     */
+    int get_string_into_by_index(ResultSetPtr results, int index, Pointer buffer, int capacity, NativeError error);
+
+    /**
+     * Gets decimal value by column index as unscaled value and scale.
+     *
+     * @param results result set pointer
+     * @param index column index (0-based)
+     * @param value structure receiving the value
+     * @param error error information output
+     * @return non-zero if value was filled, 0 if NULL
+     */
+    byte get_decimal_by_index(ResultSetPtr results, int index, DecimalStruct value, NativeError error);
+
     /**
      * Gets date value by column index.
      *
@@ -223,6 +406,28 @@ public interface ResultApi extends Library {
      */
     int read_binary_stream(BinaryStreamPtr stream, byte[] buffer, int offset, int length, NativeError error);
 
+    /**
+     * Gets character stream by column index.
+     *
+     * @param results result set pointer
+     * @param index column index (0-based)
+     * @param error error information output
+     * @return character stream pointer, null if the value is NULL
+     */
+    CharacterStreamPtr get_character_stream_by_index(ResultSetPtr results, int index, NativeError error);
+
+    /**
+     * Reads UTF-16 code units from character stream.
+     *
+     * @param stream character stream pointer
+     * @param buffer destination buffer of UTF-16 code units
+     * @param offset buffer offset in code units
+     * @param length number of code units to read
+     * @param error error information output
+     * @return number of code units read, -1 at the end
+     */
+    int read_character_stream(CharacterStreamPtr stream, Pointer buffer, int offset, int length, NativeError error);
+
     /**
      * Checks if last value was NULL by column index.
      *
@@ -353,6 +558,16 @@ public interface ResultApi extends Library {
      */
     BinaryStreamPtr get_binary_stream_by_name(ResultSetPtr results, String name, NativeError error);
 
+    /**
+     * Gets character stream by column name.
+     *
+     * @param results result set pointer
+     * @param name column name
+     * @param error error information output
+     * @return character stream pointer, null if the value is NULL
+     */
+    CharacterStreamPtr get_character_stream_by_name(ResultSetPtr results, String name, NativeError error);
+
     /**
      * Finds column index by name.
      *
@@ -428,10 +643,31 @@ public interface ResultApi extends Library {
      */
     void close_result(ResultSetPtr results, NativeError error);
 
+    /**
+     * Frees column batch resources.
+     *
+     * @param batch column batch to delete
+     */
+    void delete_column_batch(ColumnBatch batch);
+
+    /**
+     * Frees row layout resources.
+     *
+     * @param layout row layout to delete
+     */
+    void delete_row_layout(RowLayout layout);
+
     /**
      * Closes binary stream and frees resources.
      *
      * @param stream binary stream pointer
      */
     void close_binary_stream(BinaryStreamPtr stream);
+
+    /**
+     * Closes character stream and frees resources.
+     *
+     * @param stream character stream pointer
+     */
+    void close_character_stream(CharacterStreamPtr stream);
 }
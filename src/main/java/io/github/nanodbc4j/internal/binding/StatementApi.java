@@ -1,12 +1,15 @@
 package io.github.nanodbc4j.internal.binding;
 
+import com.sun.jna.Callback;
 import com.sun.jna.Library;
 import com.sun.jna.Native;
+import com.sun.jna.Pointer;
 import io.github.nanodbc4j.internal.cstruct.BinaryArray;
 import io.github.nanodbc4j.internal.cstruct.DateStruct;
 import io.github.nanodbc4j.internal.cstruct.NativeError;
 import io.github.nanodbc4j.internal.cstruct.TimeStruct;
 import io.github.nanodbc4j.internal.cstruct.TimestampStruct;
+import io.github.nanodbc4j.internal.pointer.ExecutionPtr;
 import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
 import io.github.nanodbc4j.internal.pointer.StatementPtr;
 
@@ -145,6 +148,93 @@ public interface StatementApi extends Library {
      */
     void set_binary_array_value(StatementPtr stmt, int index, BinaryArray value, NativeError error);
 
+    /**
+     * Reads the next chunk of a binary stream parameter while the statement executes.
+     */
+    interface BinaryStreamReader extends Callback {
+        /**
+         * @param context value passed with the stream
+         * @param buffer receives up to length bytes
+         * @param length capacity of the buffer in bytes
+         * @return number of bytes written, 0 at the end of the stream, -1 on failure
+         */
+        int invoke(Pointer context, Pointer buffer, int length);
+    }
+
+    /**
+     * Reads the next chunk of a character stream parameter while the statement executes.
+     */
+    interface CharacterStreamReader extends Callback {
+        /**
+         * @param context value passed with the stream
+         * @param buffer receives up to length UTF-16 code units
+         * @param length capacity of the buffer in code units
+         * @return number of code units written, 0 at the end of the stream, -1 on failure
+         */
+        int invoke(Pointer context, Pointer buffer, int length);
+    }
+
+    /**
+     * Sets binary stream parameter value, read in chunks by the next execution.
+     *
+     * @param stmt statement pointer
+     * @param index parameter index (0-based)
+     * @param reader chunk reader, null for NULL
+     * @param context value passed to the reader
+     * @param length stream length in bytes, -1 if unknown
+     * @param error error information output
+     */
+    void set_binary_stream_value(StatementPtr stmt, int index, BinaryStreamReader reader, Pointer context, long length, NativeError error);
+
+    /**
+     * Sets character stream parameter value, read in chunks by the next execution.
+     *
+     * @param stmt statement pointer
+     * @param index parameter index (0-based)
+     * @param reader chunk reader, null for NULL
+     * @param context value passed to the reader
+     * @param length stream length in UTF-16 code units, -1 if unknown
+     * @param error error information output
+     */
+    void set_character_stream_value(StatementPtr stmt, int index, CharacterStreamReader reader, Pointer context, long length, NativeError error);
+
+    /**
+     * Binds a column of 32-bit integers for execute_batch. The memory is bound in place
+     * and must stay valid until the batch is executed or cleared.
+     *
+     * @param stmt statement pointer
+     * @param index parameter index (0-based)
+     * @param values rows values
+     * @param nulls null bitmap, bit (row % 8) of byte (row / 8) is set for NULL, may be null
+     * @param rows number of rows
+     * @param error error information output
+     */
+    void set_int_column(StatementPtr stmt, int index, Pointer values, byte[] nulls, int rows, NativeError error);
+
+    /**
+     * Binds a column of 64-bit integers for execute_batch, see {@link #set_int_column}.
+     */
+    void set_long_column(StatementPtr stmt, int index, Pointer values, byte[] nulls, int rows, NativeError error);
+
+    /**
+     * Binds a column of doubles for execute_batch, see {@link #set_int_column}.
+     */
+    void set_double_column(StatementPtr stmt, int index, Pointer values, byte[] nulls, int rows, NativeError error);
+
+    /**
+     * Binds a column of strings for execute_batch. The strings are copied.
+     *
+     * @param stmt statement pointer
+     * @param index parameter index (0-based)
+     * @param data UTF-16 code units of all strings, one after another
+     * @param length number of code units in data the offsets may address
+     * @param offsets rows + 1 non-decreasing offsets into data, string i ends where string i + 1 starts
+     * @param nulls null bitmap, bit (row % 8) of byte (row / 8) is set for NULL, may be null
+     * @param rows number of rows
+     * @param error error information output
+     */
+    void set_string_column(StatementPtr stmt, int index, char[] data, int length, int[] offsets, byte[] nulls, int rows, NativeError error);
+
     /**
      * Executes prepared statement.
      *
@@ -155,6 +245,100 @@ public interface StatementApi extends Library {
      */
     ResultSetPtr execute(StatementPtr stmt, int timeout, NativeError error);
 
+    /**
+     * Executes prepared statement and fetches rows in blocks.
+     *
+     * @param stmt statement pointer
+     * @param timeout execution timeout in seconds
+     * @param fetch_size number of rows fetched per round trip
+     * @param error error information output
+     * @return result set pointer
+     */
+    ResultSetPtr execute_with_fetch_size(StatementPtr stmt, int timeout, int fetch_size, NativeError error);
+
+    /**
+     * Starts executing prepared statement without waiting for it.
+     *
+     * @param stmt statement pointer
+     * @param timeout execution timeout in seconds
+     * @param error error information output
+     * @return execution pointer
+     */
+    ExecutionPtr execute_async(StatementPtr stmt, int timeout, NativeError error);
+
+    /**
+     * Advances execution without blocking.
+     *
+     * @param execution execution pointer
+     * @param error error information output
+     * @return 1 once finished, 0 while running, -1 on failure
+     */
+    int poll_execution(ExecutionPtr execution, NativeError error);
+
+    /**
+     * Waits for execution to finish.
+     *
+     * @param execution execution pointer
+     * @param timeout_millis milliseconds to wait at most
+     * @param error error information output
+     * @return 1 once finished, 0 while running, -1 on failure
+     */
+    int wait_for_execution(ExecutionPtr execution, int timeout_millis, NativeError error);
+
+    /**
+     * Asks the driver to stop execution.
+     *
+     * @param execution execution pointer
+     * @param error error information output
+     */
+    void cancel_execution(ExecutionPtr execution, NativeError error);
+
+    /**
+     * Opens results of finished execution.
+     *
+     * @param execution execution pointer
+     * @param fetch_size number of rows fetched per round trip
+     * @param error error information output, the execution's error if it failed
+     * @return result set pointer
+     */
+    ResultSetPtr execution_result(ExecutionPtr execution, int fetch_size, NativeError error);
+
+    /**
+     * Releases execution, cancelling it if still running.
+     *
+     * @param execution execution pointer
+     * @param error error information output
+     */
+    void close_execution(ExecutionPtr execution, NativeError error);
+
+    /**
+     * Adds the parameter values set so far as a row of the batch.
+     *
+     * @param stmt statement pointer
+     * @param error error information output
+     */
+    void add_batch(StatementPtr stmt, NativeError error);
+
+    /**
+     * Executes all rows of the batch in one round trip and clears it.
+     *
+     * @param stmt statement pointer
+     * @param timeout execution timeout in seconds
+     * @param row_counts receives the row count of each row, also on failure
+     * @param capacity number of entries row_counts can hold
+     * @param error error information output
+     * @return number of rows in the batch, -1 if it could not be executed at all
+     */
+    int execute_batch(StatementPtr stmt, int timeout, int[] row_counts, int capacity, NativeError error);
+
+    /**
+     * Removes all rows added to the batch.
+     *
+     * @param stmt statement pointer
+     * @param error error information output
+     */
+    void clear_batch(StatementPtr stmt, NativeError error);
+
     /**
      * Cancels statement execution.
      *
@@ -0,0 +1,82 @@
+package io.github.nanodbc4j.internal.cstruct;
+
+import com.sun.jna.Pointer;
+import com.sun.jna.Structure;
+import lombok.NoArgsConstructor;
+
+@NoArgsConstructor
+@Structure.FieldOrder({"column_count", "row_count", "row_capacity", "columns"})
+public final class ColumnBatch extends Structure {
+    public static final int INT32 = 0;
+    public static final int INT64 = 1;
+    public static final int DOUBLE = 2;
+    public static final int STRING = 3; // UTF-16
+    public static final int BINARY = 4;
+
+    public int column_count;    // int32_t в C
+    public int row_count;       // int32_t в C
+    public int row_capacity;    // int32_t в C
+    public Pointer columns;     // ColumnBatch::Column* в C
+
+    public ColumnBatch(Pointer peer) {
+        super(peer);
+        read();
+    }
+
+    public Column[] getColumns() {
+        if (columns == null || column_count <= 0) {
+            return new Column[0];
+        }
+        return (Column[]) new Column(columns).toArray(column_count);
+    }
+
+    @NoArgsConstructor
+    @Structure.FieldOrder({"type", "nulls", "values", "offsets", "data_length", "data_capacity"})
+    public static final class Column extends Structure {
+        public int type;            // ColumnBatchType в C
+        public Pointer nulls;       // uint8_t* bitmap в C
+        public Pointer values;      // uint8_t* в C
+        public Pointer offsets;     // int32_t* в C
+        public int data_length;     // int32_t в C
+        public int data_capacity;   // int32_t в C
+
+        public Column(Pointer peer) {
+            super(peer);
+            read();
+        }
+
+        public boolean isNull(int row) {
+            return (nulls.getByte(row >> 3) & (1 << (row & 7))) != 0;
+        }
+
+        public int getInt(int row) {
+            return values.getInt((long) row * Integer.BYTES);
+        }
+
+        public long getLong(int row) {
+            return values.getLong((long) row * Long.BYTES);
+        }
+
+        public double getDouble(int row) {
+            return values.getDouble((long) row * Double.BYTES);
+        }
+
+        public byte[] getBytes(int row) {
+            if (isNull(row)) {
+                return null;
+            }
+            int begin = offsets.getInt((long) row * Integer.BYTES);
+            int end = offsets.getInt((long) (row + 1) * Integer.BYTES);
+            return values.getByteArray(begin, end - begin);
+        }
+
+        public String getString(int row) {
+            if (isNull(row)) {
+                return null;
+            }
+            int begin = offsets.getInt((long) row * Integer.BYTES);
+            int end = offsets.getInt((long) (row + 1) * Integer.BYTES);
+            return new String(values.getCharArray(begin, (end - begin) / Character.BYTES));
+        }
+    }
+}
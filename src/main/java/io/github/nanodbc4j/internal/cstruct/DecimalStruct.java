@@ -0,0 +1,26 @@
+package io.github.nanodbc4j.internal.cstruct;
+
+import com.sun.jna.Structure;
+
+import java.math.BigDecimal;
+import java.math.BigInteger;
+
+/**
+ * Decimal value as a 128-bit two's complement unscaled value and a scale.
+ */
+@Structure.FieldOrder({"unscaled_low", "unscaled_high", "scale"})
+public final class DecimalStruct extends Structure {
+    public long unscaled_low;   // uint64_t в C
+    public long unscaled_high;  // int64_t в C
+    public int scale;           // int32_t в C
+
+    public BigDecimal toBigDecimal() {
+        // values that fit in a long, such as DECIMAL(18, x), avoid BigInteger
+        if (unscaled_high == (unscaled_low >> 63)) {
+            return BigDecimal.valueOf(unscaled_low, scale);
+        }
+        BigInteger unscaled = BigInteger.valueOf(unscaled_high).shiftLeft(64)
+                .add(new BigInteger(Long.toUnsignedString(unscaled_low)));
+        return new BigDecimal(unscaled, scale);
+    }
+}
@@ -0,0 +1,17 @@
+package io.github.nanodbc4j.internal.cstruct;
+
+import com.sun.jna.Structure;
+import lombok.NoArgsConstructor;
+
+/**
+ * Settings of a native connection pool, see pool_borrow. Defaults match the native ones.
+ */
+@NoArgsConstructor
+@Structure.FieldOrder({"min_size", "max_size", "borrow_timeout_ms", "idle_timeout_ms", "max_lifetime_ms"})
+public final class PoolSettings extends Structure {
+    public int min_size = 0;                    // int32_t в C
+    public int max_size = 10;                   // int32_t в C
+    public long borrow_timeout_ms = 30000;      // int64_t в C
+    public long idle_timeout_ms = 600000;       // int64_t в C, 0 for never
+    public long max_lifetime_ms = 1800000;      // int64_t в C, 0 for never
+}
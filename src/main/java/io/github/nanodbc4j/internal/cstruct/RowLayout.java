@@ -0,0 +1,33 @@
+package io.github.nanodbc4j.internal.cstruct;
+
+import com.sun.jna.Pointer;
+import com.sun.jna.Structure;
+import lombok.NoArgsConstructor;
+
+/**
+ * Describes packed rows written by read_row: a null bitmap of (column_count + 7) / 8 bytes
+ * followed by the non-null values in column order and native byte order. Fixed-width types
+ * take 4 or 8 bytes, strings (UTF-16) and binary data are prefixed with their byte length.
+ */
+@NoArgsConstructor
+@Structure.FieldOrder({"column_count", "length", "types", "row", "capacity", "pending"})
+public final class RowLayout extends Structure {
+    public int column_count;    // int32_t в C
+    public int length;          // int32_t в C
+    public Pointer types;       // int32_t* (ColumnBatchType) в C
+    public Pointer row;         // uint8_t* в C
+    public int capacity;        // int32_t в C
+    public int pending;         // int32_t в C
+
+    public RowLayout(Pointer peer) {
+        super(peer);
+        read();
+    }
+
+    public int[] getTypes() {
+        if (types == null || column_count <= 0) {
+            return new int[0];
+        }
+        return types.getIntArray(0, column_count);
+    }
+}
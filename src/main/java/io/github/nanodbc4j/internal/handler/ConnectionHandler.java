@@ -11,6 +11,7 @@ import io.github.nanodbc4j.internal.dto.DatabaseMetaDataDto;
 import io.github.nanodbc4j.internal.pointer.ConnectionPtr;
 import io.github.nanodbc4j.internal.pointer.StatementPtr;
 import io.github.nanodbc4j.internal.cstruct.NativeError;
+import io.github.nanodbc4j.internal.cstruct.PoolSettings;
 import io.github.nanodbc4j.jdbc.NanodbcConnection;
 import io.github.nanodbc4j.jdbc.NanodbcDatabaseMetaData;
 import lombok.NonNull;
@@ -21,7 +22,7 @@ import java.sql.DatabaseMetaData;
 import static io.github.nanodbc4j.internal.handler.Handler.*;
 
 /**
- * Native ODBC connection operations: connect, disconnect, create statement.
+ * Native ODBC connection operations: connect, disconnect, borrow from the pool, create statement.
  */
 @UtilityClass
 public final class ConnectionHandler {
@@ -52,6 +53,28 @@ public final class ConnectionHandler {
         }
     }
 
+    public static ConnectionPtr borrow(@NonNull String connection_string, long timeout, PoolSettings settings) {
+        NativeError nativeError = new NativeError();
+        try {
+            ConnectionPtr ptr =
+                    ConnectionApi.INSTANCE.pool_borrow(connection_string + NUL_CHAR, timeout, settings, nativeError);
+            throwIfNativeError(nativeError);
+            return ptr;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static void giveBack(ConnectionPtr ptr) {
+        NativeError nativeError = new NativeError();
+        try {
+            ConnectionApi.INSTANCE.pool_return(ptr, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
     public static StatementPtr create(ConnectionPtr connectionPtr) {
         NativeError nativeError = new NativeError();
         try {
@@ -63,6 +86,17 @@ public final class ConnectionHandler {
         }
     }
 
+    public static StatementPtr prepare(ConnectionPtr connectionPtr, @NonNull String sql) {
+        NativeError nativeError = new NativeError();
+        try {
+            StatementPtr ptr = ConnectionApi.INSTANCE.create_prepared_statement(connectionPtr, sql + NUL_CHAR, nativeError);
+            throwIfNativeError(nativeError);
+            return ptr;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
     public static void prepared(StatementPtr statementPtr, @NonNull String sql) {
         NativeError nativeError = new NativeError();
         try {
@@ -179,6 +213,48 @@ public final class ConnectionHandler {
         }
     }
 
+    public static void setWideCharFetch(ConnectionPtr conn, boolean enabled) {
+        NativeError nativeError = new NativeError();
+        try {
+            ConnectionApi.INSTANCE.set_wide_char_fetch(conn, (byte) (enabled ? 1 : 0), nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static void setStatementCacheSize(ConnectionPtr conn, int size) {
+        NativeError nativeError = new NativeError();
+        try {
+            ConnectionApi.INSTANCE.set_statement_cache_size(conn, size, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static int getStatementCacheSize(ConnectionPtr conn) {
+        NativeError nativeError = new NativeError();
+        try {
+            int size = ConnectionApi.INSTANCE.get_statement_cache_size(conn, nativeError);
+            throwIfNativeError(nativeError);
+            return size;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static boolean getWideCharFetch(ConnectionPtr conn) {
+        NativeError nativeError = new NativeError();
+        try {
+            boolean result = ConnectionApi.INSTANCE.get_wide_char_fetch(conn, nativeError) != 0;
+            throwIfNativeError(nativeError);
+            return result;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
     public static DatabaseMetaData getDatabaseSetMetaData(NanodbcConnection connection, ConnectionPtr connectionPtr) {
         NativeError nativeError = new NativeError();
         DatabaseMetaDataStruct metaDataStruct = null;
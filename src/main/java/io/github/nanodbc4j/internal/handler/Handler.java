@@ -32,6 +32,11 @@ public class Handler {
         R apply(T t, U u, V v);
     }
 
+    @FunctionalInterface
+    public interface QuadFunction<T, U, V, W, R> {
+        R apply(T t, U u, V v, W w);
+    }
+
     @FunctionalInterface
     public interface QuadConsumer<T, U, V, W> {
         void accept(T t, U u, V v, W w);
@@ -0,0 +1,121 @@
+package io.github.nanodbc4j.internal.handler;
+
+import com.sun.jna.Pointer;
+import io.github.nanodbc4j.internal.binding.StatementApi;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.Reader;
+
+/**
+ * Readers handing the chunks of stream parameters to the native side while a statement executes.
+ * Only one chunk is copied at a time, so the length of a stream does not matter.
+ * A stream that throws fails the execution, its exception is kept as the failure.
+ * A reader must stay reachable until the statement has been executed.
+ */
+public final class ParameterStreams {
+
+    private ParameterStreams() {
+    }
+
+    /**
+     * Common state of a reader: the remaining length and the failure that stopped it.
+     */
+    public abstract static class Source {
+        private long remaining;
+        private Exception failure;
+
+        Source(long length) {
+            this.remaining = length < 0 ? Long.MAX_VALUE : length;
+        }
+
+        /**
+         * @return the error that made the stream fail, null if none
+         */
+        public Exception failure() {
+            return failure;
+        }
+
+        int limit(int length) {
+            return (int) Math.min(length, remaining);
+        }
+
+        int consumed(int read) {
+            if (read <= 0) {
+                remaining = 0;
+                return 0;
+            }
+            remaining -= read;
+            return read;
+        }
+
+        int fail(Exception e) {
+            failure = e;
+            return -1;
+        }
+    }
+
+    public static final class Bytes extends Source implements StatementApi.BinaryStreamReader {
+        private final InputStream stream;
+        private byte[] chunk = new byte[0];
+
+        /**
+         * @param length bytes to read, -1 for all
+         */
+        public Bytes(InputStream stream, long length) {
+            super(length);
+            this.stream = stream;
+        }
+
+        @Override
+        public int invoke(Pointer context, Pointer buffer, int length) {
+            try {
+                int limit = limit(length);
+                if (limit == 0) {
+                    return 0;
+                }
+                if (chunk.length < limit) {
+                    chunk = new byte[limit];
+                }
+                int read = consumed(stream.read(chunk, 0, limit));
+                buffer.write(0, chunk, 0, read);
+                return read;
+            } catch (IOException | RuntimeException e) {
+                // an exception must not unwind into the native caller, -1 fails the execution instead
+                return fail(e);
+            }
+        }
+    }
+
+    public static final class Chars extends Source implements StatementApi.CharacterStreamReader {
+        private final Reader reader;
+        private char[] chunk = new char[0];
+
+        /**
+         * @param length characters to read, -1 for all
+         */
+        public Chars(Reader reader, long length) {
+            super(length);
+            this.reader = reader;
+        }
+
+        @Override
+        public int invoke(Pointer context, Pointer buffer, int length) {
+            try {
+                int limit = limit(length);
+                if (limit == 0) {
+                    return 0;
+                }
+                if (chunk.length < limit) {
+                    chunk = new char[limit];
+                }
+                int read = consumed(reader.read(chunk, 0, limit));
+                buffer.write(0, chunk, 0, read);
+                return read;
+            } catch (IOException | RuntimeException e) {
+                // an exception must not unwind into the native caller, -1 fails the execution instead
+                return fail(e);
+            }
+        }
+    }
+}
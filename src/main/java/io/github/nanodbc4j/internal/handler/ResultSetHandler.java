@@ -1,6 +1,7 @@
 package io.github.nanodbc4j.internal.handler;
 
 import com.sun.jna.Pointer;
+import com.sun.jna.ptr.ByteByReference;
 import io.github.nanodbc4j.internal.binding.OdbcApi;
 import io.github.nanodbc4j.internal.binding.ResultApi;
 import io.github.nanodbc4j.internal.binding.ResultSetMetaDataApi;
@@ -11,6 +12,7 @@ import io.github.nanodbc4j.internal.dto.ResultSetMetadataDto;
 import io.github.nanodbc4j.jdbc.NanodbcResultSetMetaData;
 import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
 import io.github.nanodbc4j.internal.cstruct.DateStruct;
+import io.github.nanodbc4j.internal.cstruct.DecimalStruct;
 import io.github.nanodbc4j.internal.cstruct.NativeError;
 import io.github.nanodbc4j.internal.cstruct.TimeStruct;
 import io.github.nanodbc4j.internal.cstruct.TimestampStruct;
@@ -18,6 +20,7 @@ import lombok.NonNull;
 import lombok.experimental.UtilityClass;
 
 import java.io.InvalidClassException;
+import java.math.BigDecimal;
 import java.sql.Date;
 import java.sql.ResultSetMetaData;
 import java.sql.Time;
@@ -84,6 +87,17 @@ public final class ResultSetHandler {
         }
     }
 
+    public static boolean relative(ResultSetPtr resultSet, int rows) {
+        NativeError nativeError = new NativeError();
+        try {
+            boolean result = ResultApi.INSTANCE.relative_result(resultSet, rows, nativeError) != 0;
+            throwIfNativeError(nativeError);
+            return result;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
     public static int getRow(ResultSetPtr resultSet) {
         NativeError nativeError = new NativeError();
         try {
@@ -106,6 +120,36 @@ public final class ResultSetHandler {
         }
     }
 
+    public static void enablePrefetch(ResultSetPtr resultSet, int batchRows) {
+        NativeError nativeError = new NativeError();
+        try {
+            ResultApi.INSTANCE.enable_prefetch(resultSet, batchRows, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static void enableRowCache(ResultSetPtr resultSet, long memoryBudget) {
+        NativeError nativeError = new NativeError();
+        try {
+            ResultApi.INSTANCE.enable_row_cache(resultSet, memoryBudget, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static void enableValueArena(ResultSetPtr resultSet) {
+        NativeError nativeError = new NativeError();
+        try {
+            ResultApi.INSTANCE.enable_value_arena(resultSet, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
     public static <T> T getValueByIndex(ResultSetPtr resultSet, int index, Handler.TriFunction<ResultSetPtr, Integer, NativeError, T> function) {
         NativeError nativeError = new NativeError();
         try {
@@ -117,6 +161,18 @@ public final class ResultSetHandler {
         }
     }
 
+    public static <T> T getValueByIndex(ResultSetPtr resultSet, int index, ByteByReference isNull,
+                                        Handler.QuadFunction<ResultSetPtr, Integer, ByteByReference, NativeError, T> function) {
+        NativeError nativeError = new NativeError();
+        try {
+            T value = function.apply(resultSet, index - 1, isNull, nativeError);
+            throwIfNativeError(nativeError);
+            return value;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
     public static <T> T getValueByName(ResultSetPtr resultSet, @NonNull String name, Handler.TriFunction<ResultSetPtr, String, NativeError, T> function) {
         NativeError nativeError = new NativeError();
         try {
@@ -142,7 +198,35 @@ public final class ResultSetHandler {
         }
     }
 
-    public static Date getDateValueByIndex(ResultSetPtr resultSet, int index) {
+    public static String getStringValueByIndex(ResultSetPtr resultSet, int index, Utf16Buffer buffer) {
+        NativeError nativeError = new NativeError();
+        try {
+            int length = ResultApi.INSTANCE.get_string_into_by_index(resultSet, index - 1, buffer.pointer(), buffer.capacity(), nativeError);
+            throwIfNativeError(nativeError);
+            if (length > buffer.capacity()) {
+                // the native side keeps the value until the cursor moves, so the read can be repeated
+                buffer.ensureCapacity(length);
+                length = ResultApi.INSTANCE.get_string_into_by_index(resultSet, index - 1, buffer.pointer(), buffer.capacity(), nativeError);
+                throwIfNativeError(nativeError);
+            }
+            return length == -1 ? null : buffer.read(length);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static BigDecimal getDecimalValueByIndex(ResultSetPtr resultSet, int index, DecimalStruct decimal) {
+        NativeError nativeError = new NativeError();
+        try {
+            boolean filled = ResultApi.INSTANCE.get_decimal_by_index(resultSet, index - 1, decimal, nativeError) != 0;
+            throwIfNativeError(nativeError);
+            return filled ? decimal.toBigDecimal() : null;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static Date getDateValueByIndex(ResultSetPtr resultSet, int index, boolean arena) {
         NativeError nativeError = new NativeError();
         DateStruct dateStruct = null;
         try {
@@ -150,11 +234,13 @@ public final class ResultSetHandler {
             return convert(dateStruct, nativeError);
         } finally {
             OdbcApi.INSTANCE.clear_native_error(nativeError);
-            ResultApi.INSTANCE.delete_date(dateStruct);
+            if (!arena) {
+                ResultApi.INSTANCE.delete_date(dateStruct);
+            }
         }
     }
 
-    public static Time getTimeValueByIndex(ResultSetPtr resultSet, int index) {
+    public static Time getTimeValueByIndex(ResultSetPtr resultSet, int index, boolean arena) {
         NativeError nativeError = new NativeError();
         TimeStruct timeStruct = null;
         try {
@@ -162,11 +248,13 @@ public final class ResultSetHandler {
             return convert(timeStruct, nativeError);
         } finally {
             OdbcApi.INSTANCE.clear_native_error(nativeError);
-            ResultApi.INSTANCE.delete_time(timeStruct);
+            if (!arena) {
+                ResultApi.INSTANCE.delete_time(timeStruct);
+            }
         }
     }
 
-    public static Timestamp getTimestampValueByIndex(ResultSetPtr resultSet, int index) {
+    public static Timestamp getTimestampValueByIndex(ResultSetPtr resultSet, int index, boolean arena) {
         NativeError nativeError = new NativeError();
         TimestampStruct timestampStruct = null;
         try {
@@ -174,11 +262,13 @@ public final class ResultSetHandler {
             return convert(timestampStruct, nativeError);
         } finally {
             OdbcApi.INSTANCE.clear_native_error(nativeError);
-            ResultApi.INSTANCE.delete_timestamp(timestampStruct);
+            if (!arena) {
+                ResultApi.INSTANCE.delete_timestamp(timestampStruct);
+            }
         }
     }
 
-    public static byte[] getBytesByIndex(ResultSetPtr resultSet, int index) {
+    public static byte[] getBytesByIndex(ResultSetPtr resultSet, int index, boolean arena) {
         NativeError nativeError = new NativeError();
         BinaryArray array = null;
         try {
@@ -190,11 +280,13 @@ public final class ResultSetHandler {
             return array.getBytes();
         } finally {
             OdbcApi.INSTANCE.clear_native_error(nativeError);
-            ResultApi.INSTANCE.delete_binary_array(array);
+            if (!arena) {
+                ResultApi.INSTANCE.delete_binary_array(array);
+            }
         }
     }
 
-    public static byte[] getBytesByName(ResultSetPtr resultSet, @NonNull String name) {
+    public static byte[] getBytesByName(ResultSetPtr resultSet, @NonNull String name, boolean arena) {
         NativeError nativeError = new NativeError();
         BinaryArray array = null;
         try {
@@ -206,13 +298,13 @@ public final class ResultSetHandler {
             return array.getBytes();
         } finally {
             OdbcApi.INSTANCE.clear_native_error(nativeError);
-            if (array != null) {
+            if (array != null && !arena) {
                 ResultApi.INSTANCE.delete_binary_array(array);
             }
         }
     }
 
-    public static String getStringValueByName(ResultSetPtr resultSet, @NonNull String name) {
+    public static String getStringValueByName(ResultSetPtr resultSet, @NonNull String name, boolean arena) {
         NativeError nativeError = new NativeError();
         Pointer strPtr = null;
         try {
@@ -221,14 +313,14 @@ public final class ResultSetHandler {
             return getUtf16String(strPtr);
         } finally {
             OdbcApi.INSTANCE.clear_native_error(nativeError);
-            if (strPtr != null) {
+            if (strPtr != null && !arena) {
                 Native.std_free(Pointer.nativeValue(strPtr));
             }
         }
     }
 
 
-    public static Date getDateValueByName(ResultSetPtr resultSet, @NonNull String name) {
+    public static Date getDateValueByName(ResultSetPtr resultSet, @NonNull String name, boolean arena) {
         NativeError nativeError = new NativeError();
         DateStruct dateStruct = null;
         try {
@@ -236,13 +328,13 @@ public final class ResultSetHandler {
             return convert(dateStruct, nativeError);
         } finally {
             OdbcApi.INSTANCE.clear_native_error(nativeError);
-            if (dateStruct != null) {
+            if (dateStruct != null && !arena) {
                 ResultApi.INSTANCE.delete_date(dateStruct);
             }
         }
     }
 
-    public static Time getTimeValueByName(ResultSetPtr resultSet, @NonNull String name) {
+    public static Time getTimeValueByName(ResultSetPtr resultSet, @NonNull String name, boolean arena) {
         NativeError nativeError = new NativeError();
         TimeStruct timeStruct = null;
         try {
@@ -250,13 +342,13 @@ public final class ResultSetHandler {
             return convert(timeStruct, nativeError);
         } finally {
             OdbcApi.INSTANCE.clear_native_error(nativeError);
-            if (timeStruct != null) {
+            if (timeStruct != null && !arena) {
                 ResultApi.INSTANCE.delete_time(timeStruct);
             }
         }
     }
 
-    public static Timestamp getTimestampValueByName(ResultSetPtr resultSet, @NonNull String name) {
+    public static Timestamp getTimestampValueByName(ResultSetPtr resultSet, @NonNull String name, boolean arena) {
         NativeError nativeError = new NativeError();
         TimestampStruct timestampStruct = null;
         try {
@@ -264,7 +356,7 @@ public final class ResultSetHandler {
             return convert(timestampStruct, nativeError);
         } finally {
             OdbcApi.INSTANCE.clear_native_error(nativeError);
-            if (timestampStruct != null) {
+            if (timestampStruct != null && !arena) {
                 ResultApi.INSTANCE.delete_timestamp(timestampStruct);
             }
         }
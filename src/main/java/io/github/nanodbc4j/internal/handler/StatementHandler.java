@@ -1,5 +1,6 @@
 package io.github.nanodbc4j.internal.handler;
 
+import com.sun.jna.Pointer;
 import io.github.nanodbc4j.internal.binding.ConnectionApi;
 import io.github.nanodbc4j.internal.binding.OdbcApi;
 import io.github.nanodbc4j.internal.binding.StatementApi;
@@ -7,6 +8,7 @@ import io.github.nanodbc4j.internal.cstruct.DateStruct;
 import io.github.nanodbc4j.internal.cstruct.TimeStruct;
 import io.github.nanodbc4j.internal.cstruct.TimestampStruct;
 import io.github.nanodbc4j.internal.pointer.ConnectionPtr;
+import io.github.nanodbc4j.internal.pointer.ExecutionPtr;
 import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
 import io.github.nanodbc4j.internal.pointer.StatementPtr;
 import io.github.nanodbc4j.internal.cstruct.NativeError;
@@ -25,10 +27,10 @@ import static io.github.nanodbc4j.internal.handler.Handler.*;
 @UtilityClass
 public final class StatementHandler {
 
-    public static ResultSetPtr execute(ConnectionPtr conn, @NonNull String sql, int timeout) {
+    public static ResultSetPtr execute(ConnectionPtr conn, @NonNull String sql, int timeout, int fetchSize) {
         NativeError nativeError = new NativeError();
         try {
-            ResultSetPtr resultSetPtr = ConnectionApi.INSTANCE.execute_request(conn, sql + NUL_CHAR, timeout, nativeError);
+            ResultSetPtr resultSetPtr = ConnectionApi.INSTANCE.execute_request_with_fetch_size(conn, sql + NUL_CHAR, timeout, fetchSize, nativeError);
             throwIfNativeError(nativeError);
             return resultSetPtr;
         } finally {
@@ -36,10 +38,10 @@ public final class StatementHandler {
         }
     }
 
-    public static ResultSetPtr execute(StatementPtr statementPtr, int timeout) {
+    public static ResultSetPtr execute(StatementPtr statementPtr, int timeout, int fetchSize) {
         NativeError nativeError = new NativeError();
         try {
-            ResultSetPtr resultSetPtr = StatementApi.INSTANCE.execute(statementPtr, timeout, nativeError);
+            ResultSetPtr resultSetPtr = StatementApi.INSTANCE.execute_with_fetch_size(statementPtr, timeout, fetchSize, nativeError);
             throwIfNativeError(nativeError);
             return resultSetPtr;
         } finally {
@@ -47,6 +49,87 @@ public final class StatementHandler {
         }
     }
 
+    public static ExecutionPtr executeAsync(ConnectionPtr conn, @NonNull String sql, int timeout) {
+        NativeError nativeError = new NativeError();
+        try {
+            ExecutionPtr executionPtr = ConnectionApi.INSTANCE.execute_request_async(conn, sql + NUL_CHAR, timeout, nativeError);
+            throwIfNativeError(nativeError);
+            return executionPtr;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static ExecutionPtr executeAsync(StatementPtr statementPtr, int timeout) {
+        NativeError nativeError = new NativeError();
+        try {
+            ExecutionPtr executionPtr = StatementApi.INSTANCE.execute_async(statementPtr, timeout, nativeError);
+            throwIfNativeError(nativeError);
+            return executionPtr;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    /**
+     * @return true once the execution finished
+     */
+    public static boolean poll(ExecutionPtr executionPtr) {
+        NativeError nativeError = new NativeError();
+        try {
+            int finished = StatementApi.INSTANCE.poll_execution(executionPtr, nativeError);
+            throwIfNativeError(nativeError);
+            return finished == 1;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    /**
+     * @return true once the execution finished
+     */
+    public static boolean waitFor(ExecutionPtr executionPtr, int timeoutMillis) {
+        NativeError nativeError = new NativeError();
+        try {
+            int finished = StatementApi.INSTANCE.wait_for_execution(executionPtr, timeoutMillis, nativeError);
+            throwIfNativeError(nativeError);
+            return finished == 1;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static void cancel(ExecutionPtr executionPtr) {
+        NativeError nativeError = new NativeError();
+        try {
+            StatementApi.INSTANCE.cancel_execution(executionPtr, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static ResultSetPtr getResult(ExecutionPtr executionPtr, int fetchSize) {
+        NativeError nativeError = new NativeError();
+        try {
+            ResultSetPtr resultSetPtr = StatementApi.INSTANCE.execution_result(executionPtr, fetchSize, nativeError);
+            throwIfNativeError(nativeError);
+            return resultSetPtr;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static void close(ExecutionPtr executionPtr) {
+        NativeError nativeError = new NativeError();
+        try {
+            StatementApi.INSTANCE.close_execution(executionPtr, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
     public static <T> void setValueByIndex(StatementPtr statementPtr, int index, T value, Handler.QuadConsumer<StatementPtr, Integer, T, NativeError> function) {
         NativeError nativeError = new NativeError();
         try {
@@ -57,6 +140,86 @@ public final class StatementHandler {
         }
     }
 
+    public static void setColumn(StatementPtr statementPtr, int index, Pointer values, byte[] nulls, int rows, ColumnSetter function) {
+        NativeError nativeError = new NativeError();
+        try {
+            function.accept(statementPtr, index - 1, values, nulls, rows, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static void setStringColumn(StatementPtr statementPtr, int index, char[] data, int[] offsets, byte[] nulls, int rows) {
+        NativeError nativeError = new NativeError();
+        try {
+            StatementApi.INSTANCE.set_string_column(statementPtr, index - 1, data, data.length, offsets, nulls, rows, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    /**
+     * Sets a binary stream parameter, read while the statement executes; null reader sets NULL.
+     */
+    public static void setBinaryStream(StatementPtr statementPtr, int index, StatementApi.BinaryStreamReader reader, long length) {
+        NativeError nativeError = new NativeError();
+        try {
+            StatementApi.INSTANCE.set_binary_stream_value(statementPtr, index - 1, reader, null, length, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    /**
+     * Sets a character stream parameter, read while the statement executes; null reader sets NULL.
+     */
+    public static void setCharacterStream(StatementPtr statementPtr, int index, StatementApi.CharacterStreamReader reader, long length) {
+        NativeError nativeError = new NativeError();
+        try {
+            StatementApi.INSTANCE.set_character_stream_value(statementPtr, index - 1, reader, null, length, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static void addBatch(StatementPtr statementPtr) {
+        NativeError nativeError = new NativeError();
+        try {
+            StatementApi.INSTANCE.add_batch(statementPtr, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    /**
+     * Executes the batch, filling rowCounts before an error is thrown so failed rows can be reported.
+     */
+    public static int executeBatch(StatementPtr statementPtr, int timeout, int[] rowCounts) {
+        NativeError nativeError = new NativeError();
+        try {
+            int rows = StatementApi.INSTANCE.execute_batch(statementPtr, timeout, rowCounts, rowCounts.length, nativeError);
+            throwIfNativeError(nativeError);
+            return rows;
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
+    public static void clearBatch(StatementPtr statementPtr) {
+        NativeError nativeError = new NativeError();
+        try {
+            StatementApi.INSTANCE.clear_batch(statementPtr, nativeError);
+            throwIfNativeError(nativeError);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(nativeError);
+        }
+    }
+
     public static void cancel(StatementPtr statement) {
         NativeError nativeError = new NativeError();
         try {
@@ -110,4 +273,9 @@ public final class StatementHandler {
         struct.fract = localDateTime.getNano();
         return struct;
     }
+
+    @FunctionalInterface
+    public interface ColumnSetter {
+        void accept(StatementPtr statementPtr, int index, Pointer values, byte[] nulls, int rows, NativeError nativeError);
+    }
 }
@@ -0,0 +1,39 @@
+package io.github.nanodbc4j.internal.handler;
+
+import com.sun.jna.Memory;
+import com.sun.jna.Pointer;
+
+/**
+ * Reusable native buffer receiving UTF-16 strings, so reading a string cell
+ * does not allocate and free native memory.
+ */
+public final class Utf16Buffer {
+    private static final int INITIAL_CAPACITY = 256;
+
+    private Memory memory = new Memory((long) INITIAL_CAPACITY * Character.BYTES);
+    private int capacity = INITIAL_CAPACITY;
+
+    Pointer pointer() {
+        return memory;
+    }
+
+    /**
+     * @return buffer size in characters
+     */
+    int capacity() {
+        return capacity;
+    }
+
+    void ensureCapacity(int length) {
+        if (length <= capacity) {
+            return;
+        }
+        int newCapacity = Math.max(capacity * 2, length);
+        memory = new Memory((long) newCapacity * Character.BYTES);
+        capacity = newCapacity;
+    }
+
+    String read(int length) {
+        return new String(memory.getCharArray(0, length));
+    }
+}
@@ -0,0 +1,15 @@
+package io.github.nanodbc4j.internal.pointer;
+
+import com.sun.jna.Pointer;
+import com.sun.jna.PointerType;
+import lombok.NoArgsConstructor;
+
+/**
+ * ChunkedCharacterStream pointer
+ */
+@NoArgsConstructor
+public class CharacterStreamPtr extends PointerType {
+    public CharacterStreamPtr(Pointer p) {
+        super(p);
+    }
+}
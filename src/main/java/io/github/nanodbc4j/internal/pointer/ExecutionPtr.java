@@ -0,0 +1,15 @@
+package io.github.nanodbc4j.internal.pointer;
+
+import com.sun.jna.Pointer;
+import com.sun.jna.PointerType;
+import lombok.NoArgsConstructor;
+
+/**
+ * AsyncExecution pointer
+ */
+@NoArgsConstructor
+public final class ExecutionPtr extends PointerType {
+    public ExecutionPtr(Pointer p) {
+        super(p);
+    }
+}
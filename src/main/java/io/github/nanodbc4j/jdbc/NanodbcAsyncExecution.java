@@ -0,0 +1,148 @@
+package io.github.nanodbc4j.jdbc;
+
+import io.github.nanodbc4j.exceptions.NanodbcSQLException;
+import io.github.nanodbc4j.exceptions.NativeException;
+import io.github.nanodbc4j.internal.handler.StatementHandler;
+import io.github.nanodbc4j.internal.pointer.ExecutionPtr;
+import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
+import lombok.AllArgsConstructor;
+import lombok.extern.java.Log;
+
+import java.lang.ref.Cleaner;
+import java.sql.ResultSet;
+import java.sql.SQLException;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Statement execution running without blocking the thread that started it.
+ * Poll it or wait for it, then take its result set. The statement must not be
+ * used until the execution is closed.
+ */
+@Log
+public class NanodbcAsyncExecution implements AutoCloseable {
+    private final NanodbcStatement statement;
+    private ExecutionPtr executionPtr;
+
+    // Cleaner for managing resource cleanup
+    private static final Cleaner cleaner = Cleaner.create();
+    private final Cleaner.Cleanable cleanable;
+
+    NanodbcAsyncExecution(NanodbcStatement statement, ExecutionPtr executionPtr, List<Object> callbacks) {
+        cleanable = cleaner.register(this, new ExecutionCleaner(executionPtr, callbacks));
+        this.statement = statement;
+        this.executionPtr = executionPtr;
+    }
+
+    /**
+     * Advances the execution without blocking.
+     *
+     * @return true once the execution finished
+     * @throws SQLException if the execution is closed
+     */
+    public boolean poll() throws SQLException {
+        log.finest("NanodbcAsyncExecution.poll");
+        throwIfAlreadyClosed();
+        try {
+            return StatementHandler.poll(executionPtr);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Waits for the execution to finish.
+     *
+     * @param timeout time to wait at most
+     * @param unit unit of the timeout
+     * @return true once the execution finished
+     * @throws SQLException if the execution is closed
+     */
+    public boolean await(long timeout, TimeUnit unit) throws SQLException {
+        log.finest("NanodbcAsyncExecution.await");
+        throwIfAlreadyClosed();
+        try {
+            int millis = (int) Math.min(unit.toMillis(timeout), Integer.MAX_VALUE);
+            return StatementHandler.waitFor(executionPtr, millis);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Asks the driver to stop the execution. May be called from any thread.
+     *
+     * @throws SQLException if the execution is closed
+     */
+    public void cancel() throws SQLException {
+        log.finest("NanodbcAsyncExecution.cancel");
+        throwIfAlreadyClosed();
+        try {
+            StatementHandler.cancel(executionPtr);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Returns the results of the finished execution. Call once.
+     *
+     * @return result set, or the update count through {@link NanodbcStatement#getUpdateCount()}
+     * @throws SQLException if the execution is running, was cancelled or failed
+     */
+    public ResultSet getResultSet() throws SQLException {
+        log.finest("NanodbcAsyncExecution.getResultSet");
+        throwIfAlreadyClosed();
+        try {
+            statement.closeResultSet();
+            ResultSetPtr resultSetPtr = StatementHandler.getResult(executionPtr, statement.fetchSize);
+            NanodbcResultSet resultSet = new NanodbcResultSet(statement, resultSetPtr);
+            statement.resultSet = resultSet;
+            return resultSet;
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Releases the execution, cancelling it first if it is still running.
+     */
+    @Override
+    public void close() throws SQLException {
+        log.finest("NanodbcAsyncExecution.close");
+        synchronized (this) {
+            if (executionPtr != null) {
+                cleanable.clean();
+                executionPtr = null;
+            }
+        }
+    }
+
+    private void throwIfAlreadyClosed() throws SQLException {
+        if (executionPtr == null) {
+            throw new NanodbcSQLException("Execution: already closed");
+        }
+    }
+
+    @Log
+    @AllArgsConstructor
+    private static class ExecutionCleaner implements Runnable {
+        private ExecutionPtr ptr;
+        // stream readers called back while the statement executes, kept reachable until it is closed
+        private List<Object> callbacks;
+
+        @Override
+        public void run() {
+            if (ptr != null) {
+                try {
+                    StatementHandler.close(ptr);
+                } catch (Exception e) {
+                    log.warning("Exception while closing execution: " + e.getMessage());
+                } finally {
+                    ptr = null;
+                    callbacks = null;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,124 @@
+package io.github.nanodbc4j.jdbc;
+
+import com.sun.jna.Memory;
+import io.github.nanodbc4j.internal.binding.OdbcApi;
+import io.github.nanodbc4j.internal.binding.ResultApi;
+import io.github.nanodbc4j.internal.cstruct.NativeError;
+import io.github.nanodbc4j.internal.pointer.CharacterStreamPtr;
+import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
+import lombok.AllArgsConstructor;
+import lombok.NonNull;
+import lombok.extern.java.Log;
+
+import java.io.IOException;
+import java.io.Reader;
+import java.lang.ref.Cleaner;
+
+import static io.github.nanodbc4j.internal.handler.Handler.NUL_CHAR;
+import static io.github.nanodbc4j.internal.handler.Handler.throwIfNativeError;
+
+/**
+ * Reads a character column as UTF-16 decoded by the native side chunk by chunk,
+ * so multibyte sequences split between chunks are never seen here.
+ */
+public class NanodbcCharacterStream extends Reader {
+    private static final int INITIAL_CAPACITY = 4096;
+
+    private final CharacterStreamPtr streamPtr;
+    private Memory buffer;
+    private int capacity;
+    private volatile boolean closed = false;
+
+    // Cleaner for managing resource cleanup
+    private static final Cleaner cleaner = Cleaner.create();
+    private final Cleaner.Cleanable cleanable;
+
+    public NanodbcCharacterStream(ResultSetPtr resultSetPtr, int columnIndex) {
+        NativeError error = new NativeError();
+        try {
+            streamPtr = ResultApi.INSTANCE.get_character_stream_by_index(resultSetPtr, columnIndex - 1, error);
+            cleanable = cleaner.register(this, new CharacterStreamCleaner(streamPtr));
+            throwIfNativeError(error);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(error);
+        }
+    }
+
+    public NanodbcCharacterStream(ResultSetPtr resultSetPtr, String columnName) {
+        NativeError error = new NativeError();
+        try {
+            streamPtr = ResultApi.INSTANCE.get_character_stream_by_name(resultSetPtr, columnName + NUL_CHAR, error);
+            cleanable = cleaner.register(this, new CharacterStreamCleaner(streamPtr));
+            throwIfNativeError(error);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(error);
+        }
+    }
+
+    /**
+     * @return true if the column value is NULL, in which case the stream is empty
+     */
+    boolean isNull() {
+        return streamPtr == null;
+    }
+
+    @Override
+    public int read(char @NonNull [] cbuf, int off, int len) throws IOException {
+        if (closed) throw new IOException("Stream closed");
+        if (len == 0) return 0;
+        if (streamPtr == null) return -1;
+
+        ensureCapacity(len);
+        NativeError error = new NativeError();
+        try {
+            int charsRead = ResultApi.INSTANCE.read_character_stream(streamPtr, buffer, 0, len, error);
+            throwIfNativeError(error);
+            if (charsRead > 0) {
+                buffer.read(0, cbuf, off, charsRead);
+            }
+            return charsRead;
+        } catch (Exception e) {
+            throw new IOException("Failed to read from character stream", e);
+        } finally {
+            OdbcApi.INSTANCE.clear_native_error(error);
+        }
+    }
+
+    @Override
+    public void close() throws IOException {
+        synchronized (this) {
+            if (!closed) {
+                cleanable.clean();
+                buffer = null;
+                closed = true;
+            }
+        }
+    }
+
+    private void ensureCapacity(int length) {
+        if (buffer != null && length <= capacity) {
+            return;
+        }
+        capacity = Math.max(Math.max(capacity * 2, length), INITIAL_CAPACITY);
+        buffer = new Memory((long) capacity * Character.BYTES);
+    }
+
+    @Log
+    @AllArgsConstructor
+    private static class CharacterStreamCleaner implements Runnable {
+        private CharacterStreamPtr ptr;
+
+        @Override
+        public void run() {
+            if (ptr != null) {
+                try {
+                    ResultApi.INSTANCE.close_character_stream(ptr);
+                } catch (Exception e) {
+                    log.warning("Exception while closing character stream: " + e.getMessage());
+                } finally {
+                    ptr = null;
+                }
+            }
+        }
+    }
+}
@@ -3,6 +3,7 @@ package io.github.nanodbc4j.jdbc;
 import io.github.nanodbc4j.exceptions.NanodbcSQLException;
 import io.github.nanodbc4j.exceptions.NanodbcSQLFeatureNotSupportedException;
 import io.github.nanodbc4j.exceptions.NativeException;
+import io.github.nanodbc4j.internal.cstruct.PoolSettings;
 import io.github.nanodbc4j.internal.handler.ConnectionHandler;
 import io.github.nanodbc4j.internal.pointer.ConnectionPtr;
 import io.github.nanodbc4j.internal.pointer.StatementPtr;
@@ -56,7 +57,20 @@ public class NanodbcConnection implements Connection, JdbcWrapper {
         try {
             connectionPtr = ConnectionHandler.connect(url, loginTimeoutSeconds);
             this.url = url;
-            cleanable = cleaner.register(this, new ConnectionCleaner(connectionPtr));
+            cleanable = cleaner.register(this, new ConnectionCleaner(connectionPtr, false));
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Borrows the connection from the native pool for the connection string; closing gives it back.
+     */
+    NanodbcConnection(String url, int loginTimeoutSeconds, PoolSettings poolSettings) throws SQLException {
+        try {
+            connectionPtr = ConnectionHandler.borrow(url, loginTimeoutSeconds, poolSettings);
+            this.url = url;
+            cleanable = cleaner.register(this, new ConnectionCleaner(connectionPtr, true));
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -66,7 +80,7 @@ public class NanodbcConnection implements Connection, JdbcWrapper {
         try {
             connectionPtr = ConnectionHandler.connect(dsn, user, password, timeout);
             this.url = dsn;
-            cleanable = cleaner.register(this, new ConnectionCleaner(connectionPtr));
+            cleanable = cleaner.register(this, new ConnectionCleaner(connectionPtr, false));
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -93,8 +107,7 @@ public class NanodbcConnection implements Connection, JdbcWrapper {
     public PreparedStatement prepareStatement(String sql) throws SQLException {
         log.log(Level.FINEST, "NanodbcConnection.NanodbcConnection.prepareStatement");
         try {
-            StatementPtr statementPtr = ConnectionHandler.create(connectionPtr);
-            ConnectionHandler.prepared(statementPtr, sql);
+            StatementPtr statementPtr = ConnectionHandler.prepare(connectionPtr, sql);
             return new NanodbcPreparedStatement(this, statementPtr);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -335,7 +348,9 @@ public class NanodbcConnection implements Connection, JdbcWrapper {
 
         try {
             StatementPtr statementPtr = ConnectionHandler.create(connectionPtr);
-            return new NanodbcStatement(this, statementPtr);
+            NanodbcStatement statement = new NanodbcStatement(this, statementPtr);
+            statement.resultSetType = resultSetType;
+            return statement;
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -356,9 +371,10 @@ public class NanodbcConnection implements Connection, JdbcWrapper {
         }
 
         try {
-            StatementPtr statementPtr = ConnectionHandler.create(connectionPtr);
-            ConnectionHandler.prepared(statementPtr, sql);
-            return new NanodbcPreparedStatement(this, statementPtr);
+            StatementPtr statementPtr = ConnectionHandler.prepare(connectionPtr, sql);
+            NanodbcPreparedStatement statement = new NanodbcPreparedStatement(this, statementPtr);
+            statement.resultSetType = resultSetType;
+            return statement;
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -647,6 +663,60 @@ public class NanodbcConnection implements Connection, JdbcWrapper {
         return 0;
     }
 
+    /**
+     * Selects whether character columns are read as UTF-16 (SQL_C_WCHAR) instead of
+     * the driver's narrow encoding. Applies to statements created afterwards.
+     */
+    public void setWideCharFetch(boolean enabled) throws SQLException {
+        log.log(Level.FINEST, "NanodbcConnection.setWideCharFetch");
+        throwIfAlreadyClosed();
+        try {
+            ConnectionHandler.setWideCharFetch(connectionPtr, enabled);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Returns whether character columns are read as UTF-16 (SQL_C_WCHAR).
+     */
+    public boolean getWideCharFetch() throws SQLException {
+        log.log(Level.FINEST, "NanodbcConnection.getWideCharFetch");
+        throwIfAlreadyClosed();
+        try {
+            return ConnectionHandler.getWideCharFetch(connectionPtr);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Keeps up to the given number of idle prepared statements for reuse, so preparing
+     * the same SQL again skips the round trip to the driver. 0 disables the cache.
+     */
+    public void setStatementCacheSize(int size) throws SQLException {
+        log.log(Level.FINEST, "NanodbcConnection.setStatementCacheSize");
+        throwIfAlreadyClosed();
+        try {
+            ConnectionHandler.setStatementCacheSize(connectionPtr, size);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Returns the number of idle prepared statements kept for reuse, 0 if the cache is disabled.
+     */
+    public int getStatementCacheSize() throws SQLException {
+        log.log(Level.FINEST, "NanodbcConnection.getStatementCacheSize");
+        throwIfAlreadyClosed();
+        try {
+            return ConnectionHandler.getStatementCacheSize(connectionPtr);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
     /**
      * Throws exception if Connection is already closed.
      *
@@ -662,12 +732,18 @@ public class NanodbcConnection implements Connection, JdbcWrapper {
     @AllArgsConstructor
     private static class ConnectionCleaner implements Runnable {
         private ConnectionPtr ptr;
+        // pooled connections go back to the pool instead of disconnecting
+        private final boolean pooled;
 
         @Override
         public void run() {
             if (ptr != null) {
                 try {
-                    ConnectionHandler.disconnect(ptr);
+                    if (pooled) {
+                        ConnectionHandler.giveBack(ptr);
+                    } else {
+                        ConnectionHandler.disconnect(ptr);
+                    }
                 } catch (Exception e) {
                     log.warning("Exception while closing connection: " + e.getMessage());
                 } finally {
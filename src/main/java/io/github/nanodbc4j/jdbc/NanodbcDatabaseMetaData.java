@@ -1370,11 +1370,10 @@ public class NanodbcDatabaseMetaData implements DatabaseMetaData, JdbcWrapper {
     @Override
     public boolean supportsResultSetType(int type) throws SQLException {
         log.log(Level.FINEST, "NanodbcDatabaseMetaData.supportsResultSetType");
-        return type == ResultSet.TYPE_FORWARD_ONLY;
-//        return switch (type) {    TODO
-//            case ResultSet.TYPE_FORWARD_ONLY, ResultSet.TYPE_SCROLL_INSENSITIVE -> true;
-//            default -> false;
-//        };
+        return switch (type) {
+            case ResultSet.TYPE_FORWARD_ONLY, ResultSet.TYPE_SCROLL_INSENSITIVE -> true;
+            default -> false;
+        };
     }
 
     /**
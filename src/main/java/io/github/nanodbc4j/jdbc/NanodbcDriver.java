@@ -2,7 +2,9 @@ package io.github.nanodbc4j.jdbc;
 
 import io.github.nanodbc4j.dto.DatasourceProperties;
 import io.github.nanodbc4j.dto.DriverProperties;
+import io.github.nanodbc4j.exceptions.NanodbcSQLException;
 import io.github.nanodbc4j.exceptions.NanodbcSQLFeatureNotSupportedException;
+import io.github.nanodbc4j.internal.cstruct.PoolSettings;
 import io.github.nanodbc4j.internal.handler.DriverHandler;
 import io.github.nanodbc4j.logging.EnhancedSimpleFormatter;
 import lombok.extern.java.Log;
@@ -27,6 +29,18 @@ import java.util.logging.Logger;
 @Log
 public class NanodbcDriver implements Driver {
     public static final String PREFIX = "jdbc:nanodbc4j:";
+    public static final String WIDE_CHAR_FETCH_PROPERTY = "wideCharFetch";
+    public static final String STATEMENT_CACHE_SIZE_PROPERTY = "statementCacheSize";
+    /** Borrow connections from a native pool per connection string; not used with user and password. */
+    public static final String POOL_PROPERTY = "pool";
+    public static final String POOL_MIN_SIZE_PROPERTY = "poolMinSize";
+    public static final String POOL_MAX_SIZE_PROPERTY = "poolMaxSize";
+    /** Milliseconds to wait for a pooled connection when all are borrowed. */
+    public static final String POOL_BORROW_TIMEOUT_PROPERTY = "poolBorrowTimeout";
+    /** Milliseconds after which an idle pooled connection is closed, 0 for never. */
+    public static final String POOL_IDLE_TIMEOUT_PROPERTY = "poolIdleTimeout";
+    /** Milliseconds after which a pooled connection is closed once idle, 0 for never. */
+    public static final String POOL_MAX_LIFETIME_PROPERTY = "poolMaxLifetime";
     static final int MAJOR_VERSION = 4;
     static final int MINOR_VERSION = 0;
 
@@ -56,12 +70,58 @@ public class NanodbcDriver implements Driver {
 
         String user = info.getProperty("user");
         String password = info.getProperty("password");
+        NanodbcConnection connection;
         if (user != null || password != null) {
             user = user == null ? "" : user;
             password = password == null ? "" : password;
-            return new NanodbcConnection(connectionString, user, password, loginTimeoutSeconds);
+            connection = new NanodbcConnection(connectionString, user, password, loginTimeoutSeconds);
+        } else if (Boolean.parseBoolean(info.getProperty(POOL_PROPERTY))) {
+            connection = new NanodbcConnection(connectionString, loginTimeoutSeconds, poolSettings(info));
         } else {
-            return new NanodbcConnection(connectionString, loginTimeoutSeconds);
+            connection = new NanodbcConnection(connectionString, loginTimeoutSeconds);
+        }
+
+        if (Boolean.parseBoolean(info.getProperty(WIDE_CHAR_FETCH_PROPERTY))) {
+            connection.setWideCharFetch(true);
+        }
+        String statementCacheSize = info.getProperty(STATEMENT_CACHE_SIZE_PROPERTY);
+        if (statementCacheSize != null) {
+            try {
+                connection.setStatementCacheSize(Integer.parseInt(statementCacheSize.trim()));
+            } catch (NumberFormatException e) {
+                connection.close();
+                throw new NanodbcSQLException("Invalid " + STATEMENT_CACHE_SIZE_PROPERTY + ": " + statementCacheSize, e);
+            }
+        }
+        return connection;
+    }
+
+    /**
+     * Reads the pool settings from the connection properties, keeping the defaults of those not set.
+     *
+     * @param info connection properties
+     * @return pool settings
+     * @throws SQLException if a setting is not a number
+     */
+    static PoolSettings poolSettings(Properties info) throws SQLException {
+        PoolSettings settings = new PoolSettings();
+        settings.min_size = (int) longProperty(info, POOL_MIN_SIZE_PROPERTY, settings.min_size);
+        settings.max_size = (int) longProperty(info, POOL_MAX_SIZE_PROPERTY, settings.max_size);
+        settings.borrow_timeout_ms = longProperty(info, POOL_BORROW_TIMEOUT_PROPERTY, settings.borrow_timeout_ms);
+        settings.idle_timeout_ms = longProperty(info, POOL_IDLE_TIMEOUT_PROPERTY, settings.idle_timeout_ms);
+        settings.max_lifetime_ms = longProperty(info, POOL_MAX_LIFETIME_PROPERTY, settings.max_lifetime_ms);
+        return settings;
+    }
+
+    private static long longProperty(Properties info, String name, long fallback) throws SQLException {
+        String value = info.getProperty(name);
+        if (value == null) {
+            return fallback;
+        }
+        try {
+            return Long.parseLong(value.trim());
+        } catch (NumberFormatException e) {
+            throw new NanodbcSQLException("Invalid " + name + ": " + value, e);
         }
     }
 
@@ -1,21 +1,27 @@
 package io.github.nanodbc4j.jdbc;
 
+import com.sun.jna.Memory;
 import io.github.nanodbc4j.exceptions.NanodbcSQLException;
 import io.github.nanodbc4j.exceptions.NanodbcSQLFeatureNotSupportedException;
 import io.github.nanodbc4j.exceptions.NativeException;
 import io.github.nanodbc4j.internal.binding.StatementApi;
 import io.github.nanodbc4j.internal.cstruct.BinaryArray;
+import io.github.nanodbc4j.internal.handler.ParameterStreams;
 import io.github.nanodbc4j.internal.handler.ResultSetHandler;
 import io.github.nanodbc4j.internal.handler.StatementHandler;
+import io.github.nanodbc4j.internal.pointer.ExecutionPtr;
 import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
 import io.github.nanodbc4j.internal.pointer.StatementPtr;
 import lombok.extern.java.Log;
 
 import java.io.InputStream;
+import java.io.InputStreamReader;
 import java.io.Reader;
 import java.math.BigDecimal;
 import java.net.URL;
+import java.nio.charset.StandardCharsets;
 import java.sql.Array;
+import java.sql.BatchUpdateException;
 import java.sql.Blob;
 import java.sql.Clob;
 import java.sql.Date;
@@ -31,7 +37,13 @@ import java.sql.SQLXML;
 import java.sql.Time;
 import java.sql.Timestamp;
 import java.sql.Types;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.BitSet;
 import java.util.Calendar;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
 
 import static io.github.nanodbc4j.internal.handler.Handler.NUL_CHAR;
 
@@ -41,6 +53,13 @@ import static io.github.nanodbc4j.internal.handler.Handler.NUL_CHAR;
 @Log
 public class NanodbcPreparedStatement extends NanodbcStatement implements PreparedStatement {
 
+    private int batchSize = 0;
+    // column values bound in place, kept alive until the batch is executed or cleared
+    private final List<Memory> columnBuffers = new ArrayList<>();
+    private int columnRows = 0;
+    // stream readers called back during the next execution, kept reachable until then
+    private final Map<Integer, ParameterStreams.Source> streams = new HashMap<>();
+
     public NanodbcPreparedStatement(NanodbcConnection connection, StatementPtr statementPtr) {
         super(connection, statementPtr);
     }
@@ -53,10 +72,12 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
         log.finest("NanodbcPreparedStatement.executeQuery");
         throwIfAlreadyClosed();
         try {
-            ResultSetPtr resultSetPtr = StatementHandler.execute(statementPtr, queryTimeoutSeconds);
+            ResultSetPtr resultSetPtr = StatementHandler.execute(statementPtr, queryTimeoutSeconds, fetchSize);
             return new NanodbcResultSet(this, resultSetPtr);
         } catch (NativeException e) {
-            throw new NanodbcSQLException(e);
+            throw executionFailure(e);
+        } finally {
+            streams.clear();
         }
     }
 
@@ -69,11 +90,13 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
         throwIfAlreadyClosed();
         try {
             assert connection.get() != null;
-            ResultSetPtr resultSetPtr = StatementHandler.execute(statementPtr, queryTimeoutSeconds);
+            ResultSetPtr resultSetPtr = StatementHandler.execute(statementPtr, queryTimeoutSeconds, fetchSize);
             resultSet = new NanodbcResultSet(this, resultSetPtr);
             return ResultSetHandler.getUpdateCount(resultSetPtr);
         } catch (NativeException e) {
-            throw new NanodbcSQLException(e);
+            throw executionFailure(e);
+        } finally {
+            streams.clear();
         }
     }
 
@@ -271,8 +294,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setAsciiStream(int parameterIndex, InputStream x, int length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setAsciiStream");
-        log.warning("throw SQLFeatureNotSupportedException");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, x == null ? null : new InputStreamReader(x, StandardCharsets.US_ASCII), length);
     }
 
     /**
@@ -291,8 +313,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setBinaryStream(int parameterIndex, InputStream x, int length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setBinaryStream");
-        log.warning("throw SQLFeatureNotSupportedException");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, x, length);
     }
 
     /**
@@ -365,11 +386,35 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
         log.finest("NanodbcPreparedStatement.execute");
         throwIfAlreadyClosed();
         try {
-            ResultSetPtr resultSetPtr = StatementHandler.execute(statementPtr, queryTimeoutSeconds);
+            ResultSetPtr resultSetPtr = StatementHandler.execute(statementPtr, queryTimeoutSeconds, fetchSize);
             resultSet = new NanodbcResultSet(this, resultSetPtr);
             return true;
         } catch (NativeException e) {
-            throw new NanodbcSQLException(e);
+            throw executionFailure(e);
+        } finally {
+            streams.clear();
+        }
+    }
+
+    /**
+     * Starts executing the statement with the current parameters without waiting for it to finish.
+     * The statement must not be used until the execution is closed.
+     *
+     * @return execution to poll or wait for
+     * @throws SQLException if the execution cannot be started
+     */
+    public NanodbcAsyncExecution executeAsync() throws SQLException {
+        log.finest("NanodbcPreparedStatement.executeAsync");
+        throwIfAlreadyClosed();
+        try {
+            closeResultSet();
+            ExecutionPtr executionPtr = StatementHandler.executeAsync(statementPtr, queryTimeoutSeconds);
+            // the streams are read on a worker thread, so the execution keeps them
+            return new NanodbcAsyncExecution(this, executionPtr, new ArrayList<>(streams.values()));
+        } catch (NativeException e) {
+            throw executionFailure(e);
+        } finally {
+            streams.clear();
         }
     }
 
@@ -379,8 +424,120 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void addBatch() throws SQLException {
         log.finest("NanodbcPreparedStatement.addBatch");
-        log.warning("throw SQLFeatureNotSupportedException");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        throwIfAlreadyClosed();
+        try {
+            StatementHandler.addBatch(statementPtr);
+            batchSize++;
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * {@inheritDoc}
+     */
+    @Override
+    public void clearBatch() throws SQLException {
+        log.finest("NanodbcPreparedStatement.clearBatch");
+        throwIfAlreadyClosed();
+        try {
+            StatementHandler.clearBatch(statementPtr);
+            batchSize = 0;
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        } finally {
+            releaseColumns();
+        }
+    }
+
+    /**
+     * {@inheritDoc}
+     * All rows are sent in one round trip as parameter arrays.
+     */
+    @Override
+    public int[] executeBatch() throws SQLException {
+        log.finest("NanodbcPreparedStatement.executeBatch");
+        throwIfAlreadyClosed();
+        int[] rowCounts = new int[columnRows > 0 ? columnRows : batchSize];
+        Arrays.fill(rowCounts, EXECUTE_FAILED);
+        batchSize = 0;
+        if (rowCounts.length == 0) {
+            return rowCounts;
+        }
+        try {
+            closeResultSet();
+            StatementHandler.executeBatch(statementPtr, queryTimeoutSeconds, rowCounts);
+            return rowCounts;
+        } catch (NativeException e) {
+            throw new BatchUpdateException(e.getMessage(), rowCounts, e);
+        } finally {
+            releaseColumns();
+        }
+    }
+
+    /**
+     * Sets a whole column of int values of the batch, executed by {@link #executeBatch()}
+     * instead of rows added with {@link #addBatch()}. Every parameter must be set this way
+     * and all columns must have the same length.
+     *
+     * @param parameterIndex the first parameter is 1, the second is 2, ...
+     * @param values values of all rows
+     * @param nulls rows that are NULL, may be null
+     * @throws SQLException if the column cannot be bound
+     */
+    public void setIntColumn(int parameterIndex, int[] values, BitSet nulls) throws SQLException {
+        log.finest("NanodbcPreparedStatement.setIntColumn");
+        Memory memory = allocateColumn(values.length, Integer.BYTES);
+        memory.write(0, values, 0, values.length);
+        bindColumn(parameterIndex, memory, nulls, values.length, StatementApi.INSTANCE::set_int_column);
+    }
+
+    /**
+     * Sets a whole column of long values of the batch, see {@link #setIntColumn}.
+     */
+    public void setLongColumn(int parameterIndex, long[] values, BitSet nulls) throws SQLException {
+        log.finest("NanodbcPreparedStatement.setLongColumn");
+        Memory memory = allocateColumn(values.length, Long.BYTES);
+        memory.write(0, values, 0, values.length);
+        bindColumn(parameterIndex, memory, nulls, values.length, StatementApi.INSTANCE::set_long_column);
+    }
+
+    /**
+     * Sets a whole column of double values of the batch, see {@link #setIntColumn}.
+     */
+    public void setDoubleColumn(int parameterIndex, double[] values, BitSet nulls) throws SQLException {
+        log.finest("NanodbcPreparedStatement.setDoubleColumn");
+        Memory memory = allocateColumn(values.length, Double.BYTES);
+        memory.write(0, values, 0, values.length);
+        bindColumn(parameterIndex, memory, nulls, values.length, StatementApi.INSTANCE::set_double_column);
+    }
+
+    /**
+     * Sets a whole column of string values of the batch, null elements are NULL.
+     * The strings are handed over in one call, see {@link #setIntColumn}.
+     */
+    public void setStringColumn(int parameterIndex, String[] values) throws SQLException {
+        log.finest("NanodbcPreparedStatement.setStringColumn");
+        throwIfAlreadyClosed();
+        int[] offsets = new int[values.length + 1];
+        BitSet nulls = new BitSet(values.length);
+        StringBuilder data = new StringBuilder();
+        for (int row = 0; row < values.length; row++) {
+            if (values[row] == null) {
+                nulls.set(row);
+            } else {
+                data.append(values[row]);
+            }
+            offsets[row + 1] = data.length();
+        }
+        char[] chars = new char[Math.max(data.length(), 1)];
+        data.getChars(0, data.length(), chars, 0);
+        try {
+            StatementHandler.setStringColumn(statementPtr, parameterIndex, chars, offsets, toBitmap(nulls, values.length), values.length);
+            columnRows = values.length;
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
     }
 
     /**
@@ -389,8 +546,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setCharacterStream(int parameterIndex, Reader reader, int length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setCharacterStream");
-        log.warning("throw SQLFeatureNotSupportedException");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, reader, length);
     }
 
     /**
@@ -409,8 +565,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setBlob(int parameterIndex, Blob x) throws SQLException {
         log.finest("NanodbcPreparedStatement.setBlob");
-        log.warning("throw SQLFeatureNotSupportedException");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, x == null ? null : x.getBinaryStream(), x == null ? -1 : x.length());
     }
 
     /**
@@ -419,8 +574,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setClob(int parameterIndex, Clob x) throws SQLException {
         log.finest("NanodbcPreparedStatement.setClob");
-        log.warning("throw SQLFeatureNotSupportedException");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, x == null ? null : x.getCharacterStream(), x == null ? -1 : x.length());
     }
 
     /**
@@ -532,8 +686,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setNCharacterStream(int parameterIndex, Reader value, long length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setNCharacterStream");
-        log.warning("throw SQLFeatureNotSupportedException");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, value, length);
     }
 
     /**
@@ -542,7 +695,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setNClob(int parameterIndex, NClob value) throws SQLException {
         log.finest("NanodbcPreparedStatement.setNClob");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, value == null ? null : value.getCharacterStream(), value == null ? -1 : value.length());
     }
 
     /**
@@ -551,7 +704,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setClob(int parameterIndex, Reader reader, long length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setClob");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, reader, length);
     }
 
     /**
@@ -560,7 +713,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setBlob(int parameterIndex, InputStream inputStream, long length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setBlob");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, inputStream, length);
     }
 
     /**
@@ -569,7 +722,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setNClob(int parameterIndex, Reader reader, long length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setNClob");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, reader, length);
     }
 
     /**
@@ -596,7 +749,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setAsciiStream(int parameterIndex, InputStream x, long length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setAsciiStream");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, x == null ? null : new InputStreamReader(x, StandardCharsets.US_ASCII), length);
     }
 
     /**
@@ -605,7 +758,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setBinaryStream(int parameterIndex, InputStream x, long length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setBinaryStream");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, x, length);
     }
 
     /**
@@ -614,7 +767,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setCharacterStream(int parameterIndex, Reader reader, long length) throws SQLException {
         log.finest("NanodbcPreparedStatement.setCharacterStream");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, reader, length);
     }
 
     /**
@@ -623,7 +776,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setAsciiStream(int parameterIndex, InputStream x) throws SQLException {
         log.finest("NanodbcPreparedStatement.setAsciiStream");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, x == null ? null : new InputStreamReader(x, StandardCharsets.US_ASCII), -1);
     }
 
     /**
@@ -632,7 +785,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setBinaryStream(int parameterIndex, InputStream x) throws SQLException {
         log.finest("NanodbcPreparedStatement.setBinaryStream");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, x, -1);
     }
 
     /**
@@ -641,7 +794,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setCharacterStream(int parameterIndex, Reader reader) throws SQLException {
         log.finest("NanodbcPreparedStatement.setCharacterStream");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, reader, -1);
     }
 
     /**
@@ -650,7 +803,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setNCharacterStream(int parameterIndex, Reader value) throws SQLException {
         log.finest("NanodbcPreparedStatement.setNCharacterStream");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, value, -1);
     }
 
     /**
@@ -659,7 +812,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setClob(int parameterIndex, Reader reader) throws SQLException {
         log.finest("NanodbcPreparedStatement.setClob");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, reader, -1);
     }
 
     /**
@@ -668,7 +821,7 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setBlob(int parameterIndex, InputStream inputStream) throws SQLException {
         log.finest("NanodbcPreparedStatement.setBlob");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, inputStream, -1);
     }
 
     /**
@@ -677,6 +830,77 @@ public class NanodbcPreparedStatement extends NanodbcStatement implements Prepar
     @Override
     public void setNClob(int parameterIndex, Reader reader) throws SQLException {
         log.finest("NanodbcPreparedStatement.setNClob");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        setStream(parameterIndex, reader, -1);
+    }
+
+    private void setStream(int parameterIndex, InputStream x, long length) throws SQLException {
+        throwIfAlreadyClosed();
+        try {
+            ParameterStreams.Bytes reader = x == null ? null : new ParameterStreams.Bytes(x, length);
+            StatementHandler.setBinaryStream(statementPtr, parameterIndex, reader, length);
+            keepStream(parameterIndex, reader);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    private void setStream(int parameterIndex, Reader x, long length) throws SQLException {
+        throwIfAlreadyClosed();
+        try {
+            ParameterStreams.Chars reader = x == null ? null : new ParameterStreams.Chars(x, length);
+            StatementHandler.setCharacterStream(statementPtr, parameterIndex, reader, length);
+            keepStream(parameterIndex, reader);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    private void keepStream(int parameterIndex, ParameterStreams.Source reader) {
+        if (reader == null) {
+            streams.remove(parameterIndex);
+        } else {
+            streams.put(parameterIndex, reader);
+        }
+    }
+
+    private SQLException executionFailure(NativeException e) {
+        SQLException exception = new NanodbcSQLException(e);
+        // the native error only tells that a stream failed, the reader knows why
+        for (ParameterStreams.Source stream : streams.values()) {
+            Exception failure = stream.failure();
+            if (failure != null) {
+                exception.addSuppressed(failure);
+            }
+        }
+        return exception;
+    }
+
+    private Memory allocateColumn(int rows, int valueSize) throws SQLException {
+        throwIfAlreadyClosed();
+        if (rows == 0) {
+            throw new NanodbcSQLException("Parameter column has no rows");
+        }
+        return new Memory((long) rows * valueSize);
+    }
+
+    private void bindColumn(int parameterIndex, Memory memory, BitSet nulls, int rows,
+                            StatementHandler.ColumnSetter function) throws SQLException {
+        try {
+            StatementHandler.setColumn(statementPtr, parameterIndex, memory, toBitmap(nulls, rows), rows, function);
+            columnBuffers.add(memory);
+            columnRows = rows;
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    private void releaseColumns() {
+        columnBuffers.clear();
+        columnRows = 0;
+    }
+
+    private static byte[] toBitmap(BitSet nulls, int rows) {
+        // BitSet keeps bit (row % 8) of byte (row / 8), the layout of the native bitmap
+        return nulls == null || nulls.isEmpty() ? null : Arrays.copyOf(nulls.toByteArray(), (rows + 7) / 8);
     }
 }
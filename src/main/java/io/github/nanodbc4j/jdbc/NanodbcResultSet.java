@@ -1,16 +1,20 @@
 package io.github.nanodbc4j.jdbc;
 
+import com.sun.jna.ptr.ByteByReference;
 import io.github.nanodbc4j.exceptions.NanodbcSQLException;
 import io.github.nanodbc4j.exceptions.NanodbcSQLFeatureNotSupportedException;
 import io.github.nanodbc4j.exceptions.NativeException;
 import io.github.nanodbc4j.internal.binding.ResultApi;
+import io.github.nanodbc4j.internal.cstruct.DecimalStruct;
+import io.github.nanodbc4j.internal.cstruct.NativeError;
+import io.github.nanodbc4j.internal.handler.Handler;
 import io.github.nanodbc4j.internal.handler.ResultSetHandler;
+import io.github.nanodbc4j.internal.handler.Utf16Buffer;
 import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
 import lombok.AllArgsConstructor;
 import lombok.extern.java.Log;
 
 import java.io.InputStream;
-import java.io.InputStreamReader;
 import java.io.InvalidClassException;
 import java.io.Reader;
 import java.lang.ref.Cleaner;
@@ -49,6 +53,14 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
     private ResultSetMetaData metaData = null;
     private volatile boolean closed = false;
     private Object lastColumn = null;
+    private boolean lastNull = false;
+    private boolean lastNullKnown = false;
+    private final ByteByReference nullIndicator = new ByteByReference();
+    private int fetchSize = 0;
+    private int type = ResultSet.TYPE_FORWARD_ONLY;
+    private boolean valueArena = false;
+    private final Utf16Buffer stringBuffer = new Utf16Buffer();
+    private final DecimalStruct decimalStruct = new DecimalStruct();
 
     // Cleaner for managing resource cleanup
     private static final Cleaner cleaner = Cleaner.create();
@@ -64,6 +76,12 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         cleanable = cleaner.register(this, new ResultSetCleaner(resultSetPtr));
         this.resultSetPtr = resultSetPtr;
         this.statement = new WeakReference<>(statement);
+        this.fetchSize = statement.fetchSize;
+        if (statement.resultSetType == ResultSet.TYPE_SCROLL_INSENSITIVE) {
+            // the driver cursor stays forward-only, scrolling is served from the cached rows
+            ResultSetHandler.enableRowCache(resultSetPtr, NanodbcStatement.ROW_CACHE_MEMORY_BUDGET);
+            this.type = ResultSet.TYPE_SCROLL_INSENSITIVE;
+        }
     }
 
     /**
@@ -92,7 +110,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
                     cleanable.clean();
                     resultSetPtr = null;
                     metaData = null;
-                    lastColumn = null;
+                    setLastColumn(null);
                     closed = true;
                 }
             } catch (NativeException e) {
@@ -109,6 +127,9 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.wasNull");
         throwIfAlreadyClosed();
         try {
+            if (lastNullKnown) {
+                return lastNull;
+            }
             return ResultSetHandler.wasNull(resultSetPtr, lastColumn);
         } catch (NativeException | InvalidClassException e) {
             throw new NanodbcSQLException(e);
@@ -123,8 +144,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getString");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getStringValueByIndex(resultSetPtr, columnIndex);
+            setLastColumn(columnIndex);
+            return setLastNull(ResultSetHandler.getStringValueByIndex(resultSetPtr, columnIndex, stringBuffer));
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -138,8 +159,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getBoolean");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getValueByIndex(resultSetPtr, columnIndex, ResultApi.INSTANCE::get_bool_value_by_index) != 0;
+            return getNullableValue(columnIndex, ResultApi.INSTANCE::get_bool_value_nullable_by_index) != 0;
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -162,8 +182,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getShort");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getValueByIndex(resultSetPtr, columnIndex, ResultApi.INSTANCE::get_short_value_by_index);
+            return getNullableValue(columnIndex, ResultApi.INSTANCE::get_short_value_nullable_by_index);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -177,8 +196,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getInt");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getValueByIndex(resultSetPtr, columnIndex, ResultApi.INSTANCE::get_int_value_by_index);
+            return getNullableValue(columnIndex, ResultApi.INSTANCE::get_int_value_nullable_by_index);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -192,8 +210,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getLong");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getValueByIndex(resultSetPtr, columnIndex, ResultApi.INSTANCE::get_long_value_by_index);
+            return getNullableValue(columnIndex, ResultApi.INSTANCE::get_long_value_nullable_by_index);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -207,8 +224,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getFloat");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getValueByIndex(resultSetPtr, columnIndex, ResultApi.INSTANCE::get_float_value_by_index);
+            return getNullableValue(columnIndex, ResultApi.INSTANCE::get_float_value_nullable_by_index);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -222,8 +238,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getDouble");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getValueByIndex(resultSetPtr, columnIndex, ResultApi.INSTANCE::get_double_value_by_index);
+            return getNullableValue(columnIndex, ResultApi.INSTANCE::get_double_value_nullable_by_index);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -247,8 +262,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getBytes");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getBytesByIndex(resultSetPtr, columnIndex);
+            setLastColumn(columnIndex);
+            return ResultSetHandler.getBytesByIndex(resultSetPtr, columnIndex, valueArena);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -262,8 +277,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getDate");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getDateValueByIndex(resultSetPtr, columnIndex);
+            setLastColumn(columnIndex);
+            return ResultSetHandler.getDateValueByIndex(resultSetPtr, columnIndex, valueArena);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -277,8 +292,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getTime");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getTimeValueByIndex(resultSetPtr, columnIndex);
+            setLastColumn(columnIndex);
+            return ResultSetHandler.getTimeValueByIndex(resultSetPtr, columnIndex, valueArena);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -292,8 +307,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getTimestamp");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return ResultSetHandler.getTimestampValueByIndex(resultSetPtr, columnIndex);
+            setLastColumn(columnIndex);
+            return ResultSetHandler.getTimestampValueByIndex(resultSetPtr, columnIndex, valueArena);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -325,7 +340,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getBinaryStream");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
+            setLastColumn(columnIndex);
             return new NanodbcBinaryStream(resultSetPtr, columnIndex);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -340,8 +355,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getString");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
-            return ResultSetHandler.getStringValueByName(resultSetPtr, columnLabel);
+            setLastColumn(columnLabel);
+            return ResultSetHandler.getStringValueByName(resultSetPtr, columnLabel, valueArena);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -355,7 +370,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getBoolean");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
+            setLastColumn(columnLabel);
             return ResultSetHandler.getValueByName(resultSetPtr, columnLabel, ResultApi.INSTANCE::get_bool_value_by_name) != 0;
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -380,7 +395,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getShort");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
+            setLastColumn(columnLabel);
             return ResultSetHandler.getValueByName(resultSetPtr, columnLabel, ResultApi.INSTANCE::get_short_value_by_name);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -395,7 +410,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getInt");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
+            setLastColumn(columnLabel);
             return ResultSetHandler.getValueByName(resultSetPtr, columnLabel, ResultApi.INSTANCE::get_int_value_by_name);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -410,7 +425,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getLong");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
+            setLastColumn(columnLabel);
             return ResultSetHandler.getValueByName(resultSetPtr, columnLabel, ResultApi.INSTANCE::get_long_value_by_name);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -425,7 +440,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getFloat");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
+            setLastColumn(columnLabel);
             return ResultSetHandler.getValueByName(resultSetPtr, columnLabel, ResultApi.INSTANCE::get_float_value_by_name);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -440,7 +455,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getDouble");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
+            setLastColumn(columnLabel);
             return ResultSetHandler.getValueByName(resultSetPtr, columnLabel, ResultApi.INSTANCE::get_double_value_by_name);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -465,8 +480,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getBytes");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
-            return ResultSetHandler.getBytesByName(resultSetPtr, columnLabel);
+            setLastColumn(columnLabel);
+            return ResultSetHandler.getBytesByName(resultSetPtr, columnLabel, valueArena);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -480,8 +495,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getDate");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
-            return ResultSetHandler.getDateValueByName(resultSetPtr, columnLabel);
+            setLastColumn(columnLabel);
+            return ResultSetHandler.getDateValueByName(resultSetPtr, columnLabel, valueArena);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -495,8 +510,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getTime");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
-            return ResultSetHandler.getTimeValueByName(resultSetPtr, columnLabel);
+            setLastColumn(columnLabel);
+            return ResultSetHandler.getTimeValueByName(resultSetPtr, columnLabel, valueArena);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -510,8 +525,8 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getTimestamp");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
-            return ResultSetHandler.getTimestampValueByName(resultSetPtr, columnLabel);
+            setLastColumn(columnLabel);
+            return ResultSetHandler.getTimestampValueByName(resultSetPtr, columnLabel, valueArena);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -543,7 +558,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getBinaryStream");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
+            setLastColumn(columnLabel);
             return new NanodbcBinaryStream(resultSetPtr, columnLabel);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -601,7 +616,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
     public Object getObject(int columnIndex) throws SQLException {
         log.finest("NanodbcResultSet.getObject");
         throwIfAlreadyClosed();
-        lastColumn = columnIndex;
+        setLastColumn(columnIndex);
         String className = getMetaData().getColumnClassName(columnIndex);
 
         try {
@@ -635,7 +650,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getObject");
         throwIfAlreadyClosed();
         int index = findColumn(columnLabel);
-        lastColumn = columnLabel;
+        setLastColumn(columnLabel);
         if (index == -1) {
             throw new SQLException("Column " + columnLabel + " not found");
         }
@@ -695,8 +710,9 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getCharacterStream");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnIndex;
-            return new InputStreamReader(new NanodbcBinaryStream(resultSetPtr, columnIndex), StandardCharsets.UTF_8);
+            setLastColumn(columnIndex);
+            NanodbcCharacterStream reader = new NanodbcCharacterStream(resultSetPtr, columnIndex);
+            return setLastNull(reader.isNull() ? null : reader);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -710,8 +726,9 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
         log.finest("NanodbcResultSet.getCharacterStream");
         throwIfAlreadyClosed();
         try {
-            lastColumn = columnLabel;
-            return new InputStreamReader(new NanodbcBinaryStream(resultSetPtr, columnLabel), StandardCharsets.UTF_8);
+            setLastColumn(columnLabel);
+            NanodbcCharacterStream reader = new NanodbcCharacterStream(resultSetPtr, columnLabel);
+            return setLastNull(reader.isNull() ? null : reader);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
         }
@@ -724,8 +741,12 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
     public BigDecimal getBigDecimal(int columnIndex) throws SQLException {
         log.finest("NanodbcResultSet.getBigDecimal");
         throwIfAlreadyClosed();
-        String s = getString(columnIndex);
-        return s == null || s.isEmpty() ? null : new BigDecimal(s);
+        try {
+            setLastColumn(columnIndex);
+            return setLastNull(ResultSetHandler.getDecimalValueByIndex(resultSetPtr, columnIndex, decimalStruct));
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
     }
 
     /**
@@ -734,9 +755,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
     @Override
     public BigDecimal getBigDecimal(String columnLabel) throws SQLException {
         log.finest("NanodbcResultSet.getBigDecimal");
-        throwIfAlreadyClosed();
-        String s = getString(columnLabel);
-        return s == null || s.isEmpty() ? null : new BigDecimal(s);
+        return getBigDecimal(findColumn(columnLabel));
     }
 
     /**
@@ -861,7 +880,15 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
     @Override
     public boolean relative(int rows) throws SQLException {
         log.finest("NanodbcResultSet.relative");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        throwIfAlreadyClosed();
+        if (type == ResultSet.TYPE_FORWARD_ONLY) {
+            throw new NanodbcSQLFeatureNotSupportedException();
+        }
+        try {
+            return ResultSetHandler.relative(resultSetPtr, rows);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
     }
 
     /**
@@ -904,7 +931,13 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
     @Override
     public void setFetchSize(int rows) throws SQLException {
         log.finest("NanodbcResultSet.setFetchSize");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        throwIfAlreadyClosed();
+        if (rows < 0) {
+            throw new NanodbcSQLException("Fetch size must be >= 0: " + rows);
+        }
+        // The native rowset buffers are bound when the query is executed,
+        // so the value is kept as a hint and reported back by getFetchSize()
+        this.fetchSize = rows;
     }
 
     /**
@@ -913,7 +946,54 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
     @Override
     public int getFetchSize() throws SQLException {
         log.finest("NanodbcResultSet.getFetchSize");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        throwIfAlreadyClosed();
+        return fetchSize;
+    }
+
+    /**
+     * Starts reading the next batchRows rows on a background thread while the current
+     * ones are consumed. Afterwards the result set is forward-only and fetch errors are
+     * reported by {@link #next()}.
+     */
+    public void enablePrefetch(int batchRows) throws SQLException {
+        log.finest("NanodbcResultSet.enablePrefetch");
+        throwIfAlreadyClosed();
+        try {
+            ResultSetHandler.enablePrefetch(resultSetPtr, batchRows);
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Lets the native side allocate the strings, dates and byte arrays of the current row
+     * from one arena released when the cursor moves, instead of freeing each value.
+     */
+    public void enableValueArena() throws SQLException {
+        log.finest("NanodbcResultSet.enableValueArena");
+        throwIfAlreadyClosed();
+        try {
+            ResultSetHandler.enableValueArena(resultSetPtr);
+            valueArena = true;
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
+    /**
+     * Keeps the rows read from here on in a client-side cache, so that {@link #previous()},
+     * {@link #first()}, {@link #last()} and {@link #absolute(int)} work on forward-only
+     * cursors. Rows beyond memoryBudget bytes are kept in a temporary file.
+     */
+    public void enableRowCache(long memoryBudget) throws SQLException {
+        log.finest("NanodbcResultSet.enableRowCache");
+        throwIfAlreadyClosed();
+        try {
+            ResultSetHandler.enableRowCache(resultSetPtr, memoryBudget);
+            type = ResultSet.TYPE_SCROLL_INSENSITIVE;
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
     }
 
     /**
@@ -922,8 +1002,7 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
     @Override
     public int getType() throws SQLException {
         log.finest("NanodbcResultSet.getType");
-        return ResultSet.TYPE_FORWARD_ONLY;
-        //throw new NanodbcSQLFeatureNotSupportedException(); todo
+        return type;
     }
 
     /**
@@ -2095,10 +2174,10 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
      */
     public UUID getUuid(int columnIndex) throws SQLException {
         throwIfAlreadyClosed();
-        lastColumn = columnIndex;
+        setLastColumn(columnIndex);
 
         try {
-            byte[] bytes = ResultSetHandler.getBytesByIndex(resultSetPtr, columnIndex);
+            byte[] bytes = ResultSetHandler.getBytesByIndex(resultSetPtr, columnIndex, valueArena);
             if (bytes == null || bytes.length == 0) {
                 return null;
             }
@@ -2142,6 +2221,28 @@ public class NanodbcResultSet implements ResultSet, JdbcWrapper {
      *
      * @throws SQLException if ResultSet is already closed.
      */
+    private void setLastColumn(Object column) {
+        lastColumn = column;
+        lastNullKnown = false;
+    }
+
+    private <T> T setLastNull(T value) {
+        lastNull = value == null;
+        lastNullKnown = true;
+        return value;
+    }
+
+    /**
+     * Reads a primitive column together with its null indicator, so that wasNull() needs no native call.
+     */
+    private <T> T getNullableValue(int columnIndex, Handler.QuadFunction<ResultSetPtr, Integer, ByteByReference, NativeError, T> function) {
+        setLastColumn(columnIndex);
+        T value = ResultSetHandler.getValueByIndex(resultSetPtr, columnIndex, nullIndicator, function);
+        lastNull = nullIndicator.getValue() != 0;
+        lastNullKnown = true;
+        return value;
+    }
+
     protected void throwIfAlreadyClosed() throws SQLException {
         if (isClosed() || resultSetPtr == null) {
             throw new NanodbcSQLException("ResultSet: already closed");
@@ -5,6 +5,7 @@ import io.github.nanodbc4j.exceptions.NanodbcSQLFeatureNotSupportedException;
 import io.github.nanodbc4j.exceptions.NativeException;
 import io.github.nanodbc4j.internal.handler.ResultSetHandler;
 import io.github.nanodbc4j.internal.handler.StatementHandler;
+import io.github.nanodbc4j.internal.pointer.ExecutionPtr;
 import io.github.nanodbc4j.internal.pointer.ResultSetPtr;
 import io.github.nanodbc4j.internal.pointer.StatementPtr;
 import lombok.AllArgsConstructor;
@@ -17,9 +18,11 @@ import java.sql.ResultSet;
 import java.sql.SQLException;
 import java.sql.SQLWarning;
 import java.sql.Statement;
+import java.util.ArrayList;
 
 /**
- * Executes SQL statements. Forward-only, read-only result sets.
+ * Executes SQL statements. Read-only result sets, forward-only unless the statement was
+ * created as TYPE_SCROLL_INSENSITIVE, in which case their rows are cached on the client.
  */
 @Log
 public class NanodbcStatement implements Statement, JdbcWrapper {
@@ -28,6 +31,11 @@ public class NanodbcStatement implements Statement, JdbcWrapper {
     protected NanodbcResultSet resultSet = null;
     protected volatile boolean closed = false;
     protected int queryTimeoutSeconds = 0;
+    protected int fetchSize = 0;
+    protected int resultSetType = ResultSet.TYPE_FORWARD_ONLY;
+
+    /** Bytes of rows a scroll-insensitive result set keeps in memory before using a temporary file. */
+    static final long ROW_CACHE_MEMORY_BUDGET = 16L * 1024 * 1024;
 
     // Cleaner for managing resource cleanup
     private static final Cleaner cleaner = Cleaner.create();
@@ -48,7 +56,7 @@ public class NanodbcStatement implements Statement, JdbcWrapper {
         throwIfAlreadyClosed();
         try {
             assert connection.get() != null;
-            ResultSetPtr resultSetPtr = StatementHandler.execute(connection.get().getConnectionPtr(), sql, queryTimeoutSeconds);
+            ResultSetPtr resultSetPtr = StatementHandler.execute(connection.get().getConnectionPtr(), sql, queryTimeoutSeconds, fetchSize);
             return new NanodbcResultSet(this, resultSetPtr);
         } catch (NativeException e) {
             throw new NanodbcSQLException(e);
@@ -64,7 +72,7 @@ public class NanodbcStatement implements Statement, JdbcWrapper {
         throwIfAlreadyClosed();
         try {
             assert connection.get() != null;
-            ResultSetPtr resultSetPtr = StatementHandler.execute(connection.get().getConnectionPtr(), sql, queryTimeoutSeconds);
+            ResultSetPtr resultSetPtr = StatementHandler.execute(connection.get().getConnectionPtr(), sql, queryTimeoutSeconds, fetchSize);
             resultSet = new NanodbcResultSet(this, resultSetPtr);
             return ResultSetHandler.getUpdateCount(resultSetPtr);
         } catch (NativeException e) {
@@ -72,6 +80,26 @@ public class NanodbcStatement implements Statement, JdbcWrapper {
         }
     }
 
+    /**
+     * Starts executing the SQL on a statement of its own without waiting for it to finish.
+     * Drivers supporting asynchronous execution are polled, others run it on a native worker thread.
+     *
+     * @param sql SQL statement
+     * @return execution to poll or wait for
+     * @throws SQLException if the execution cannot be started
+     */
+    public NanodbcAsyncExecution executeAsync(String sql) throws SQLException {
+        log.finest("NanodbcStatement.executeAsync");
+        throwIfAlreadyClosed();
+        try {
+            assert connection.get() != null;
+            ExecutionPtr executionPtr = StatementHandler.executeAsync(connection.get().getConnectionPtr(), sql, queryTimeoutSeconds);
+            return new NanodbcAsyncExecution(this, executionPtr, new ArrayList<>());
+        } catch (NativeException e) {
+            throw new NanodbcSQLException(e);
+        }
+    }
+
     /**
      * {@inheritDoc}
      */
@@ -205,7 +233,7 @@ public class NanodbcStatement implements Statement, JdbcWrapper {
         throwIfAlreadyClosed();
         try {
             assert connection.get() != null;
-            ResultSetPtr resultSetPtr = StatementHandler.execute(connection.get().getConnectionPtr(), sql, queryTimeoutSeconds);
+            ResultSetPtr resultSetPtr = StatementHandler.execute(connection.get().getConnectionPtr(), sql, queryTimeoutSeconds, fetchSize);
             resultSet = new NanodbcResultSet(this, resultSetPtr);
             return true;
         } catch (NativeException e) {
@@ -274,7 +302,10 @@ public class NanodbcStatement implements Statement, JdbcWrapper {
     public void setFetchSize(int rows) throws SQLException {
         log.finest("NanodbcStatement.setFetchSize");
         throwIfAlreadyClosed();
-        //throw new NanodbcSQLFeatureNotSupportedException(); todo
+        if (rows < 0) {
+            throw new NanodbcSQLException("Fetch size must be >= 0: " + rows);
+        }
+        this.fetchSize = rows;
     }
 
     /**
@@ -283,8 +314,8 @@ public class NanodbcStatement implements Statement, JdbcWrapper {
     @Override
     public int getFetchSize() throws SQLException {
         log.finest("NanodbcStatement.getFetchSize");
-        return 0;
-        //throw new NanodbcSQLFeatureNotSupportedException();
+        throwIfAlreadyClosed();
+        return fetchSize;
     }
 
     /**
@@ -303,8 +334,8 @@ public class NanodbcStatement implements Statement, JdbcWrapper {
     @Override
     public int getResultSetType() throws SQLException {
         log.finest("NanodbcStatement.getResultSetType");
-        log.warning("throw SQLFeatureNotSupportedException");
-        throw new NanodbcSQLFeatureNotSupportedException();
+        throwIfAlreadyClosed();
+        return resultSetType;
     }
 
     /**